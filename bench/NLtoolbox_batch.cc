@@ -0,0 +1,149 @@
+/*\
+ |
+ |  Batch run of the catalogue: every solver from every initial point
+ |  of every problem, on a work stealing pool.
+ |
+ |  NLtoolbox_batch [options] [output file, default batch.txt]
+ |
+ |    -j N        threads
+ |    -t MS       wall time budget of each run
+ |    -e N        budget of residual evaluations of each run
+ |    -n N        skip the problems with more than N equations
+ |    -f TEXT     run only the problems with TEXT in the title
+ |    -s A,B,...  solvers among Newton, Broyden, Schubert, LM, Tensor
+ |    -v          print the results as they come
+ |    -T FILE     trace of the run (library built with NL_TRACE), Chrome
+ |                JSON if FILE ends with .json, else compressed binary
+ |                (see NLtoolbox_trace)
+ |    -R FILE     record the final point of each run (see NLtoolbox_records)
+ |
+ |  Running again with the same output file resumes an interrupted run.
+ |
+\*/
+
+#include "NLbatchRunner.hh"
+#include "NLsolverBroyden.hh"
+#include "NLsolverSchubert.hh"
+#include "NLsolverLevenbergMarquardt.hh"
+#include "NLsolverTensor.hh"
+#include "NLtrace.hh"
+#include "Utils_zstream.hh"
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace NLproblem;
+
+static
+bool
+addSolver( BatchRunner & B, string const & name ) {
+  if      ( name == "Newton"   ) B.addSolver( name, []() -> NLsolver * { return new NewtonSolver(); } );
+  else if ( name == "Broyden"  ) B.addSolver( name, []() -> NLsolver * { return new BroydenSolver(); } );
+  else if ( name == "Schubert" ) B.addSolver( name, []() -> NLsolver * { return new SchubertSolver(); } );
+  else if ( name == "LM"       ) B.addSolver( name, []() -> NLsolver * { return new LevenbergMarquardtSolver(); } );
+  else if ( name == "Tensor"   ) B.addSolver( name, []() -> NLsolver * { return new TensorNewtonSolver(); } );
+  else return false;
+  return true;
+}
+
+int
+main( int argc, char const * argv[] ) {
+  unsigned    nthreads = max( unsigned(1), unsigned(std::thread::hardware_concurrency()) );
+  real_type   ms       = 10000;
+  integer     max_F    = 100000;
+  integer     max_n    = numeric_limits<integer>::max();
+  string      filter, fname = "batch.txt", trace_name, records_name;
+  string      solvers  = "Newton,Broyden,LM,Tensor";
+  bool        verbose  = false;
+
+  for ( int i = 1; i < argc; ++i ) {
+    bool has_arg = i+1 < argc;
+    if      ( std::strcmp( argv[i], "-j" ) == 0 && has_arg ) nthreads = unsigned(std::atoi( argv[++i] ));
+    else if ( std::strcmp( argv[i], "-t" ) == 0 && has_arg ) ms       = std::atof( argv[++i] );
+    else if ( std::strcmp( argv[i], "-e" ) == 0 && has_arg ) max_F    = std::atoi( argv[++i] );
+    else if ( std::strcmp( argv[i], "-n" ) == 0 && has_arg ) max_n    = std::atoi( argv[++i] );
+    else if ( std::strcmp( argv[i], "-f" ) == 0 && has_arg ) filter   = argv[++i];
+    else if ( std::strcmp( argv[i], "-s" ) == 0 && has_arg ) solvers  = argv[++i];
+    else if ( std::strcmp( argv[i], "-v" ) == 0 )            verbose  = true;
+    else if ( std::strcmp( argv[i], "-T" ) == 0 && has_arg ) trace_name = argv[++i];
+    else if ( std::strcmp( argv[i], "-R" ) == 0 && has_arg ) records_name = argv[++i];
+    else if ( argv[i][0] != '-' )                            fname    = argv[i];
+    else {
+      fmt::print( "NLtoolbox_batch, bad option `{}`\n", argv[i] );
+      return 1;
+    }
+  }
+
+  initProblems();
+
+  BatchRunner B( nthreads );
+  size_t pos = 0;
+  while ( pos <= solvers.size() ) {
+    size_t comma = solvers.find( ',', pos );
+    if ( comma == string::npos ) comma = solvers.size();
+    string name = solvers.substr( pos, comma-pos );
+    if ( !addSolver( B, name ) ) {
+      fmt::print( "NLtoolbox_batch, unknown solver `{}`\n", name );
+      return 1;
+    }
+    pos = comma+1;
+  }
+  B.setTimeBudget( ms );
+  B.setMaxEvaluations( max_F );
+  B.setMaxSize( max_n );
+  B.setFilter( filter );
+  B.setVerbose( verbose );
+
+  if ( !trace_name.empty() ) {
+    if ( !eventTracer::compiledIn() )
+      fmt::print( "NLtoolbox_batch, library built without NL_TRACE, the trace is empty\n" );
+    eventTracer::enable( size_t(1) << 20 ); // 24 MB of events for each thread
+    eventTracer::setThreadName( "main" );
+  }
+
+  std::unique_ptr<asyncRecordWriter> records;
+  try {
+    if ( !records_name.empty() ) {
+      records.reset( new asyncRecordWriter( records_name, B.numThreads() ) );
+      B.setRecordWriter( records.get() );
+    }
+    B.run( fname );
+    if ( records ) {
+      records->close();
+      fmt::print(
+        "{} records written to `{}`, {} bytes ({} uncompressed)\n",
+        records->numRecords(), records_name, records->fileBytes(), records->rawBytes()
+      );
+    }
+  } catch ( std::exception const & e ) {
+    fmt::print( "NLtoolbox_batch, {}\n", e.what() );
+    return 1;
+  }
+
+  if ( !trace_name.empty() ) {
+    eventTracer::disable();
+    traceData T;
+    eventTracer::snapshot( T );
+    bool json = trace_name.size() >= 5 && trace_name.compare( trace_name.size()-5, 5, ".json" ) == 0;
+    std::ofstream file( trace_name.c_str(), json ? std::ios::out : std::ios::out | std::ios::binary );
+    if ( !file.good() ) {
+      fmt::print( "NLtoolbox_batch, cannot open `{}`\n", trace_name );
+      return 1;
+    }
+    if ( json ) {
+      T.writeChromeJSON( file );
+    } else {
+      zstream::ozstream zfile( file );
+      T.writeBinary( zfile );
+    }
+    fmt::print( "{} events of {} threads written to `{}`\n", T.numEvents(), T.threads.size(), trace_name );
+  }
+
+  fmt::print(
+    "threads = {}, jobs = {} (skipped {} already in `{}`), done = {}, "
+    "converged = {}, steal = {}, {:.4} ms\n",
+    B.numThreads(), B.numJobs(), B.numSkipped(), fname, B.numDone(),
+    B.numConverged(), B.numSteal(), B.elapsedMs()
+  );
+  return 0;
+}
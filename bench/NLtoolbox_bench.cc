@@ -0,0 +1,322 @@
+/*\
+ |
+ |  Timing of the evaluation routines of the catalogue.
+ |
+ |  For each problem and initial point the kernels
+ |
+ |    evalF, evalFk (sweep over k = 0..n-1), jacobian, jacobianPattern,
+ |    fill_CSR
+ |
+ |  are called after a warmup in samples of calls long enough for the
+ |  clock; the minimum, median and 10/90 percentiles of the time per
+ |  call, the allocations per call (see bench_memory.hh) and the bytes
+ |  of the arguments read and written per call are written as JSON,
+ |  one record per line.
+ |  With a baseline (a previous output) a kernel is a regression when
+ |  both its median and its minimum are above (1+threshold) times the
+ |  ones of the baseline (the minimum filters the noise of the short
+ |  kernels), the exit code is then 2.
+ |
+ |  NLtoolbox_bench [options]
+ |
+ |    -o FILE     output JSON (default bench.json)
+ |    -b FILE     baseline JSON to compare with
+ |    -t X        regression threshold (default 0.1 = +10%)
+ |    -r N        samples of each kernel (default 21)
+ |    -w N        warmup calls (default 3)
+ |    -n N        skip the problems with more than N equations
+ |    -f TEXT     only the problems with TEXT in the title
+ |
+\*/
+
+#include "testsNonlin.hh"
+
+#include "bench_memory.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
+
+using namespace NLproblem;
+
+/*\
+ |  measure
+\*/
+
+struct measure {
+  string    kernel;
+  long long calls;       // calls per sample
+  integer   samples;
+  real_type min_ns, p10_ns, median_ns, p90_ns;
+  real_type allocs;      // per call
+  real_type alloc_bytes; // per call
+  long long bytes;       // arguments read and written per call
+  string    error;
+};
+
+typedef std::chrono::steady_clock clock_type;
+
+static real_type const min_sample_ns = 2e4; // shortest sample
+static real_type const max_kernel_ns = 2e9; // time budget of a kernel
+
+static
+real_type
+percentile( vector<real_type> const & v, real_type p ) {
+  // v is sorted, linear interpolation
+  real_type r  = p * real_type(v.size()-1);
+  size_t    i  = size_t( r );
+  size_t    i1 = min( i+1, v.size()-1 );
+  return v[i] + (r-real_type(i)) * (v[i1]-v[i]);
+}
+
+static
+real_type
+elapsedNs( clock_type::time_point t0 ) {
+  return real_type(
+    std::chrono::duration_cast<std::chrono::nanoseconds>( clock_type::now() - t0 ).count()
+  );
+}
+
+static
+measure
+timeKernel(
+  string                  const & kernel,
+  std::function<void()>   const & call,
+  long long                       bytes,
+  integer                         warmup,
+  integer                         samples
+) {
+  measure M;
+  M.kernel = kernel;
+  M.bytes  = bytes;
+  M.calls  = 0;
+  M.samples = 0;
+  M.min_ns = M.p10_ns = M.median_ns = M.p90_ns = 0;
+  M.allocs = M.alloc_bytes = 0;
+  try {
+    for ( integer i = 0; i < warmup; ++i ) call();
+
+    // calls per sample so that a sample is long enough for the clock
+    clock_type::time_point t0 = clock_type::now();
+    call();
+    real_type t1 = max( elapsedNs( t0 ), real_type(1) );
+    M.calls   = max( 1LL, static_cast<long long>( min_sample_ns / t1 ) );
+    M.samples = integer( max( 3.0, min( real_type(samples), max_kernel_ns / (t1*M.calls) ) ) );
+
+    vector<real_type> ns( size_t(M.samples) );
+    long long a0 = num_alloc, b0 = num_alloc_bytes;
+    for ( auto & t : ns ) {
+      t0 = clock_type::now();
+      for ( long long k = 0; k < M.calls; ++k ) call();
+      t = elapsedNs( t0 ) / real_type(M.calls);
+    }
+    real_type tot = real_type(M.calls) * real_type(M.samples);
+    M.allocs      = real_type( num_alloc - a0 ) / tot;
+    M.alloc_bytes = real_type( num_alloc_bytes - b0 ) / tot;
+
+    std::sort( ns.begin(), ns.end() );
+    M.min_ns    = ns.front();
+    M.p10_ns    = percentile( ns, 0.1 );
+    M.median_ns = percentile( ns, 0.5 );
+    M.p90_ns    = percentile( ns, 0.9 );
+  }
+  catch ( std::exception const & e ) {
+    M.error = e.what();
+  }
+  catch ( ... ) {
+    M.error = "unknown exception";
+  }
+  return M;
+}
+
+/*\
+ |  JSON
+\*/
+
+static
+string
+jsonString( string const & s ) {
+  string res = "\"";
+  for ( char c : s ) {
+    switch ( c ) {
+    case '"':  res += "\\\""; break;
+    case '\\': res += "\\\\"; break;
+    case '\n': res += "\\n";  break;
+    case '\t': res += "\\t";  break;
+    default:   res += c;      break;
+    }
+  }
+  return res + "\"";
+}
+
+//! value of `"key": ...` in a record line written by this program
+static
+bool
+jsonField( string const & line, string const & key, string & value ) {
+  string k = "\"" + key + "\": ";
+  size_t pos = line.find( k );
+  if ( pos == string::npos ) return false;
+  pos += k.size();
+  value.clear();
+  if ( line[pos] == '"' ) {
+    for ( ++pos; pos < line.size() && line[pos] != '"'; ++pos ) {
+      if ( line[pos] == '\\' && pos+1 < line.size() ) {
+        ++pos;
+        char c = line[pos];
+        value += c == 'n' ? '\n' : ( c == 't' ? '\t' : c );
+      } else {
+        value += line[pos];
+      }
+    }
+  } else {
+    size_t end = line.find_first_of( ",}", pos );
+    value = line.substr( pos, end-pos );
+  }
+  return true;
+}
+
+static
+string
+recordKey( string const & problem, string const & guess, string const & kernel ) {
+  return problem + "|" + guess + "|" + kernel;
+}
+
+int
+main( int argc, char const * argv[] ) {
+  string    out_name = "bench.json", base_name, filter;
+  real_type threshold = 0.1;
+  integer   samples   = 21;
+  integer   warmup    = 3;
+  integer   max_n     = numeric_limits<integer>::max();
+
+  for ( int i = 1; i < argc; ++i ) {
+    bool has_arg = i+1 < argc;
+    if      ( std::strcmp( argv[i], "-o" ) == 0 && has_arg ) out_name  = argv[++i];
+    else if ( std::strcmp( argv[i], "-b" ) == 0 && has_arg ) base_name = argv[++i];
+    else if ( std::strcmp( argv[i], "-t" ) == 0 && has_arg ) threshold = std::atof( argv[++i] );
+    else if ( std::strcmp( argv[i], "-r" ) == 0 && has_arg ) samples   = std::atoi( argv[++i] );
+    else if ( std::strcmp( argv[i], "-w" ) == 0 && has_arg ) warmup    = std::atoi( argv[++i] );
+    else if ( std::strcmp( argv[i], "-n" ) == 0 && has_arg ) max_n     = std::atoi( argv[++i] );
+    else if ( std::strcmp( argv[i], "-f" ) == 0 && has_arg ) filter    = argv[++i];
+    else {
+      fmt::print( "NLtoolbox_bench, bad option `{}`\n", argv[i] );
+      return 1;
+    }
+  }
+
+  initProblems();
+
+  std::ofstream out( out_name.c_str() );
+  if ( !out.good() ) {
+    fmt::print( "NLtoolbox_bench, cannot open `{}`\n", out_name );
+    return 1;
+  }
+  fmt::print(
+    out,
+    "{{\n\"version\": 1,\n\"samples\": {},\n\"warmup\": {},\n\"results\": [\n",
+    samples, warmup
+  );
+
+  std::map<string,std::pair<real_type,real_type> > timings; // median, min
+  bool    first    = true;
+  integer nrecords = 0;
+  integer const np = integer(theProblems.size());
+  integer const sI = integer(sizeof(integer));
+  integer const sR = integer(sizeof(real_type));
+  for ( integer ip = 0; ip < np; ++ip ) {
+    nonlinearSystem const & P = *theProblems[size_t(ip)];
+    integer const n = P.numEqns();
+    if ( n > max_n ) continue;
+    if ( !filter.empty() && P.title().find( filter ) == string::npos ) continue;
+    integer const nnz = P.jacobianNnz();
+
+    dvec_t x(n), f(n), jac(nnz), values;
+    ivec_t I(nnz), J(nnz), R, JC;
+    real_type sink = 0;
+
+    for ( integer ig = 0; ig < P.numInitialPoint(); ++ig ) {
+      P.getInitialPoint( x, ig );
+      measure M[5] = {
+        timeKernel( "evalF", [&]() { P.evalF( x, f ); }, (2*n)*sR, warmup, samples ),
+        timeKernel(
+          "evalFk",
+          [&]() { for ( integer k = 0; k < n; ++k ) sink += P.evalFk( x, k ); },
+          (n*n+n)*sR, warmup, samples
+        ),
+        timeKernel( "jacobian", [&]() { P.jacobian( x, jac ); }, (n+nnz)*sR, warmup, samples ),
+        timeKernel( "jacobianPattern", [&]() { P.jacobianPattern( I, J ); }, (2*nnz)*sI, warmup, samples ),
+        timeKernel(
+          "fill_CSR", [&]() { P.fill_CSR( x, R, JC, values ); },
+          (n+nnz)*sR + (4*nnz+n+1)*sI, warmup, samples
+        )
+      };
+      for ( measure const & m : M ) {
+        fmt::print(
+          out,
+          "{}{{\"problem\": {}, \"title\": {}, \"n\": {}, \"nnz\": {}, \"guess\": {}, "
+          "\"kernel\": {}, \"calls\": {}, \"samples\": {}, \"min_ns\": {:.6g}, "
+          "\"p10_ns\": {:.6g}, \"median_ns\": {:.6g}, \"p90_ns\": {:.6g}, "
+          "\"allocs\": {:.6g}, \"alloc_bytes\": {:.6g}, \"bytes\": {}, \"error\": {}}}",
+          first ? "" : ",\n", ip, jsonString( P.title() ), n, nnz, ig,
+          jsonString( m.kernel ), m.calls, m.samples, m.min_ns,
+          m.p10_ns, m.median_ns, m.p90_ns,
+          m.allocs, m.alloc_bytes, m.bytes, jsonString( m.error )
+        );
+        first = false;
+        ++nrecords;
+        if ( m.error.empty() )
+          timings[recordKey( fmt::format("{}",ip), fmt::format("{}",ig), m.kernel )] =
+            std::make_pair( m.median_ns, m.min_ns );
+      }
+    }
+    if ( sink == real_max ) fmt::print( "\n" ); // keep the evalFk sweep alive
+  }
+  fmt::print( out, "\n]\n}}\n" );
+  out.close();
+  fmt::print( "{} records written to `{}`\n", nrecords, out_name );
+
+  if ( base_name.empty() ) return 0;
+
+  // compare with the baseline
+  std::ifstream base( base_name.c_str() );
+  if ( !base.good() ) {
+    fmt::print( "NLtoolbox_bench, cannot open baseline `{}`\n", base_name );
+    return 1;
+  }
+  string  line, problem, title, guess, kernel, median, tmin, error;
+  integer ncompared = 0, nregress = 0;
+  real_type ratio_max = 0;
+  while ( std::getline( base, line ) ) {
+    if ( !jsonField( line, "problem",   problem ) ||
+         !jsonField( line, "guess",     guess   ) ||
+         !jsonField( line, "kernel",    kernel  ) ||
+         !jsonField( line, "median_ns", median  ) ||
+         !jsonField( line, "min_ns",    tmin    ) ) continue;
+    jsonField( line, "title", title );
+    jsonField( line, "error", error );
+    if ( !error.empty() ) continue;
+    auto it = timings.find( recordKey( problem, guess, kernel ) );
+    if ( it == timings.end() ) continue;
+    real_type t0    = std::atof( median.c_str() );
+    real_type tmin0 = std::atof( tmin.c_str() );
+    if ( t0 <= 0 || tmin0 <= 0 ) continue;
+    real_type ratio     = it->second.first / t0;
+    real_type ratio_min = it->second.second / tmin0;
+    ratio_max = max( ratio_max, min( ratio, ratio_min ) );
+    ++ncompared;
+    if ( ratio > 1+threshold && ratio_min > 1+threshold ) {
+      ++nregress;
+      fmt::print(
+        "REGRESSION {:<50} #{} {:<16} {:>12.4g} ns -> {:>12.4g} ns (x{:.3})\n",
+        title, guess, kernel, t0, it->second.first, ratio
+      );
+    }
+  }
+  fmt::print(
+    "compared {} kernels with `{}`: {} regressions above +{:.1f}%, worst ratio {:.3}\n",
+    ncompared, base_name, nregress, 100*threshold, ratio_max
+  );
+  return nregress > 0 ? 2 : 0;
+}
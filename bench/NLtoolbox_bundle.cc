@@ -0,0 +1,102 @@
+/*\
+ |
+ |  Export the problems of the catalogue as bundles for external codes.
+ |
+ |  NLtoolbox_bundle -w DIR [-p P] [-s S]
+ |
+ |    write the problems of the catalogue (only P with -p) into the
+ |    existing directory DIR, one bundle DIR/<index>.nlb each with S
+ |    reference samples (default 4), see NLbundleFormat.h
+ |
+ |  NLtoolbox_bundle [-v] FILE...
+ |
+ |    map the bundles and print their sizes, with -v evaluate the
+ |    problem of the catalogue recorded in each bundle at the samples
+ |    and compare; the exit code is 2 when some value differs
+ |
+\*/
+
+#include "NLbundle.hh"
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace NLproblem;
+
+int
+main( int argc, char const * argv[] ) {
+  string          dir;
+  vector<string>  files;
+  integer         problem  = -1;
+  integer         samples  = 4;
+  bool            validate = false;
+
+  for ( int i = 1; i < argc; ++i ) {
+    bool has_arg = i+1 < argc;
+    if      ( std::strcmp( argv[i], "-w" ) == 0 && has_arg ) dir     = argv[++i];
+    else if ( std::strcmp( argv[i], "-p" ) == 0 && has_arg ) problem = std::atoi( argv[++i] );
+    else if ( std::strcmp( argv[i], "-s" ) == 0 && has_arg ) samples = std::atoi( argv[++i] );
+    else if ( std::strcmp( argv[i], "-v" ) == 0 )            validate = true;
+    else if ( argv[i][0] != '-' )                            files.push_back( argv[i] );
+    else {
+      fmt::print( "NLtoolbox_bundle, bad option `{}`\n", argv[i] );
+      return 1;
+    }
+  }
+  if ( dir.empty() == files.empty() ) {
+    fmt::print( "NLtoolbox_bundle, expected -w DIR or bundles to read\n" );
+    return 1;
+  }
+
+  try {
+    Utils::TicToc tictoc;
+    if ( !dir.empty() ) {
+      initProblems();
+      integer const np = integer(theProblems.size());
+      UTILS_ASSERT( problem < np, "problem {} out of range", problem );
+      integer p0 = problem < 0 ? 0  : problem;
+      integer p1 = problem < 0 ? np : problem+1;
+      integer ns = 0;
+      tictoc.tic();
+      for ( integer p = p0; p < p1; ++p ) {
+        string fname = fmt::format( "{}/{}.nlb", dir, p );
+        ns += exportBundle( *theProblems[size_t(p)], fname, samples, p );
+      }
+      tictoc.toc();
+      fmt::print(
+        "{} bundles with {} samples written to `{}` in {:.4} ms\n",
+        p1-p0, ns, dir, tictoc.elapsed_ms()
+      );
+      return 0;
+    }
+
+    if ( validate ) initProblems();
+    integer num_bad = 0;
+    for ( auto const & fname : files ) {
+      tictoc.tic();
+      bundleReader B( fname );
+      tictoc.toc();
+      fmt::print(
+        "{}: `{}` (problem {}) n = {}, nnz = {}, {} initial points, {} exact solutions, "
+        "{} samples, {} bytes, mapped in {:.4} ms\n",
+        fname, B.title(), B.problem(), B.numEqns(), B.nnz(), B.numInitialPoint(),
+        B.numExactSolution(), B.numSamples(), B.fileBytes(), tictoc.elapsed_ms()
+      );
+      if ( !validate ) continue;
+      UTILS_ASSERT(
+        B.problem() >= 0 && B.problem() < integer(theProblems.size()),
+        "`{}` is not a problem of the catalogue", fname
+      );
+      integer ndiff;
+      real_type diff = validateBundle( B, *theProblems[size_t(B.problem())], ndiff );
+      if ( ndiff > 0 ) {
+        ++num_bad;
+        fmt::print( "  {} samples differ, max relative difference {:.3g}\n", ndiff, diff );
+      }
+    }
+    return num_bad > 0 ? 2 : 0;
+  } catch ( std::exception const & e ) {
+    fmt::print( "NLtoolbox_bundle, {}\n", e.what() );
+    return 1;
+  }
+}
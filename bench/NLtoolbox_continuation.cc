@@ -0,0 +1,129 @@
+/*\
+ |
+ |  Sweep a parameter of a family of problems by continuation.
+ |
+ |  NLtoolbox_continuation -p P -a P0 -b P1 [-k K] [-m NPTS] [-g G] [-l] [-c] [-o FILE]
+ |
+ |    follow the solution of the problem P of the catalogue while its
+ |    parameter K (default 0, see nonlinearSystem::numParams) goes from
+ |    P0 to P1, NPTS points (default 1000), from the initial point G at
+ |    P0 (see ContinuationDriver); -l equispaced points in log scale,
+ |    -c also solve each point with Newton from the initial point G for
+ |    comparison, -o write the points (p then x, one per line) to FILE
+ |
+\*/
+
+#include "NLcontinuation.hh"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+using namespace NLproblem;
+
+int
+main( int argc, char const * argv[] ) {
+  string    out_name;
+  integer   problem = -1;
+  integer   k       = 0;
+  integer   npts    = 1000;
+  integer   guess   = 0;
+  real_type p0      = 0;
+  real_type p1      = 0;
+  bool      has_p0  = false;
+  bool      has_p1  = false;
+  bool      logs    = false;
+  bool      cold    = false;
+
+  for ( int i = 1; i < argc; ++i ) {
+    bool has_arg = i+1 < argc;
+    if      ( std::strcmp( argv[i], "-p" ) == 0 && has_arg ) problem  = std::atoi( argv[++i] );
+    else if ( std::strcmp( argv[i], "-k" ) == 0 && has_arg ) k        = std::atoi( argv[++i] );
+    else if ( std::strcmp( argv[i], "-m" ) == 0 && has_arg ) npts     = std::atoi( argv[++i] );
+    else if ( std::strcmp( argv[i], "-g" ) == 0 && has_arg ) guess    = std::atoi( argv[++i] );
+    else if ( std::strcmp( argv[i], "-a" ) == 0 && has_arg ) { p0 = std::atof( argv[++i] ); has_p0 = true; }
+    else if ( std::strcmp( argv[i], "-b" ) == 0 && has_arg ) { p1 = std::atof( argv[++i] ); has_p1 = true; }
+    else if ( std::strcmp( argv[i], "-o" ) == 0 && has_arg ) out_name = argv[++i];
+    else if ( std::strcmp( argv[i], "-l" ) == 0 )            logs     = true;
+    else if ( std::strcmp( argv[i], "-c" ) == 0 )            cold     = true;
+    else {
+      fmt::print( "NLtoolbox_continuation, bad option `{}`\n", argv[i] );
+      return 1;
+    }
+  }
+  if ( !has_p0 || !has_p1 ) {
+    fmt::print( "NLtoolbox_continuation, expected -a P0 -b P1\n" );
+    return 1;
+  }
+
+  initProblems();
+  integer const np = integer(theProblems.size());
+
+  try {
+    UTILS_ASSERT( problem >= 0 && problem < np, "problem {} out of range", problem );
+    nonlinearSystem & P = *theProblems[size_t(problem)];
+    UTILS_ASSERT(
+      guess >= 0 && guess < P.numInitialPoint(), "initial point {} out of range", guess
+    );
+    UTILS_ASSERT( k >= 0 && k < P.numParams(), "`{}` has no parameter {}", P.title(), k );
+
+    dvec_t x0( P.numEqns() ), x( P.numEqns() );
+    P.getInitialPoint( x0, guess );
+
+    ContinuationDriver C;
+    C.setLogScale( logs );
+    vector<ContinuationDriver::branchPoint> branch;
+    x = x0;
+    C.sweep( P, k, p0, p1, npts, x, branch );
+
+    fmt::print(
+      "`{}` (n = {}), {} from {} to {}, {} of {} points\n",
+      P.title(), P.numEqns(), P.paramName( k ), p0, p1, branch.size(), npts
+    );
+    C.info( std::cout );
+    if ( branch.size() > 1 ) {
+      integer newton = 0;
+      for ( size_t i = 1; i < branch.size(); ++i ) newton += branch[i].num_newton;
+      fmt::print(
+        "  first point {} Newton steps, then {:.3} per point, {:.4} ms per point\n",
+        branch[0].num_newton, real_type(newton)/real_type(branch.size()-1),
+        C.elapsedMs()/real_type(branch.size())
+      );
+    }
+
+    if ( cold ) {
+      NewtonSolver S;
+      real_type const p_save = P.getParam( k );
+      integer nok = 0, iter = 0, nF = 0;
+      real_type ms = 0;
+      for ( auto const & b : branch ) {
+        P.setParam( k, b.p );
+        x = x0;
+        if ( S.solve( P, x ) ) ++nok;
+        iter += S.numIter();
+        nF   += S.numF();
+        ms   += S.elapsedMs();
+      }
+      P.setParam( k, p_save );
+      real_type nb = real_type( max( branch.size(), size_t(1) ) );
+      fmt::print(
+        "Newton from the initial point: {} of {} converged, {:.3} iter, {:.3} #F, {:.4} ms per point\n",
+        nok, branch.size(), real_type(iter)/nb, real_type(nF)/nb, ms/nb
+      );
+    }
+
+    if ( !out_name.empty() ) {
+      std::ofstream file( out_name.c_str() );
+      UTILS_ASSERT( file.good(), "cannot open `{}`", out_name );
+      for ( auto const & b : branch ) {
+        fmt::print( file, "{:.16g}", b.p );
+        for ( integer i = 0; i < b.x.size(); ++i ) fmt::print( file, "\t{:.16g}", b.x(i) );
+        fmt::print( file, "\n" );
+      }
+    }
+    return C.completed() ? 0 : 2;
+  } catch ( std::exception const & e ) {
+    fmt::print( "NLtoolbox_continuation, {}\n", e.what() );
+    return 1;
+  }
+}
@@ -0,0 +1,100 @@
+/*\
+ |
+ |  Hardware counters of the residual and jacobian kernels.
+ |
+ |  For each problem evalF and jacobian are called N times at an
+ |  initial point and the cycles, instructions, cache misses and branch
+ |  mispredictions per call and per nonzero of the jacobian are
+ |  reported with the instructions per cycle (IPC) and the cache misses
+ |  per thousand instructions (MPKI): a low IPC with a high MPKI points
+ |  to a memory bound kernel, a high IPC to a compute bound one.
+ |  Without the counters (see perfCounters) only the time is reported.
+ |
+ |  NLtoolbox_perf [options]
+ |
+ |    -N N      calls of each kernel (default 100)
+ |    -g G      initial point (default 0, the problems with fewer are skipped)
+ |    -n N      skip the problems with more than N equations
+ |    -f TEXT   only the problems with TEXT in the title
+ |
+\*/
+
+#include "NLperfCounters.hh"
+
+#include <cstring>
+
+using namespace NLproblem;
+
+static
+string
+column( real_type v, char const * fmt_spec ) {
+  return v < 0 ? string("-") : fmt::format( fmt_spec, v );
+}
+
+int
+main( int argc, char const * argv[] ) {
+  long long calls  = 100;
+  integer   guess  = 0;
+  integer   max_n  = numeric_limits<integer>::max();
+  string    filter;
+
+  for ( int i = 1; i < argc; ++i ) {
+    bool has_arg = i+1 < argc;
+    if      ( std::strcmp( argv[i], "-N" ) == 0 && has_arg ) calls  = std::atoll( argv[++i] );
+    else if ( std::strcmp( argv[i], "-g" ) == 0 && has_arg ) guess  = std::atoi( argv[++i] );
+    else if ( std::strcmp( argv[i], "-n" ) == 0 && has_arg ) max_n  = std::atoi( argv[++i] );
+    else if ( std::strcmp( argv[i], "-f" ) == 0 && has_arg ) filter = argv[++i];
+    else {
+      fmt::print( "NLtoolbox_perf, bad option `{}`\n", argv[i] );
+      return 1;
+    }
+  }
+
+  initProblems();
+
+  perfCounters pc;
+  if ( !pc.available() )
+    fmt::print( "hardware counters not available ({}), wall time only\n", pc.reason() );
+  else if ( !pc.reason().empty() )
+    fmt::print( "some counters not available ({})\n", pc.reason() );
+
+  fmt::print(
+    "{:<44} {:>8} {:>9} {:<8} {:>11} {:>12} {:>12} {:>6} {:>7} {:>10} {:>10} {:>9} {:>9}\n",
+    "problem", "n", "nnz", "kernel", "ns/call", "cycles/call", "instr/call",
+    "IPC", "MPKI", "miss/call", "brmis/call", "cyc/nnz", "miss/nnz"
+  );
+
+  vector<kernelPerf> res;
+  integer const np = integer(theProblems.size());
+  for ( integer ip = 0; ip < np; ++ip ) {
+    nonlinearSystem const & P = *theProblems[size_t(ip)];
+    integer const n   = P.numEqns();
+    integer const nnz = P.jacobianNnz();
+    if ( n > max_n || guess >= P.numInitialPoint() ) continue;
+    if ( !filter.empty() && P.title().find( filter ) == string::npos ) continue;
+    try {
+      profileKernels( P, guess, calls, pc, res );
+    } catch ( std::exception const & e ) {
+      fmt::print( "{:<44} {:>8} {:>9} error: {}\n", P.title().substr(0,44), n, nnz, e.what() );
+      continue;
+    }
+    for ( kernelPerf const & K : res ) {
+      real_type cyc  = K.count[PERF_CYCLES];
+      real_type ins  = K.count[PERF_INSTRUCTIONS];
+      real_type miss = K.count[PERF_CACHE_MISSES];
+      real_type ipc  = cyc  > 0 && ins >= 0 ? ins/cyc         : -1;
+      real_type mpki = ins  > 0 && miss >= 0 ? 1000*miss/ins  : -1;
+      real_type nz   = real_type( max( nnz, 1 ) );
+      fmt::print(
+        "{:<44} {:>8} {:>9} {:<8} {:>11.4g} {:>12} {:>12} {:>6} {:>7} {:>10} {:>10} {:>9} {:>9}\n",
+        P.title().substr(0,44), n, nnz, K.kernel, K.ns,
+        column( cyc, "{:.4g}" ), column( ins, "{:.4g}" ),
+        column( ipc, "{:.2f}" ), column( mpki, "{:.2f}" ),
+        column( miss, "{:.4g}" ), column( K.count[PERF_BRANCH_MISSES], "{:.4g}" ),
+        column( cyc  < 0 ? -1 : cyc/nz,  "{:.3g}" ),
+        column( miss < 0 ? -1 : miss/nz, "{:.3g}" )
+      );
+    }
+  }
+  return 0;
+}
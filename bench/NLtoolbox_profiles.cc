@@ -0,0 +1,108 @@
+/*\
+ |
+ |  Performance and data profiles of the results of NLtoolbox_batch.
+ |
+ |  NLtoolbox_profiles [options] batch files...
+ |
+ |    -m ms|F|J   cost compared: time, residual or jacobian evaluations
+ |                (default F)
+ |    -d          data profile (default performance profile)
+ |    -p N        points of the profile (default 41)
+ |    -x X        largest tau (alpha for -d), default from the results
+ |    -t TOL      a run is solved only if also its final ||F|| <= TOL
+ |    -c          comma separated values (default aligned table)
+ |    -o FILE     output file (default standard output)
+ |
+\*/
+
+#include "NLprofiles.hh"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+using namespace NLproblem;
+
+int
+main( int argc, char const * argv[] ) {
+  profileMetric  metric = PROFILE_NUM_F;
+  bool           data   = false;
+  bool           csv    = false;
+  integer        npts   = 41;
+  real_type      x_max  = 0;
+  real_type      tol    = 0;
+  string         out_name;
+  vector<string> files;
+
+  for ( int i = 1; i < argc; ++i ) {
+    bool has_arg = i+1 < argc;
+    if ( std::strcmp( argv[i], "-m" ) == 0 && has_arg ) {
+      string m = argv[++i];
+      if      ( m == "ms" ) metric = PROFILE_TIME;
+      else if ( m == "F"  ) metric = PROFILE_NUM_F;
+      else if ( m == "J"  ) metric = PROFILE_NUM_J;
+      else {
+        fmt::print( "NLtoolbox_profiles, unknown metric `{}`\n", m );
+        return 1;
+      }
+    }
+    else if ( std::strcmp( argv[i], "-d" ) == 0 )            data     = true;
+    else if ( std::strcmp( argv[i], "-c" ) == 0 )            csv      = true;
+    else if ( std::strcmp( argv[i], "-p" ) == 0 && has_arg ) npts     = std::atoi( argv[++i] );
+    else if ( std::strcmp( argv[i], "-x" ) == 0 && has_arg ) x_max    = std::atof( argv[++i] );
+    else if ( std::strcmp( argv[i], "-t" ) == 0 && has_arg ) tol      = std::atof( argv[++i] );
+    else if ( std::strcmp( argv[i], "-o" ) == 0 && has_arg ) out_name = argv[++i];
+    else if ( argv[i][0] != '-' )                            files.push_back( argv[i] );
+    else {
+      fmt::print( "NLtoolbox_profiles, bad option `{}`\n", argv[i] );
+      return 1;
+    }
+  }
+  if ( files.empty() ) {
+    fmt::print( "NLtoolbox_profiles, no batch files\n" );
+    return 1;
+  }
+
+  // the number of equations of each problem, for the data profiles
+  initProblems();
+
+  Utils::TicToc tictoc;
+  tictoc.tic();
+  RunRecords R;
+  R.setTolerance( tol );
+  try {
+    for ( auto const & f : files ) R.loadBatch( f );
+  } catch ( std::exception const & e ) {
+    fmt::print( "NLtoolbox_profiles, {}\n", e.what() );
+    return 1;
+  }
+  tictoc.toc();
+  real_type ms_load = tictoc.elapsed_ms();
+
+  tictoc.tic();
+  profileTable T;
+  if ( data ) R.dataProfile( metric, npts, x_max, T );
+  else        R.performanceProfile( metric, npts, x_max, T );
+  tictoc.toc();
+
+  std::ofstream file;
+  if ( !out_name.empty() ) {
+    file.open( out_name.c_str() );
+    if ( !file.good() ) {
+      fmt::print( "NLtoolbox_profiles, cannot open `{}`\n", out_name );
+      return 1;
+    }
+  }
+  ostream_type & out = out_name.empty() ? std::cout : file;
+  if ( csv ) T.writeCSV( out );
+  else       T.writeText( out );
+
+  // summary, out of the way of the table on the standard output
+  fmt::print(
+    stderr, "{} records, {} instances, {} solvers, read in {:.4} ms, profile in {:.4} ms\n",
+    R.numRecords(), R.numInstances(), R.numSolvers(), ms_load, tictoc.elapsed_ms()
+  );
+  for ( integer s = 0; s < R.numSolvers(); ++s )
+    fmt::print( stderr, "  {:<20} solved {}\n", R.solverName(s), R.numSolved(s) );
+  return 0;
+}
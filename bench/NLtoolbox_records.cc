@@ -0,0 +1,58 @@
+/*\
+ |
+ |  Read a record file (NLtoolbox_batch -R, asyncRecordWriter).
+ |
+ |  NLtoolbox_records file                 frames and problems of the file
+ |  NLtoolbox_records file problem [kind]  records of one problem, only
+ |                                         the frames holding it are read
+ |
+\*/
+
+#include "NLrecordFile.hh"
+
+#include <cstdlib>
+
+using namespace NLproblem;
+
+int
+main( int argc, char const * argv[] ) {
+  if ( argc < 2 || argc > 4 ) {
+    fmt::print( "usage: NLtoolbox_records file [problem [kind]]\n" );
+    return 1;
+  }
+
+  try {
+    Utils::TicToc tictoc;
+    tictoc.tic();
+    recordFileReader R( argv[1] );
+    if ( argc == 2 ) {
+      vector<integer> P;
+      R.problems( P );
+      tictoc.toc();
+      fmt::print(
+        "{} frames, {} records, {} problems, index read in {:.4} ms\n",
+        R.numFrames(), R.numRecords(), P.size(), tictoc.elapsed_ms()
+      );
+      for ( integer p : P ) fmt::print( " {}", p );
+      fmt::print( "\n" );
+      return 0;
+    }
+
+    integer problem = std::atoi( argv[2] );
+    integer kind    = argc == 4 ? std::atoi( argv[3] ) : -1;
+    vector<recordData> D;
+    R.readProblem( problem, D, kind );
+    tictoc.toc();
+    for ( auto const & d : D ) {
+      fmt::print( "guess {} solver {} kind {} n = {}:", d.guess, d.solver, d.kind, d.values.size() );
+      size_t nv = min( d.values.size(), size_t(6) );
+      for ( size_t i = 0; i < nv; ++i ) fmt::print( " {:.6g}", d.values[i] );
+      fmt::print( "{}\n", nv < d.values.size() ? " ..." : "" );
+    }
+    fmt::print( "{} records of problem {} in {:.4} ms\n", D.size(), problem, tictoc.elapsed_ms() );
+  } catch ( std::exception const & e ) {
+    fmt::print( "NLtoolbox_records, {}\n", e.what() );
+    return 1;
+  }
+  return 0;
+}
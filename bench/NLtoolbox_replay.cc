@@ -0,0 +1,131 @@
+/*\
+ |
+ |  Record the evaluations a solver asks to a problem and replay them.
+ |
+ |  NLtoolbox_replay -w FILE -p P [-g G] [-s SOLVER] [-x]
+ |
+ |    run SOLVER (Newton, Broyden, Schubert, LM, Tensor; default Newton)
+ |    on the problem P of the catalogue from its initial point G and
+ |    record the queries (see nonlinearSystemRecorder) into FILE, with
+ |    -x without the results
+ |
+ |  NLtoolbox_replay FILE [-p P] [-r R]
+ |
+ |    rerun the queries of FILE R times (default 5) on the problem P of
+ |    the catalogue (default the recorded one, any problem with the same
+ |    sizes can be used), report the time per call of each routine and
+ |    the results that are not bitwise equal to the recorded ones; the
+ |    exit code is 2 when some result differs
+ |
+\*/
+
+#include "NLreplay.hh"
+#include "NLsolverBroyden.hh"
+#include "NLsolverSchubert.hh"
+#include "NLsolverLevenbergMarquardt.hh"
+#include "NLsolverTensor.hh"
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace NLproblem;
+
+static
+NLsolver *
+newSolver( string const & name ) {
+  if ( name == "Newton"   ) return new NewtonSolver();
+  if ( name == "Broyden"  ) return new BroydenSolver();
+  if ( name == "Schubert" ) return new SchubertSolver();
+  if ( name == "LM"       ) return new LevenbergMarquardtSolver();
+  if ( name == "Tensor"   ) return new TensorNewtonSolver();
+  return nullptr;
+}
+
+int
+main( int argc, char const * argv[] ) {
+  string  record_name, trace_name, solver = "Newton";
+  integer problem = -1;
+  integer guess   = 0;
+  integer repeat  = 5;
+  bool    results = true;
+
+  for ( int i = 1; i < argc; ++i ) {
+    bool has_arg = i+1 < argc;
+    if      ( std::strcmp( argv[i], "-w" ) == 0 && has_arg ) record_name = argv[++i];
+    else if ( std::strcmp( argv[i], "-p" ) == 0 && has_arg ) problem     = std::atoi( argv[++i] );
+    else if ( std::strcmp( argv[i], "-g" ) == 0 && has_arg ) guess       = std::atoi( argv[++i] );
+    else if ( std::strcmp( argv[i], "-s" ) == 0 && has_arg ) solver      = argv[++i];
+    else if ( std::strcmp( argv[i], "-r" ) == 0 && has_arg ) repeat      = std::atoi( argv[++i] );
+    else if ( std::strcmp( argv[i], "-x" ) == 0 )            results     = false;
+    else if ( argv[i][0] != '-' )                            trace_name  = argv[i];
+    else {
+      fmt::print( "NLtoolbox_replay, bad option `{}`\n", argv[i] );
+      return 1;
+    }
+  }
+  if ( record_name.empty() == trace_name.empty() ) {
+    fmt::print( "NLtoolbox_replay, expected -w FILE or a trace to replay\n" );
+    return 1;
+  }
+
+  initProblems();
+  integer const np = integer(theProblems.size());
+
+  try {
+    if ( !record_name.empty() ) {
+      UTILS_ASSERT( problem >= 0 && problem < np, "problem {} out of range", problem );
+      nonlinearSystem const * P = theProblems[size_t(problem)];
+      UTILS_ASSERT(
+        guess >= 0 && guess < P->numInitialPoint(), "initial point {} out of range", guess
+      );
+      std::unique_ptr<NLsolver> S( newSolver( solver ) );
+      UTILS_ASSERT( S, "unknown solver `{}`", solver );
+
+      nonlinearSystemRecorder REC( P, record_name, problem, results );
+      dvec_t x( P->numEqns() );
+      P->getInitialPoint( x, guess );
+      S->solve( REC, x );
+      REC.close();
+      S->info( std::cout );
+      fmt::print( "{} queries recorded to `{}`\n", REC.numQueries(), record_name );
+      return 0;
+    }
+
+    evaluationTrace T;
+    T.load( trace_name );
+    if ( problem < 0 ) problem = T.problem;
+    UTILS_ASSERT( problem >= 0 && problem < np, "problem {} out of range", problem );
+    nonlinearSystem const & P = *theProblems[size_t(problem)];
+
+    replayReport rep;
+    replayTrace( T, P, repeat, rep );
+
+    fmt::print(
+      "trace of `{}` (n = {}, nnz = {}), {} queries, replayed on `{}`\n",
+      T.title, T.n, T.nnz, rep.num_queries, P.title()
+    );
+    char const * names[QUERY_NUM_KINDS] = { "evalF", "evalFk", "jacobian", "fixedPointMap" };
+    for ( integer k = 0; k < QUERY_NUM_KINDS; ++k ) {
+      if ( rep.num_calls[k] == 0 ) continue;
+      fmt::print( "  {:<14} {:>8} calls {:>12.4g} ns/call\n", names[k], rep.num_calls[k], rep.ns[k] );
+    }
+    fmt::print(
+      "  total {:.4g} ms, {:.4g} queries/s\n",
+      rep.total_ms, rep.total_ms > 0 ? 1e3*real_type(rep.num_queries)/rep.total_ms : 0
+    );
+    if ( !T.results ) {
+      fmt::print( "  results not recorded, nothing compared\n" );
+      return 0;
+    }
+    fmt::print(
+      "  compared {}, different {} (exceptions {}), max |diff| = {:.3g}",
+      rep.num_compared, rep.num_different, rep.num_throw_mismatch, rep.max_abs_diff
+    );
+    if ( rep.first_different >= 0 ) fmt::print( ", first at query {}", rep.first_different );
+    fmt::print( "\n" );
+    return rep.num_different > 0 ? 2 : 0;
+  } catch ( std::exception const & e ) {
+    fmt::print( "NLtoolbox_replay, {}\n", e.what() );
+    return 1;
+  }
+}
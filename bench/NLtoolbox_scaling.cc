@@ -0,0 +1,205 @@
+/*\
+ |
+ |  Complexity scaling of the scalable families (theScalableProblems).
+ |
+ |  Each family is built at n = 10, 100, ..., 10^6 (the first admissible
+ |  size from n, the growth stops when the predicted memory or time of
+ |  the next size is over the budget) and the kernels evalF, evalFk
+ |  sweep, jacobian and fill_CSR are timed at the first initial point.
+ |  The exponent p of t ~ n^p is the least squares slope of log t
+ |  against log n on the largest sizes (at least 100 equations), the
+ |  peak of the allocated bytes of each size (see bench_memory.hh)
+ |  gives the memory exponent.
+ |  A family fails when an exponent exceeds the declared one
+ |  (theScalableComplexity) by more than the slack, the exit code is
+ |  then 2.
+ |
+ |  NLtoolbox_scaling [options]
+ |
+ |    -N N      largest size (default 1000000)
+ |    -f TEXT   only the families with TEXT in the name
+ |    -t MS     time budget of a kernel at one size (default 2000)
+ |    -M MB     memory budget of one size (default 2048)
+ |    -s X      slack on the exponents (default 0.3)
+ |
+\*/
+
+#include "testsNonlin.hh"
+
+#include "bench_memory.hh"
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+
+using namespace NLproblem;
+
+typedef std::chrono::steady_clock clock_type;
+
+static
+real_type
+elapsedNs( clock_type::time_point t0 ) {
+  return real_type(
+    std::chrono::duration_cast<std::chrono::nanoseconds>( clock_type::now() - t0 ).count()
+  );
+}
+
+//! minimum time per call of 5 samples of at least 0.1 ms each
+static
+real_type
+timeKernel( std::function<void()> const & call, real_type budget_ns ) {
+  clock_type::time_point t0 = clock_type::now();
+  call();
+  real_type t1    = max( elapsedNs( t0 ), real_type(1) );
+  long long calls = max( 1LL, static_cast<long long>( 1e5 / t1 ) );
+  real_type best  = t1;
+  real_type used  = t1;
+  for ( integer s = 0; s < 5 && used < budget_ns; ++s ) {
+    t0 = clock_type::now();
+    for ( long long k = 0; k < calls; ++k ) call();
+    real_type t = elapsedNs( t0 );
+    used += t;
+    best  = min( best, t / real_type(calls) );
+  }
+  return best;
+}
+
+//! least squares slope of log(y) against log(x)
+static
+real_type
+slope( vector<real_type> const & x, vector<real_type> const & y ) {
+  size_t const m = x.size();
+  real_type sx = 0, sy = 0, sxx = 0, sxy = 0;
+  for ( size_t i = 0; i < m; ++i ) {
+    real_type lx = std::log( x[i] ), ly = std::log( y[i] );
+    sx += lx; sy += ly; sxx += lx*lx; sxy += lx*ly;
+  }
+  return ( m*sxy - sx*sy ) / ( m*sxx - sx*sx );
+}
+
+int
+main( int argc, char const * argv[] ) {
+  integer   max_n     = 1000000;
+  string    filter;
+  real_type budget_ms = 2000;
+  real_type budget_mb = 2048;
+  real_type slack     = 0.3;
+
+  for ( int i = 1; i < argc; ++i ) {
+    bool has_arg = i+1 < argc;
+    if      ( std::strcmp( argv[i], "-N" ) == 0 && has_arg ) max_n     = std::atoi( argv[++i] );
+    else if ( std::strcmp( argv[i], "-f" ) == 0 && has_arg ) filter    = argv[++i];
+    else if ( std::strcmp( argv[i], "-t" ) == 0 && has_arg ) budget_ms = std::atof( argv[++i] );
+    else if ( std::strcmp( argv[i], "-M" ) == 0 && has_arg ) budget_mb = std::atof( argv[++i] );
+    else if ( std::strcmp( argv[i], "-s" ) == 0 && has_arg ) slack     = std::atof( argv[++i] );
+    else {
+      fmt::print( "NLtoolbox_scaling, bad option `{}`\n", argv[i] );
+      return 1;
+    }
+  }
+
+  initProblems();
+
+  char const * kernels[] = { "evalF", "evalFk", "jacobian", "fill_CSR" };
+  integer const nk = 4;
+
+  real_type const budget_ns    = 1e6*budget_ms;
+  real_type const budget_bytes = budget_mb*1024*1024;
+
+  integer nfamily = 0, nfail = 0;
+  for ( auto const & fam : theScalableProblems ) {
+    string const & name = fam.first;
+    if ( !filter.empty() && name.find( filter ) == string::npos ) continue;
+    scalableComplexity const & C = theScalableComplexity.at( name );
+    real_type declared[4] = { C.residual, C.sweep, C.jacobian, C.jacobian };
+    ++nfamily;
+
+    vector<real_type> N, T[4], MEM;
+    string stop = "max size";
+    for ( integer n0 = 10; n0 <= max_n; n0 *= 10 ) {
+      // predicted cost from the previous size
+      if ( !N.empty() ) {
+        real_type r = n0 / N.back(), tmax = 0;
+        for ( integer k = 0; k < nk; ++k )
+          tmax = max( tmax, T[k].back() * std::pow( r, max( declared[k], real_type(1) ) ) );
+        real_type mem = max( MEM.back(), real_type(1) ) * std::pow( r, max( C.jacobian, real_type(1) ) );
+        if ( tmax > budget_ns )    { stop = "time budget";   break; }
+        if ( mem  > budget_bytes ) { stop = "memory budget"; break; }
+      }
+
+      // the first admissible size from n0
+      long long live0 = live_bytes;
+      resetPeakBytes();
+      nonlinearSystem * P = nullptr;
+      for ( integer n = n0; n < n0+4 && P == nullptr; ++n ) {
+        try {
+          P = fam.second( n );
+        } catch ( ... ) {
+          P = nullptr;
+        }
+      }
+      if ( P == nullptr ) { stop = "no admissible size"; break; }
+
+      integer const n   = P->numEqns();
+      integer const nnz = P->jacobianNnz();
+      real_type t[4];
+      bool ok = true;
+      try {
+        dvec_t x(n), f(n), jac(nnz), values;
+        ivec_t R, J;
+        real_type sink = 0;
+        P->getInitialPoint( x, 0 );
+        t[0] = timeKernel( [&]() { P->evalF( x, f ); }, budget_ns );
+        t[1] = timeKernel( [&]() { for ( integer k = 0; k < n; ++k ) sink += P->evalFk( x, k ); }, budget_ns );
+        t[2] = timeKernel( [&]() { P->jacobian( x, jac ); }, budget_ns );
+        t[3] = timeKernel( [&]() { P->fill_CSR( x, R, J, values ); }, budget_ns );
+        if ( sink == real_max ) fmt::print( "\n" ); // keep the evalFk sweep alive
+      } catch ( std::exception const & e ) {
+        stop = e.what();
+        ok   = false;
+      }
+      delete P;
+      if ( !ok ) break;
+
+      N.push_back( n );
+      for ( integer k = 0; k < nk; ++k ) T[k].push_back( t[k] );
+      MEM.push_back( real_type( peak_bytes - live0 ) );
+    }
+
+    // fit on the sizes with at least 100 equations, the largest three
+    size_t i0 = 0;
+    while ( i0 < N.size() && N[i0] < 100 ) ++i0;
+    if ( N.size() > i0+3 ) i0 = N.size()-3;
+
+    fmt::print( "{:<36} n = [", name );
+    for ( real_type n : N ) fmt::print( " {}", integer(n) );
+    fmt::print( " ] stop: {}\n", stop );
+    if ( N.size() < i0+2 ) {
+      fmt::print( "  too few sizes to fit\n" );
+      continue;
+    }
+    vector<real_type> x( N.begin()+i0, N.end() );
+    bool family_ok = true;
+    for ( integer k = 0; k < nk; ++k ) {
+      vector<real_type> y( T[k].begin()+i0, T[k].end() );
+      real_type p    = slope( x, y );
+      bool      fail = p > declared[k] + slack;
+      family_ok = family_ok && !fail;
+      fmt::print(
+        "  {:<10} exponent {:5.2f} declared {:3.1f} {:<4} t(n = {}) = {:.4g} ms\n",
+        kernels[k], p, declared[k], fail ? "FAIL" : "", integer(N.back()), y.back()/1e6
+      );
+    }
+    if ( hasLiveBytes() ) {
+      vector<real_type> y( MEM.begin()+i0, MEM.end() );
+      fmt::print(
+        "  {:<10} exponent {:5.2f} peak {:.4g} MB\n",
+        "memory", slope( x, y ), MEM.back()/(1024*1024)
+      );
+    }
+    if ( !family_ok ) ++nfail;
+  }
+
+  fmt::print( "\n{} families, {} over the declared complexity\n", nfamily, nfail );
+  return nfail > 0 ? 2 : 0;
+}
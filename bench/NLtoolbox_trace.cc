@@ -0,0 +1,90 @@
+/*\
+ |
+ |  Convert a compressed binary trace (NLtoolbox_batch -T) to the
+ |  Chrome/Perfetto JSON format and summarize the load of the threads:
+ |  for each thread the time inside the outermost scopes of each name
+ |  (`job` for the batch runner) over the span of the trace, a long
+ |  idle tail of some workers shows the imbalance of the run.
+ |
+ |  NLtoolbox_trace trace [output.json]
+ |
+\*/
+
+#include "NLtrace.hh"
+#include "Utils_zstream.hh"
+
+#include <fstream>
+#include <iostream>
+
+using namespace NLproblem;
+
+int
+main( int argc, char const * argv[] ) {
+  if ( argc < 2 || argc > 3 ) {
+    fmt::print( "usage: NLtoolbox_trace trace [output.json]\n" );
+    return 1;
+  }
+
+  traceData T;
+  try {
+    std::ifstream file( argv[1], std::ios::in | std::ios::binary );
+    UTILS_ASSERT( file.good(), "cannot open `{}`", argv[1] );
+    zstream::izstream zfile( file );
+    T.readBinary( zfile );
+  } catch ( std::exception const & e ) {
+    fmt::print( "NLtoolbox_trace, {}\n", e.what() );
+    return 1;
+  }
+
+  if ( argc == 3 ) {
+    std::ofstream out( argv[2] );
+    if ( !out.good() ) {
+      fmt::print( "NLtoolbox_trace, cannot open `{}`\n", argv[2] );
+      return 1;
+    }
+    T.writeChromeJSON( out );
+  }
+
+  // span of the trace
+  uint64_t t_min = numeric_limits<uint64_t>::max(), t_max = 0;
+  for ( auto const & t : T.threads ) {
+    if ( t.events.empty() ) continue;
+    t_min = min( t_min, t.events.front().ts_ns );
+    t_max = max( t_max, t.events.back().ts_ns );
+  }
+  real_type span = t_max > t_min ? real_type(t_max-t_min) : 1;
+  fmt::print(
+    "{} events, {} threads, span {:.4} ms\n",
+    T.numEvents(), T.threads.size(), span*1e-6
+  );
+
+  // time in the outermost scopes of each name for each thread
+  for ( auto const & t : T.threads ) {
+    vector<integer>   depth( T.names.size(), 0 );
+    vector<uint64_t>  start( T.names.size(), 0 );
+    vector<real_type> busy( T.names.size(), 0 );
+    vector<integer>   count( T.names.size(), 0 );
+    for ( auto const & e : t.events ) {
+      if ( e.phase == 'B' ) {
+        if ( depth[e.name]++ == 0 ) start[e.name] = e.ts_ns;
+        ++count[e.name];
+      } else if ( e.phase == 'E' && depth[e.name] > 0 ) {
+        if ( --depth[e.name] == 0 ) busy[e.name] += real_type( e.ts_ns - start[e.name] );
+      } else if ( e.phase == 'i' ) {
+        ++count[e.name];
+      }
+    }
+    fmt::print( "{:<12} {:>8} events", t.name, t.events.size() );
+    if ( !t.events.empty() )
+      fmt::print( ", last at {:.1f}%", 100*real_type(t.events.back().ts_ns-t_min)/span );
+    fmt::print( "\n" );
+    for ( size_t k = 0; k < T.names.size(); ++k ) {
+      if ( count[k] == 0 ) continue;
+      fmt::print(
+        "  {:<12} {:>8} calls {:>12.4} ms {:>6.1f}%\n",
+        T.names[k], count[k], busy[k]*1e-6, 100*busy[k]/span
+      );
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,70 @@
+/*\
+ |
+ |  Anderson acceleration against Newton on the fixed point form problems.
+ |
+ |  Chandrasekhar and DiscreteIntegralEquationFunction have a dense
+ |  jacobian: Newton is run only while the n x n jacobian fits in memory
+ |  (n <= 2000), Anderson up to n = 10^4.
+ |
+\*/
+
+#include "NLsolverAnderson.hh"
+
+using namespace NLproblem;
+
+int
+main() {
+  initProblems();
+
+  NewtonSolver   newton;
+  AndersonSolver anderson( 10 );
+  anderson.setMaxIterations( 500 );
+
+  char const * families[] = {
+    "Chandrasekhar(0.9)",
+    "Chandrasekhar(0.9999)",
+    "DiscreteIntegralEquationFunction"
+  };
+  integer const sizes[] = { 100, 1000, 2000, 10000 };
+
+  for ( auto fam : families ) {
+    for ( auto n : sizes ) {
+      nonlinearSystem * P = theScalableProblems.at(fam)( n );
+      fmt::print( "\n{} ({})\n", P->title(), fam );
+      NLsolver * solvers[] = { &newton, &anderson };
+      for ( auto S : solvers ) {
+        if ( S == &newton && n > 2000 ) {
+          fmt::print(
+            "{:<12} SKIP dense jacobian needs {:.1f} MB\n",
+            S->name(), (16.0*n*n)/(1024*1024)
+          );
+          continue;
+        }
+        dvec_t x(n);
+        P->getInitialPoint( x, 0 );
+        try {
+          S->solve( *P, x );
+          S->info( std::cout );
+        } catch ( std::exception const & e ) {
+          fmt::print( "{:<12} ERROR {}\n", S->name(), e.what() );
+        }
+      }
+      delete P;
+    }
+  }
+
+  // the catalogue instances with a native fixed point form
+  fmt::print( "\nCatalogue problems with native fixed point form\n" );
+  for ( auto const & P : theProblems ) {
+    if ( !P->hasFixedPointForm() ) continue;
+    fmt::print( "\n{}\n", P->title() );
+    NLsolver * solvers[] = { &newton, &anderson };
+    for ( auto S : solvers ) {
+      dvec_t x( P->numEqns() );
+      P->getInitialPoint( x, 0 );
+      S->solve( *P, x );
+      S->info( std::cout );
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,61 @@
+/*\
+ |
+ |  Limited memory Broyden and sparse Schubert against full Newton.
+ |
+ |  Runs on BroydenTridiagonalFunction(.,1,500), GeneralizedRosenbrock(500),
+ |  SchubertBroydenFunction and every problem of the catalogue with n = 5000,
+ |  reporting residual and jacobian evaluations and wall time.
+ |
+\*/
+
+#include "NLsolverBroyden.hh"
+#include "NLsolverSchubert.hh"
+
+using namespace NLproblem;
+
+static
+bool
+selected( nonlinearSystem const * P ) {
+  string const & t = P->title();
+  if ( t == "Broyden tridiagonal function neq = 500" ) return true;
+  if ( t == "Generalized Rosenbrock function neq = 500" ) return true;
+  if ( t.compare( 0, 25, "Schubert Broyden function" ) == 0 ) return true;
+  return P->numEqns() == 5000;
+}
+
+int
+main() {
+  initProblems();
+
+  NewtonSolver  newton;
+  BroydenSolver good( BroydenSolver::GOOD_BROYDEN, BroydenSolver::INIT_JACOBIAN, 20 );
+  BroydenSolver bad( BroydenSolver::BAD_BROYDEN, BroydenSolver::INIT_JACOBIAN, 20 );
+  BroydenSolver ident( BroydenSolver::GOOD_BROYDEN, BroydenSolver::INIT_IDENTITY, 20 );
+  SchubertSolver schubert;
+
+  good.setMaxIterations( 1000 );
+  bad.setMaxIterations( 1000 );
+  ident.setMaxIterations( 1000 );
+  schubert.setMaxIterations( 1000 );
+
+  NLsolver * solvers[] = { &newton, &good, &bad, &ident, &schubert };
+
+  for ( auto const & P : theProblems ) {
+    if ( !selected(P) ) continue;
+    integer n = P->numEqns();
+    for ( integer ig = 0; ig < P->numInitialPoint(); ++ig ) {
+      fmt::print( "\n{} (guess {})\n", P->title(), ig );
+      for ( auto S : solvers ) {
+        dvec_t x(n);
+        P->getInitialPoint( x, ig );
+        try {
+          S->solve( *P, x );
+          S->info( std::cout );
+        } catch ( std::exception const & e ) {
+          fmt::print( "{:<12} ERROR {}\n", S->name(), e.what() );
+        }
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,71 @@
+/*\
+ |
+ |  Deflated Newton on the problems of the catalogue.
+ |
+ |  For each problem the deflation chains are run from the initial
+ |  points by one worker and by the pool, the distinct roots are
+ |  counted and compared with the exact solutions recorded by the
+ |  problem.
+ |
+\*/
+
+#include "NLsolverDeflation.hh"
+
+using namespace NLproblem;
+
+int
+main() {
+  initProblems();
+
+  DeflationSolver serial(1);
+  DeflationSolver parallel;
+  serial.setMaxRoots( 20 );
+  parallel.setMaxRoots( 20 );
+
+  fmt::print( "threads = {}\n", parallel.numThreads() );
+
+  real_type ms[2]    = { 0, 0 };
+  integer   multiple = 0, known = 0, recovered = 0;
+  for ( auto const & P : theProblems ) {
+    integer n = P->numEqns();
+    if ( n > 20 ) continue;
+    try {
+      serial.solveAll( *P );
+      parallel.solveAll( *P );
+    } catch ( std::exception const & e ) {
+      fmt::print( "{:<50} skipped: {}\n", P->title(), e.what() );
+      continue;
+    }
+    ms[0] += serial.elapsedMs();
+    ms[1] += parallel.elapsedMs();
+
+    DeflationSolver const & D = parallel;
+    if ( D.numRoots() > 1 ) ++multiple;
+
+    // exact solutions among the roots
+    integer ne = P->numExactSolution(), found = 0;
+    dvec_t  xe(n);
+    for ( integer i = 0; i < ne; ++i ) {
+      P->getExactSolution( xe, i );
+      for ( integer k = 0; k < D.numRoots(); ++k ) {
+        if ( (D.root(k)-xe).norm() <= 1e-6*(1+xe.norm()) ) { ++found; break; }
+      }
+    }
+    known     += ne;
+    recovered += found;
+
+    fmt::print(
+      "{:<50} roots = {:<3} exact = {}/{:<3} dup = {:<3} iter = {:<6} "
+      "serial {:.4} ms, parallel {:.4} ms\n",
+      P->title(), D.numRoots(), found, ne, D.numDuplicate(), D.numIter(),
+      serial.elapsedMs(), parallel.elapsedMs()
+    );
+  }
+
+  fmt::print(
+    "\nproblems with more than one root = {}, exact solutions recovered {}/{}\n"
+    "total: serial {:.4} ms, parallel {:.4} ms\n",
+    multiple, recovered, known, ms[0], ms[1]
+  );
+  return 0;
+}
@@ -0,0 +1,61 @@
+/*\
+ |
+ |  Native Hooke-Jeeves pattern search, serial against batch parallel polling.
+ |
+ |  The MATLAB driver toolbox/tests/test_HJ.m stops at neq <= 10; here
+ |  the catalogue problems with 50 <= n <= 500 are run from the first
+ |  initial point with the same convergence threshold ||F|| < 1e-6.
+ |
+\*/
+
+#include "NLsolverHookeJeeves.hh"
+
+using namespace NLproblem;
+
+int
+main() {
+  initProblems();
+
+  HookeJeevesSolver serial;
+  HookeJeevesSolver parallel;
+  serial.setParallel( false );
+
+  HookeJeevesSolver * solvers[] = { &serial, &parallel };
+  char const *        names[]   = { "HJ serial", "HJ parallel" };
+
+  fmt::print( "threads = {}\n", parallel.numThreads() );
+
+  integer   num_test = 0;
+  integer   ok[2]    = { 0, 0 };
+  real_type ms[2]    = { 0, 0 };
+
+  for ( auto const & P : theProblems ) {
+    integer n = P->numEqns();
+    if ( n < 50 || n > 500 ) continue;
+    ++num_test;
+    fmt::print( "\n{}{}\n", P->title(), P->isThreadSafe() ? "" : " (serial only)" );
+    for ( integer is = 0; is < 2; ++is ) {
+      HookeJeevesSolver & S = *solvers[is];
+      S.setTolerance( 1e-6 );
+      S.setMaxFunEvaluation( 200000 );
+      dvec_t x(n);
+      P->getInitialPoint( x, 0 );
+      try {
+        if ( S.solve( *P, x ) ) ++ok[is];
+        ms[is] += S.elapsedMs();
+        fmt::print(
+          "{:<12} {:<4} #F = {:<8} cache hit = {:<7} ||F|| = {:<12.5} [{:.3} ms]\n",
+          names[is], S.converged() ? "OK" : "FAIL",
+          S.numF(), S.numCacheHit(), S.normF(), S.elapsedMs()
+        );
+      } catch ( std::exception const & e ) {
+        fmt::print( "{:<12} ERROR {}\n", names[is], e.what() );
+      }
+    }
+  }
+
+  fmt::print( "\n{} problems with 50 <= n <= 500\n", num_test );
+  for ( integer is = 0; is < 2; ++is )
+    fmt::print( "{:<12} solved = {:<4} [{:.4} ms]\n", names[is], ok[is], ms[is] );
+  return 0;
+}
@@ -0,0 +1,72 @@
+/*\
+ |
+ |  Total degree homotopy on the polynomial problems of the catalogue.
+ |
+ |  All the paths are tracked by one worker and by the work stealing
+ |  pool, the end points are classified (finite, at infinity, failed)
+ |  and the real roots are compared with the one found by Newton from
+ |  the initial point of the problem.
+ |
+\*/
+
+#include "NLsolverHomotopy.hh"
+
+using namespace NLproblem;
+
+int
+main() {
+  initProblems();
+
+  HomotopySolver serial(1);
+  HomotopySolver parallel;
+  NewtonSolver   newton;
+  serial.setMaxPaths( 512 );
+  parallel.setMaxPaths( 512 );
+
+  fmt::print( "threads = {}\n", parallel.numThreads() );
+
+  real_type ms[2] = { 0, 0 };
+  for ( auto const & P : theProblems ) {
+    if ( !P->isPolynomial() ) continue;
+    integer n = P->numEqns();
+    fmt::print( "\n{}\n", P->title() );
+    try {
+      serial.solveAll( *P );
+      parallel.solveAll( *P );
+    } catch ( std::exception const & e ) {
+      fmt::print( "skipped: {}\n", e.what() );
+      continue;
+    }
+    ms[0] += serial.elapsedMs();
+    ms[1] += parallel.elapsedMs();
+
+    HomotopySolver const & H = parallel;
+    fmt::print(
+      "paths = {:<5} finite = {:<4} infinity = {:<4} failed = {:<4}\n"
+      "roots = {:<5} real = {:<4} steps = {:<8} steals = {}\n"
+      "serial {:.4} ms, parallel {:.4} ms\n",
+      H.numPaths(),
+      H.numPaths( HomotopySolver::PATH_FINITE ),
+      H.numPaths( HomotopySolver::PATH_AT_INFINITY ),
+      H.numPaths( HomotopySolver::PATH_FAILED ),
+      H.numRoots(), H.numRealRoots(), H.numIter(), H.numSteal(),
+      serial.elapsedMs(), parallel.elapsedMs()
+    );
+
+    dvec_t x(n), r(n);
+    P->getInitialPoint( x, 0 );
+    if ( newton.solve( *P, x ) ) {
+      real_type dist = real_max;
+      for ( integer i = 0; i < H.numRealRoots(); ++i ) {
+        H.realRoot( i, r );
+        dist = min( dist, (r-x).norm() / ( 1 + x.norm() ) );
+      }
+      fmt::print( "Newton root {} the homotopy roots\n", dist < 1e-6 ? "is among" : "is NOT among" );
+    } else {
+      fmt::print( "Newton does not converge\n" );
+    }
+  }
+
+  fmt::print( "\ntotal: serial {:.4} ms, parallel {:.4} ms\n", ms[0], ms[1] );
+  return 0;
+}
@@ -0,0 +1,102 @@
+/*\
+ |
+ |  Interval branch and prune on the polynomial problems of the catalogue.
+ |
+ |  The box is the bounding box of the problem when finite, otherwise
+ |  [-r,r]^n with r twice the largest real root found by the total
+ |  degree homotopy (r = 2 when it has too many paths, the box of the
+ |  interval arithmetic benchmark). The boxes are processed by one
+ |  worker and by the work stealing pool, then the real roots of the
+ |  homotopy in the box are checked to be enclosed.
+ |
+\*/
+
+#include "NLsolverInterval.hh"
+#include "NLsolverHomotopy.hh"
+
+using namespace NLproblem;
+
+int
+main() {
+  initProblems();
+
+  IntervalSolver serial(1);
+  IntervalSolver parallel;
+  HomotopySolver homotopy;
+  homotopy.setMaxPaths( 512 );
+  serial.setMaxBoxes( 200000 );
+  parallel.setMaxBoxes( 200000 );
+
+  fmt::print( "threads = {}\n", parallel.numThreads() );
+
+  real_type ms[2] = { 0, 0 };
+  for ( auto const & P : theProblems ) {
+    if ( !P->isPolynomial() ) continue;
+    integer n = P->numEqns();
+    fmt::print( "\n{}\n", P->title() );
+
+    bool has_roots = true;
+    try {
+      homotopy.solveAll( *P );
+    } catch ( std::exception const & ) {
+      has_roots = false;
+    }
+
+    dvec_t L(n), U(n), r(n);
+    P->boundingBox( L, U );
+    if ( L.minCoeff() <= -real_max || U.maxCoeff() >= real_max ) {
+      real_type rmax = has_roots ? 0.5 : 1;
+      for ( integer i = 0; has_roots && i < homotopy.numRealRoots(); ++i ) {
+        homotopy.realRoot( i, r );
+        rmax = max( rmax, r.lpNorm<Eigen::Infinity>() );
+      }
+      L.fill( -2*rmax );
+      U.fill( 2*rmax );
+    }
+    serial.setBox( L, U );
+    parallel.setBox( L, U );
+    try {
+      serial.solveAll( *P );
+      parallel.solveAll( *P );
+    } catch ( std::exception const & e ) {
+      fmt::print( "skipped: {}\n", e.what() );
+      continue;
+    }
+    ms[0] += serial.elapsedMs();
+    ms[1] += parallel.elapsedMs();
+
+    IntervalSolver const & S = parallel;
+    fmt::print(
+      "box [{:.4},{:.4}] complete = {}\n"
+      "proved = {:<4} undecided = {:<4} boxes = {:<8} steals = {}\n"
+      "serial {:.4} ms, parallel {:.4} ms\n",
+      L.minCoeff(), U.maxCoeff(), S.complete(),
+      S.numSolutions( IntervalSolver::BOX_UNIQUE ),
+      S.numSolutions( IntervalSolver::BOX_UNDECIDED ),
+      S.numBoxes(), S.numSteal(),
+      serial.elapsedMs(), parallel.elapsedMs()
+    );
+
+    if ( !has_roots ) continue;
+
+    // real roots of the homotopy inside the box must be enclosed
+    integer inside = 0, enclosed = 0;
+    for ( integer i = 0; i < homotopy.numRealRoots(); ++i ) {
+      homotopy.realRoot( i, r );
+      if ( (r.array() < L.array()).any() || (r.array() > U.array()).any() ) continue;
+      ++inside;
+      for ( integer k = 0; k < S.numSolutions(); ++k ) {
+        IntervalSolver::solutionBox const & B = S.solution( k );
+        real_type tol = 1e-6*(1+r.norm());
+        if ( (r.array() >= B.lo.array()-tol).all() && (r.array() <= B.hi.array()+tol).all() ) {
+          ++enclosed;
+          break;
+        }
+      }
+    }
+    fmt::print( "homotopy real roots in the box = {}, enclosed = {}\n", inside, enclosed );
+  }
+
+  fmt::print( "\ntotal: serial {:.4} ms, parallel {:.4} ms\n", ms[0], ms[1] );
+  return 0;
+}
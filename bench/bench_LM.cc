@@ -0,0 +1,95 @@
+/*\
+ |
+ |  Sparse Levenberg-Marquardt against damped Newton.
+ |
+ |  Every problem of the catalogue with n <= 100 is solved from all its
+ |  initial points by Newton, LM and LM with geodesic acceleration,
+ |  the number of successes and the total time are reported.
+ |  The second order model (tensor by differences of the jacobian) and
+ |  the normal equations of nonlinearSystemFromLeastSquares are checked
+ |  on the problems with n <= 10.
+ |
+\*/
+
+#include "NLsolverLevenbergMarquardt.hh"
+
+using namespace NLproblem;
+
+int
+main() {
+  initProblems();
+
+  NewtonSolver             newton;
+  LevenbergMarquardtSolver lm;
+  LevenbergMarquardtSolver lm_geo( true );
+  LevenbergMarquardtSolver lm_2nd( false, true );
+
+  newton.setMaxIterations( 1000 );
+  lm.setMaxIterations( 1000 );
+  lm_geo.setMaxIterations( 1000 );
+  lm_2nd.setMaxIterations( 1000 );
+
+  NLsolver * solvers[] = { &newton, &lm, &lm_geo };
+  integer const ns = integer( sizeof(solvers)/sizeof(solvers[0]) );
+
+  integer   num_run = 0;
+  integer   ok[3]   = { 0, 0, 0 };
+  integer   nF[3]   = { 0, 0, 0 };
+  real_type ms[3]   = { 0, 0, 0 };
+
+  for ( auto const & P : theProblems ) {
+    integer n = P->numEqns();
+    if ( n > 100 ) continue;
+    for ( integer ig = 0; ig < P->numInitialPoint(); ++ig ) {
+      ++num_run;
+      for ( integer is = 0; is < ns; ++is ) {
+        NLsolver * S = solvers[is];
+        dvec_t x(n);
+        P->getInitialPoint( x, ig );
+        try {
+          if ( S->solve( *P, x ) ) ++ok[is];
+          nF[is] += S->numF();
+          ms[is] += S->elapsedMs();
+        } catch ( std::exception const & ) {
+          // counted as a failure
+        }
+      }
+    }
+  }
+
+  fmt::print( "\n{} runs (problems with n <= 100, all initial points)\n", num_run );
+  for ( integer is = 0; is < ns; ++is )
+    fmt::print(
+      "{:<12} solved = {:<5} #F = {:<8} [{:.4} ms]\n",
+      solvers[is]->name(), ok[is], nF[is], ms[is]
+    );
+
+  fmt::print( "\nSecond order model and normal equations, n <= 10\n" );
+  integer ok_2nd = 0, ok_ne = 0, num_small = 0;
+  for ( auto const & P : theProblems ) {
+    integer n = P->numEqns();
+    if ( n > 10 ) continue;
+    nonlinearLeastSquaresFromSystem LS( P );
+    nonlinearSystemFromLeastSquares NE( &LS );
+    for ( integer ig = 0; ig < P->numInitialPoint(); ++ig ) {
+      ++num_small;
+      dvec_t x(n);
+      try {
+        P->getInitialPoint( x, ig );
+        if ( lm_2nd.solve( *P, x ) ) ++ok_2nd;
+        // a root of F is a root of J^T F
+        P->getInitialPoint( x, ig );
+        if ( newton.solve( NE, x ) ) {
+          dvec_t f(n);
+          P->evalF( x, f );
+          if ( f.lpNorm<Eigen::Infinity>() <= 1e-8 ) ++ok_ne;
+        }
+      } catch ( std::exception const & ) {
+      }
+    }
+  }
+  fmt::print( "{} runs\n", num_small );
+  fmt::print( "{:<12} solved = {}\n", lm_2nd.name(), ok_2nd );
+  fmt::print( "{:<12} solved = {}\n", "Newton(J^TF)", ok_ne );
+  return 0;
+}
@@ -0,0 +1,83 @@
+/*\
+ |
+ |  Multi-start on the problems of the catalogue.
+ |
+ |  For each problem Newton is run from the initial points only, then
+ |  the multi-start driver is run by one worker and by the pool: the
+ |  distinct roots, the local solves and their success rate are
+ |  compared.
+ |
+\*/
+
+#include "NLsolverMultiStart.hh"
+
+using namespace NLproblem;
+
+int
+main() {
+  initProblems();
+
+  NewtonSolver     newton;
+  MultiStartSolver serial(1);
+  MultiStartSolver parallel;
+
+  fmt::print( "threads = {}\n", parallel.numThreads() );
+
+  real_type ms[2]   = { 0, 0 };
+  integer   n_prob  = 0, n_newton = 0, n_multi = 0, more = 0;
+  integer   n_start = 0, n_success = 0;
+  for ( auto const & P : theProblems ) {
+    integer n = P->numEqns();
+    if ( n > 20 ) continue;
+
+    // Newton from the initial points
+    vector<dvec_t> roots;
+    dvec_t x(n);
+    try {
+      for ( integer i = 0; i < P->numInitialPoint(); ++i ) {
+        P->getInitialPoint( x, i );
+        if ( !newton.solve( *P, x ) ) continue;
+        bool is_new = true;
+        for ( auto const & r : roots )
+          if ( (r-x).norm() <= 1e-6*(1+x.norm()) ) { is_new = false; break; }
+        if ( is_new ) roots.push_back( x );
+      }
+    } catch ( ... ) {
+    }
+
+    try {
+      serial.solveAll( *P );
+      parallel.solveAll( *P );
+    } catch ( std::exception const & e ) {
+      fmt::print( "{:<50} skipped: {}\n", P->title(), e.what() );
+      continue;
+    }
+    ms[0] += serial.elapsedMs();
+    ms[1] += parallel.elapsedMs();
+
+    MultiStartSolver const & M = parallel;
+    ++n_prob;
+    if ( !roots.empty() ) ++n_newton;
+    if ( M.converged() )  ++n_multi;
+    if ( M.numRoots() > integer(roots.size()) ) ++more;
+    n_start   += M.numStarts();
+    n_success += M.numSuccess();
+
+    fmt::print(
+      "{:<50} newton = {:<3} roots = {:<3} starts = {:<4} success = {:5.1f}% "
+      "serial {:.4} ms, parallel {:.4} ms\n",
+      P->title(), roots.size(), M.numRoots(), M.numStarts(),
+      100*M.successRate(), serial.elapsedMs(), parallel.elapsedMs()
+    );
+  }
+
+  fmt::print(
+    "\nproblems = {}, solved by newton = {}, solved by multi-start = {}, "
+    "more roots than newton = {}\n"
+    "local solves = {}, success rate = {:.1f}%\n"
+    "total: serial {:.4} ms, parallel {:.4} ms\n",
+    n_prob, n_newton, n_multi, more, n_start,
+    n_start > 0 ? 100.0*n_success/n_start : 0.0, ms[0], ms[1]
+  );
+  return 0;
+}
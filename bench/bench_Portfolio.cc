@@ -0,0 +1,103 @@
+/*\
+ |
+ |  Portfolio racing on the problems of the catalogue.
+ |
+ |  Newton, Broyden, Schubert, Levenberg-Marquardt and tensor Newton race
+ |  from each initial point. The serial race is run twice: the second
+ |  pass starts each problem with the solver that won it in the first
+ |  pass. The wins of each solver are reported with the race on the pool.
+ |
+\*/
+
+#include "NLsolverPortfolio.hh"
+#include "NLsolverBroyden.hh"
+#include "NLsolverSchubert.hh"
+#include "NLsolverLevenbergMarquardt.hh"
+#include "NLsolverTensor.hh"
+
+#include <sstream>
+
+using namespace NLproblem;
+
+static
+void
+fill( PortfolioSolver & R ) {
+  R.addSolver( new NewtonSolver() );
+  R.addSolver( new BroydenSolver() );
+  R.addSolver( new SchubertSolver() );
+  R.addSolver( new LevenbergMarquardtSolver() );
+  R.addSolver( new TensorNewtonSolver() );
+}
+
+int
+main() {
+  initProblems();
+
+  PortfolioSolver serial(1);
+  PortfolioSolver parallel;
+  fill( serial );
+  fill( parallel );
+
+  fmt::print( "threads = {}\n", parallel.numThreads() );
+
+  integer   solved[3]  = { 0, 0, 0 };
+  integer   started[3] = { 0, 0, 0 };
+  real_type ms[3]      = { 0, 0, 0 };
+  integer   runs       = 0;
+  for ( integer pass = 0; pass < 2; ++pass ) {
+    for ( auto const & P : theProblems ) {
+      integer n = P->numEqns();
+      if ( n > 100 ) continue;
+      dvec_t x0(n), x(n);
+      for ( integer ip = 0; ip < P->numInitialPoint(); ++ip ) {
+        P->getInitialPoint( x0, ip );
+        x = x0;
+        serial.solve( *P, x );
+        if ( serial.converged() ) ++solved[pass];
+        started[pass] += serial.numStarted();
+        ms[pass]      += serial.elapsedMs();
+        if ( pass > 0 ) continue;
+        ++runs;
+        x = x0;
+        parallel.solve( *P, x );
+        if ( parallel.converged() ) ++solved[2];
+        started[2] += parallel.numStarted();
+        ms[2]      += parallel.elapsedMs();
+        fmt::print(
+          "{:<55} #{} winner = {:<18} started = {} iter = {:<5} {:.4} ms\n",
+          P->title(), ip, parallel.winnerLabel(), parallel.numStarted(),
+          parallel.numIter(), parallel.elapsedMs()
+        );
+      }
+    }
+  }
+
+  // wins of each solver on the pool
+  std::map<string,integer> wins;
+  for ( auto const & p : parallel.history() )
+    for ( auto const & w : p.second ) wins[w.first] += w.second;
+  fmt::print( "\nwins on {} races:\n", runs );
+  for ( auto const & w : wins ) fmt::print( "  {:<20} {}\n", w.first, w.second );
+
+  // the history survives a save/load round trip
+  std::ostringstream out;
+  serial.saveHistory( out );
+  PortfolioSolver reload(1);
+  fill( reload );
+  std::istringstream in( out.str() );
+  reload.loadHistory( in );
+  UTILS_ASSERT0(
+    reload.history() == serial.history(),
+    "bench_Portfolio, history changed by save/load"
+  );
+
+  fmt::print(
+    "\nserial, first pass:   solved = {:<4} started = {:<5} {:.4} ms\n"
+    "serial, with history: solved = {:<4} started = {:<5} {:.4} ms\n"
+    "pool:                 solved = {:<4} started = {:<5} {:.4} ms\n",
+    solved[0], started[0], ms[0],
+    solved[1], started[1], ms[1],
+    solved[2], started[2], ms[2]
+  );
+  return 0;
+}
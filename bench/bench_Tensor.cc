@@ -0,0 +1,67 @@
+/*\
+ |
+ |  Tensor Newton against plain Newton on the problems with a singular
+ |  jacobian at the root (singular systems, singular function, zero
+ |  jacobian function, Powell badly scaled and Powell singular).
+ |
+\*/
+
+#include "NLsolverTensor.hh"
+
+using namespace NLproblem;
+
+int
+main() {
+  initProblems();
+
+  char const * families[] = {
+    "Singular", "Zero Jacobian", "Powell badly scaled", "Powell singular"
+  };
+
+  NewtonSolver       newton;
+  TensorNewtonSolver tensor;
+  newton.setMaxIterations( 1000 );
+  tensor.setMaxIterations( 1000 );
+
+  integer   iter[2] = { 0, 0 };
+  integer   conv[2] = { 0, 0 };
+  real_type ms[2]   = { 0, 0 };
+  for ( auto const & P : theProblems ) {
+    bool found = false;
+    for ( char const * f : families ) found = found || P->title().find(f) != string::npos;
+    if ( !found ) continue;
+
+    integer n = P->numEqns();
+    dvec_t  x0(n), x(n);
+    for ( integer ip = 0; ip < P->numInitialPoint(); ++ip ) {
+      P->getInitialPoint( x0, ip );
+      NLsolver * S[2] = { &newton, &tensor };
+      for ( integer k = 0; k < 2; ++k ) {
+        x = x0;
+        try {
+          S[k]->solve( *P, x );
+        } catch ( std::exception const & e ) {
+          fmt::print( "{} failed: {}\n", S[k]->name(), e.what() );
+        }
+        if ( S[k]->converged() ) ++conv[k];
+        iter[k] += S[k]->numIter();
+        ms[k]   += S[k]->elapsedMs();
+      }
+      fmt::print(
+        "{:<55} #{} Newton {:<4} iter = {:<5} {:>9.3} ms  "
+        "Tensor {:<4} iter = {:<5} {:>9.3} ms  tensor steps = {:<4} rank deficient = {}\n",
+        P->title(), ip,
+        newton.converged() ? "OK" : "FAIL", newton.numIter(), newton.elapsedMs(),
+        tensor.converged() ? "OK" : "FAIL", tensor.numIter(), tensor.elapsedMs(),
+        tensor.numTensorStep(), tensor.numRankDeficient()
+      );
+    }
+  }
+
+  fmt::print(
+    "\nNewton: converged = {}, iter = {}, {:.4} ms\n"
+    "Tensor: converged = {}, iter = {}, {:.4} ms\n",
+    conv[0], iter[0], ms[0], conv[1], iter[1], ms[1]
+  );
+  return 0;
+}
@@ -0,0 +1,111 @@
+/*\
+ |
+ |  Allocation counters of the benchmark executables.
+ |
+ |  With glibc malloc, calloc, realloc and free are interposed (Eigen
+ |  allocates with malloc) and the live and peak allocated bytes are
+ |  tracked by the usable size of the blocks; elsewhere only the global
+ |  operator new is counted and the live bytes are not available.
+ |  Include in one translation unit of the executable.
+ |
+\*/
+
+#ifndef BENCH_MEMORY_HH
+#define BENCH_MEMORY_HH
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<long long> num_alloc(0);
+static std::atomic<long long> num_alloc_bytes(0);
+static std::atomic<long long> live_bytes(0);
+static std::atomic<long long> peak_bytes(0);
+
+#ifdef __GLIBC__
+
+#include <malloc.h>
+
+extern "C" {
+
+  void * __libc_malloc( size_t );
+  void * __libc_calloc( size_t, size_t );
+  void * __libc_realloc( void *, size_t );
+  void   __libc_free( void * );
+
+}
+
+static
+inline
+void
+countAlloc( void * p, size_t sz ) {
+  ++num_alloc;
+  num_alloc_bytes += static_cast<long long>(sz);
+  if ( p == nullptr ) return;
+  long long live = ( live_bytes += static_cast<long long>( malloc_usable_size( p ) ) );
+  long long peak = peak_bytes;
+  while ( live > peak && !peak_bytes.compare_exchange_weak( peak, live ) ) {}
+}
+
+extern "C" {
+
+  void *
+  malloc( size_t sz ) {
+    void * p = __libc_malloc( sz );
+    countAlloc( p, sz );
+    return p;
+  }
+
+  void *
+  calloc( size_t nm, size_t sz ) {
+    void * p = __libc_calloc( nm, sz );
+    countAlloc( p, nm*sz );
+    return p;
+  }
+
+  void *
+  realloc( void * p, size_t sz ) {
+    size_t old = p != nullptr ? malloc_usable_size( p ) : 0;
+    void * q = __libc_realloc( p, sz );
+    // when it fails `p` is still allocated, `sz == 0` frees it
+    if ( q != nullptr || sz == 0 ) live_bytes -= static_cast<long long>( old );
+    countAlloc( q, sz );
+    return q;
+  }
+
+  void
+  free( void * p ) {
+    if ( p != nullptr ) live_bytes -= static_cast<long long>( malloc_usable_size( p ) );
+    __libc_free( p );
+  }
+
+}
+
+static inline bool hasLiveBytes() { return true; }
+
+#else
+
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void *
+operator new( size_t sz ) {
+  ++num_alloc;
+  num_alloc_bytes += static_cast<long long>(sz);
+  void * p = std::malloc( sz == 0 ? 1 : sz );
+  if ( p == nullptr ) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete( void * p ) noexcept { std::free( p ); }
+void operator delete( void * p, size_t ) noexcept { std::free( p ); }
+
+static inline bool hasLiveBytes() { return false; }
+
+#endif
+
+//! restart the peak from the bytes allocated now
+static inline void resetPeakBytes() { peak_bytes = live_bytes.load(); }
+
+#endif
@@ -0,0 +1,266 @@
+#include "NLbatchRunner.hh"
+#include <algorithm>
+
+namespace NLproblem {
+
+  BatchRunner::BatchRunner( unsigned nthreads )
+  : m_pool( max( unsigned(1), nthreads ) )
+  , m_solvers( m_pool.size() )
+  , m_queues( m_pool.size() )
+  , m_max_size( numeric_limits<integer>::max() )
+  , m_time_budget_ms(0)
+  , m_max_num_F( numeric_limits<integer>::max() )
+  , m_tolerance(0)
+  , m_max_iter(0)
+  , m_verbose(false)
+  , m_records(nullptr)
+  , m_num_done(0)
+  , m_num_converged(0)
+  , m_num_steal(0)
+  , m_num_jobs(0)
+  , m_num_skipped(0)
+  , m_elapsed_ms(0)
+  {}
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BatchRunner::addSolver( string const & label, factory_t const & f ) {
+    for ( auto const & l : m_labels )
+      UTILS_ASSERT( l != label, "BatchRunner::addSolver, label `{}` already used", label );
+    UTILS_ASSERT0(
+      label.find('\t') == string::npos,
+      "BatchRunner::addSolver, tab in the label"
+    );
+    m_labels.push_back( label );
+    m_factories.push_back( f );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BatchRunner::setRecordWriter( asyncRecordWriter * W ) {
+    UTILS_ASSERT(
+      W == nullptr || W->numSlots() >= m_pool.size(),
+      "BatchRunner::setRecordWriter, {} slots for {} threads",
+      W == nullptr ? 0 : W->numSlots(), m_pool.size()
+    );
+    m_records = W;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  string
+  BatchRunner::key( integer problem, integer guess, string const & solver ) {
+    // the titles of the catalogue are not unique, the index is part of the key
+    return fmt::format(
+      "{}\t{}\t{}\t{}", problem, theProblems[size_t(problem)]->title(), guess, solver
+    );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BatchRunner::readDone( string const & fname, std::map<string,bool> & done ) const {
+    std::ifstream file( fname.c_str() );
+    string line;
+    while ( std::getline( file, line ) ) {
+      if ( line.empty() || line[0] == '#' ) continue;
+      // a complete record has 10 fields, a crash may truncate the last one
+      size_t ntab = size_t( std::count( line.begin(), line.end(), '\t' ) );
+      if ( ntab != 9 ) continue;
+      size_t pos = 0;
+      for ( integer k = 0; k < 4; ++k ) pos = line.find( '\t', pos+1 );
+      done[line.substr(0,pos)] = true;
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  BatchRunner::popJob( unsigned iw, job & J ) {
+    {
+      jobQueue & Q = m_queues[iw];
+      std::lock_guard<std::mutex> lock( Q.mtx );
+      if ( !Q.jobs.empty() ) {
+        J = Q.jobs.front();
+        Q.jobs.pop_front();
+        return true;
+      }
+    }
+    // steal the most expensive job of the other queues
+    unsigned nq = unsigned(m_queues.size());
+    for ( unsigned k = 1; k < nq; ++k ) {
+      jobQueue & Q = m_queues[(iw+k)%nq];
+      std::lock_guard<std::mutex> lock( Q.mtx );
+      if ( !Q.jobs.empty() ) {
+        J = Q.jobs.front();
+        Q.jobs.pop_front();
+        ++m_num_steal;
+        NL_TRACE_INSTANT( "steal", integer((iw+k)%nq) );
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BatchRunner::runJob( unsigned iw, job const & J ) {
+    nonlinearSystem const & P = *theProblems[size_t(J.problem)];
+    NLsolver              & S = *m_solvers[iw][size_t(J.solver)];
+
+    NL_TRACE_SCOPE( "job", J.problem );
+    dvec_t x( P.numEqns() );
+    char const * status;
+    bool         solved    = false; // the statistics of S are of this job
+    bool         converged = false;
+    try {
+      P.getInitialPoint( x, J.guess );
+      S.solve( P, x );
+      solved    = true;
+      converged = S.converged();
+      if      ( converged )   status = "OK";
+      else if ( S.stopped() ) status = "STOP";
+      else                    status = "FAIL";
+    }
+    catch ( ... ) {
+      status = "ERROR";
+    }
+    if ( converged ) ++m_num_converged;
+    ++m_num_done;
+    if ( solved && m_records != nullptr )
+      m_records->append( iw, J.problem, J.guess, J.solver, RECORD_SOLUTION, x );
+
+    // after an exception S still holds the counters of its previous job
+    string line = solved ?
+      fmt::format(
+        "{}\t{}\t{}\t{}\t{}\t{:.6}\t{:.4}\n",
+        key( J.problem, J.guess, m_labels[size_t(J.solver)] ),
+        status, S.numIter(), S.numF(), S.numJ(), S.normF(), S.elapsedMs()
+      ) :
+      fmt::format(
+        "{}\t{}\t0\t0\t0\tnan\tnan\n",
+        key( J.problem, J.guess, m_labels[size_t(J.solver)] ), status
+      );
+    std::lock_guard<std::mutex> lock( m_out_mtx );
+    m_out << line << std::flush;
+    if ( m_verbose ) fmt::print( "{}", line );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BatchRunner::run( string const & fname ) {
+    UTILS_ASSERT0( !m_factories.empty(), "BatchRunner::run, no solvers" );
+    Utils::TicToc tictoc;
+    tictoc.tic();
+    m_num_done      = 0;
+    m_num_converged = 0;
+    m_num_steal     = 0;
+    m_num_jobs      = 0;
+    m_num_skipped   = 0;
+
+    // jobs already done by a previous run
+    std::map<string,bool> done;
+    bool fresh = true;
+    bool eol   = true;
+    {
+      std::ifstream file( fname.c_str(), std::ios::binary );
+      if ( file.good() ) {
+        file.seekg( 0, std::ios::end );
+        fresh = file.tellg() <= 0;
+        if ( !fresh ) {
+          file.seekg( -1, std::ios::end );
+          eol = file.get() == '\n';
+        }
+      }
+    }
+    if ( !fresh ) readDone( fname, done );
+
+    // solvers of each worker
+    for ( auto & SW : m_solvers ) {
+      SW.clear();
+      for ( auto const & f : m_factories ) {
+        SW.push_back( std::unique_ptr<NLsolver>( f() ) );
+        NLsolver & S = *SW.back();
+        if ( m_tolerance > 0 ) S.setTolerance( m_tolerance );
+        if ( m_max_iter  > 0 ) S.setMaxIterations( m_max_iter );
+        S.setTimeBudget( m_time_budget_ms );
+        S.setMaxEvaluations( m_max_num_F );
+      }
+    }
+
+    // enumerate and sort the jobs
+    vector<job> jobs;
+    integer const np = integer(theProblems.size());
+    integer const ns = integer(m_labels.size());
+    for ( integer ip = 0; ip < np; ++ip ) {
+      nonlinearSystem const & P = *theProblems[size_t(ip)];
+      integer n = P.numEqns();
+      if ( n > m_max_size ) continue;
+      if ( !m_filter.empty() && P.title().find( m_filter ) == string::npos ) continue;
+      real_type cost = real_type( n + P.jacobianNnz() ) * std::log2( real_type(2+n) );
+      for ( integer ig = 0; ig < P.numInitialPoint(); ++ig ) {
+        for ( integer is = 0; is < ns; ++is ) {
+          if ( done.count( key( ip, ig, m_labels[size_t(is)] ) ) > 0 ) {
+            ++m_num_skipped;
+            continue;
+          }
+          job J;
+          J.problem = ip;
+          J.guess   = ig;
+          J.solver  = is;
+          J.cost    = cost;
+          jobs.push_back( J );
+        }
+      }
+    }
+    m_num_jobs = integer(jobs.size());
+    std::stable_sort(
+      jobs.begin(), jobs.end(),
+      []( job const & a, job const & b ) -> bool { return a.cost > b.cost; }
+    );
+
+    // deal the jobs in turn, the most expensive at the front of each queue
+    vector<job> serial;
+    unsigned const nq = m_pool.size();
+    unsigned       iq = 0;
+    for ( auto & Q : m_queues ) Q.jobs.clear();
+    for ( auto const & J : jobs ) {
+      if ( theProblems[size_t(J.problem)]->isThreadSafe() ) {
+        m_queues[iq].jobs.push_back( J );
+        iq = (iq+1) % nq;
+      } else {
+        serial.push_back( J );
+      }
+    }
+
+    m_out.open( fname.c_str(), std::ios::out | std::ios::app );
+    UTILS_ASSERT( m_out.good(), "BatchRunner::run, cannot open `{}`", fname );
+    if ( fresh ) m_out << "# problem\ttitle\tguess\tsolver\tstatus\titer\t#F\t#J\t||F||\tms\n";
+    else if ( !eol ) m_out << '\n';
+    m_out.flush();
+
+    auto worker = [this]( unsigned iw ) -> void {
+      NL_TRACE_THREAD_NAME( fmt::format( "worker {}", iw ) );
+      job J;
+      while ( popJob( iw, J ) ) runJob( iw, J );
+    };
+    if ( nq == 1 ) {
+      worker( 0 );
+    } else {
+      for ( unsigned iw = 0; iw < nq; ++iw ) m_pool.run( iw, worker, iw );
+      m_pool.wait_all();
+    }
+    for ( auto const & J : serial ) runJob( 0, J );
+
+    m_out.close();
+    if ( m_records != nullptr ) m_records->flush();
+
+    tictoc.toc();
+    m_elapsed_ms = tictoc.elapsed_ms();
+  }
+
+}
@@ -0,0 +1,164 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+#ifndef NL_BATCH_RUNNER_HH
+#define NL_BATCH_RUNNER_HH
+
+#include "NLsolver.hh"
+#include "NLrecordFile.hh"
+
+#include <atomic>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace NLproblem {
+
+  /*\
+   |   ____        _       _     ____
+   |  | __ )  __ _| |_ ___| |__ |  _ \ _   _ _ __  _ __   ___ _ __
+   |  |  _ \ / _` | __/ __| '_ \| |_) | | | | '_ \| '_ \ / _ \ '__|
+   |  | |_) | (_| | || (__| | | |  _ <| |_| | | | | | | |  __/ |
+   |  |____/ \__,_|\__\___|_| |_|_| \_\\__,_|_| |_|_| |_|\___|_|
+  \*/
+
+  //!
+  //! Run every solver from every initial point of every problem of the
+  //! catalogue (`theProblems`).
+  //!
+  //! The jobs (problem, initial point, solver) are sorted by a rough
+  //! estimate of their cost, \f$ (n+nnz)\log_2(2+n) \f$, and dealt in
+  //! turn to the queues of the workers of a pool. A worker takes the
+  //! most expensive job of its queue and when it is empty steals the
+  //! most expensive job of the others, so the long jobs start first and
+  //! the short ones fill the gaps at the end. Each worker owns an
+  //! instance of each solver; each run is limited by the budgets of
+  //! wall time and residual evaluations (see `NLsolver::setTimeBudget`
+  //! and `NLsolver::setMaxEvaluations`). The jobs of the problems that
+  //! are not `isThreadSafe` run serially after the others.
+  //!
+  //! The result of each job is appended to the output file as soon as
+  //! the job ends, one line of tab separated fields
+  //!
+  //!     problem  title  guess  solver  status  iter  #F  #J  ||F||  ms
+  //!
+  //! where `problem` is the index in `theProblems` (the titles are not
+  //! unique) and the status is `OK`, `FAIL`, `STOP` (out of budget) or
+  //! `ERROR` (exception, the counters are 0 and `||F||`, `ms` are nan,
+  //! no solution is recorded). When the file exists the jobs already
+  //! recorded are skipped, so a crashed run is resumed by running it
+  //! again.
+  //!
+  class BatchRunner {
+  public:
+
+    typedef std::function<NLsolver*()> factory_t;
+
+  private:
+
+    BatchRunner( BatchRunner const & );
+    BatchRunner const & operator = ( BatchRunner const & );
+
+    struct job {
+      integer   problem;
+      integer   guess;
+      integer   solver;
+      real_type cost;
+    };
+
+    struct jobQueue {
+      std::mutex      mtx;
+      std::deque<job> jobs;
+    };
+
+    Utils::ThreadPool m_pool;
+
+    vector<string>    m_labels;
+    vector<factory_t> m_factories;
+
+    // solvers of each worker
+    vector<vector<std::unique_ptr<NLsolver> > > m_solvers;
+
+    vector<jobQueue> m_queues;
+
+    // parameters
+    integer   m_max_size;
+    string    m_filter;
+    real_type m_time_budget_ms;
+    integer   m_max_num_F;
+    real_type m_tolerance;
+    integer   m_max_iter;
+    bool      m_verbose;
+
+    std::ofstream m_out;
+    std::mutex    m_out_mtx;
+
+    asyncRecordWriter * m_records;
+
+    std::atomic<integer> m_num_done;
+    std::atomic<integer> m_num_converged;
+    std::atomic<integer> m_num_steal;
+    integer              m_num_jobs;
+    integer              m_num_skipped;
+    real_type            m_elapsed_ms;
+
+    static string key( integer problem, integer guess, string const & solver );
+
+    void readDone( string const & fname, std::map<string,bool> & done ) const;
+    bool popJob( unsigned iw, job & J );
+    void runJob( unsigned iw, job const & J );
+
+  public:
+
+    explicit
+    BatchRunner( unsigned nthreads = max( unsigned(1), unsigned(std::thread::hardware_concurrency()) ) );
+
+    ~BatchRunner() {}
+
+    //! add a solver, `f` builds an instance for each worker
+    void addSolver( string const & label, factory_t const & f );
+
+    //! skip the problems with more than `n` equations
+    void setMaxSize( integer n ) { m_max_size = n; }
+
+    //! run only the problems with `filter` in the title
+    void setFilter( string const & filter ) { m_filter = filter; }
+
+    void setTimeBudget( real_type ms )    { m_time_budget_ms = ms; }
+    void setMaxEvaluations( integer mfe ) { m_max_num_F = mfe; }
+    void setTolerance( real_type tol )    { m_tolerance = tol; }
+    void setMaxIterations( integer mit )  { m_max_iter = mit; }
+    void setVerbose( bool yes )           { m_verbose = yes; }
+
+    //!
+    //! Append the final point of each run to `W` (`RECORD_SOLUTION`,
+    //! the solver is the index of its label), `W` must have a slot for
+    //! each thread; `nullptr` to stop recording.
+    //!
+    void setRecordWriter( asyncRecordWriter * W );
+
+    //! run the jobs not yet recorded in `fname`, appending the results
+    void run( string const & fname );
+
+    integer   numJobs()       const { return m_num_jobs; }
+    integer   numSkipped()    const { return m_num_skipped; }
+    integer   numDone()       const { return m_num_done; }
+    integer   numConverged()  const { return m_num_converged; }
+    integer   numSteal()      const { return m_num_steal; }
+    unsigned  numThreads()    const { return m_pool.size(); }
+    real_type elapsedMs()     const { return m_elapsed_ms; }
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,322 @@
+#include "NLbundle.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <random>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace NLproblem {
+
+  static
+  uint64_t
+  align8( uint64_t off )
+  { return ( off + 7 ) & ~uint64_t(7); }
+
+  //!
+  //! Sorted CSR pattern of the jacobian of `P` with the duplicated
+  //! entries merged, `slot(k)` is the CSR position of the k-th value
+  //! returned by `jacobian`.
+  //!
+  static
+  void
+  csrPattern(
+    nonlinearSystem const & P,
+    ivec_t                & slot,
+    vector<int32_t>       & row,
+    vector<int32_t>       & col
+  ) {
+    integer const n  = P.numEqns();
+    integer const nj = P.jacobianNnz();
+    ivec_t I( nj ), J( nj );
+    P.jacobianPattern( I, J );
+
+    vector<integer> order( static_cast<size_t>(nj) );
+    std::iota( order.begin(), order.end(), 0 );
+    std::stable_sort(
+      order.begin(), order.end(),
+      [&I,&J]( integer a, integer b ) { return I(a) < I(b) || ( I(a) == I(b) && J(a) < J(b) ); }
+    );
+
+    slot.resize( nj );
+    row.assign( size_t(n+1), 0 );
+    col.clear();
+    col.reserve( size_t(nj) );
+    integer i_last = -1, j_last = -1;
+    for ( integer k : order ) {
+      UTILS_ASSERT(
+        I(k) >= 0 && I(k) < n && J(k) >= 0 && J(k) < n,
+        "csrPattern, `{}` bad pattern (i,j) = ({},{}) at k = {}", P.title(), I(k), J(k), k
+      );
+      if ( I(k) != i_last || J(k) != j_last ) {
+        col.push_back( J(k) );
+        ++row[size_t(I(k)+1)];
+        i_last = I(k);
+        j_last = J(k);
+      }
+      slot(k) = integer(col.size()) - 1;
+    }
+    for ( integer i = 0; i < n; ++i ) row[size_t(i+1)] += row[size_t(i)];
+  }
+
+  // write `bytes` at `off`, padding with zeros from the current position
+  static
+  void
+  putAt( std::ofstream & file, uint64_t & pos, uint64_t off, void const * data, size_t bytes ) {
+    static char const zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    UTILS_ASSERT( off >= pos && off-pos <= 8, "exportBundle, bad offset {} at {}", off, pos );
+    file.write( zeros, std::streamsize(off-pos) );
+    file.write( static_cast<char const *>(data), std::streamsize(bytes) );
+    pos = off + bytes;
+  }
+
+  /*\
+   |  exportBundle
+  \*/
+
+  integer
+  exportBundle(
+    nonlinearSystem const & P,
+    string          const & fname,
+    integer                 num_samples,
+    integer                 problem,
+    integer                 seed
+  ) {
+    integer const n  = P.numEqns();
+    integer const nj = P.jacobianNnz();
+    integer const ni = P.numInitialPoint();
+    integer const ne = P.numExactSolution();
+
+    ivec_t          slot;
+    vector<int32_t> row, col;
+    csrPattern( P, slot, row, col );
+    integer const nnz = integer(col.size());
+
+    dvec_t L( n ), U( n ), x( n ), x0( n ), f( n ), jac( nj ), jv( nnz );
+    P.boundingBox( L, U );
+
+    vector<real_type> init( size_t(ni)*size_t(n) ), exact( size_t(ne)*size_t(n) );
+    for ( integer k = 0; k < ni; ++k ) {
+      P.getInitialPoint( x, k );
+      std::copy_n( x.data(), n, &init[size_t(k)*size_t(n)] );
+    }
+    for ( integer k = 0; k < ne; ++k ) {
+      P.getExactSolution( x, k );
+      std::copy_n( x.data(), n, &exact[size_t(k)*size_t(n)] );
+    }
+
+    // samples: the initial points, then random points around them
+    vector<real_type> samples;
+    integer ns = 0;
+    auto addSample = [&]() -> bool {
+      integer which;
+      if ( P.isAdmissible( x, which ) != POINT_ADMISSIBLE ) return false;
+      try {
+        if ( P.safeEvalF( x, f ) >= 0 || P.safeJacobian( x, jac ) >= 0 ) return false;
+      } catch ( ... ) {
+        return false;
+      }
+      jv.setZero();
+      for ( integer k = 0; k < nj; ++k ) jv(slot(k)) += jac(k);
+      samples.insert( samples.end(), x.data(),  x.data()+n );
+      samples.insert( samples.end(), f.data(),  f.data()+n );
+      samples.insert( samples.end(), jv.data(), jv.data()+nnz );
+      return true;
+    };
+    for ( integer k = 0; k < ni && ns < num_samples; ++k ) {
+      P.getInitialPoint( x, k );
+      if ( addSample() ) ++ns;
+    }
+    std::mt19937 gen( static_cast<unsigned>(seed) );
+    std::uniform_real_distribution<real_type> unif( -1, 1 );
+    for ( integer tries = 0; ni > 0 && ns < num_samples && tries < 100*num_samples; ++tries ) {
+      P.getInitialPoint( x0, tries % ni );
+      for ( integer i = 0; i < n; ++i ) x(i) = x0(i) + 0.1*(1+std::abs(x0(i)))*unif( gen );
+      P.projectToDomain( x );
+      if ( addSample() ) ++ns;
+    }
+
+    // layout
+    string const & title = P.title();
+    nl_bundle_header h;
+    std::memset( &h, 0, sizeof(h) );
+    std::memcpy( h.magic, NL_BUNDLE_MAGIC, sizeof(h.magic) );
+    h.endian      = NL_BUNDLE_ENDIAN;
+    h.problem     = problem;
+    h.n           = n;
+    h.nnz         = nnz;
+    h.num_init    = ni;
+    h.num_exact   = ne;
+    h.num_samples = ns;
+    h.title_len   = int32_t(title.size());
+
+    uint64_t off = sizeof(h);
+    h.off_title   = off; off = align8( off + title.size() + 1 );
+    h.off_lower   = off; off += n*sizeof(real_type);
+    h.off_upper   = off; off += n*sizeof(real_type);
+    h.off_init    = off; off += init.size()*sizeof(real_type);
+    h.off_exact   = off; off += exact.size()*sizeof(real_type);
+    h.off_row     = off; off = align8( off + row.size()*sizeof(int32_t) );
+    h.off_col     = off; off = align8( off + col.size()*sizeof(int32_t) );
+    h.off_samples = off; off += samples.size()*sizeof(real_type);
+    h.file_size   = off;
+
+    std::ofstream file( fname.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+    UTILS_ASSERT( file.good(), "exportBundle, cannot open `{}`", fname );
+    uint64_t pos = 0;
+    putAt( file, pos, 0,             &h,               sizeof(h) );
+    putAt( file, pos, h.off_title,   title.c_str(),    title.size()+1 );
+    putAt( file, pos, h.off_lower,   L.data(),         n*sizeof(real_type) );
+    putAt( file, pos, h.off_upper,   U.data(),         n*sizeof(real_type) );
+    putAt( file, pos, h.off_init,    init.data(),      init.size()*sizeof(real_type) );
+    putAt( file, pos, h.off_exact,   exact.data(),     exact.size()*sizeof(real_type) );
+    putAt( file, pos, h.off_row,     row.data(),       row.size()*sizeof(int32_t) );
+    putAt( file, pos, h.off_col,     col.data(),       col.size()*sizeof(int32_t) );
+    putAt( file, pos, h.off_samples, samples.data(),   samples.size()*sizeof(real_type) );
+    file.close();
+    UTILS_ASSERT( !file.fail(), "exportBundle, write of `{}` failed", fname );
+    return ns;
+  }
+
+  /*\
+   |  bundleReader
+  \*/
+
+  bundleReader::bundleReader( string const & fname )
+  : m_base(nullptr)
+  , m_size(0)
+  {
+#ifdef _WIN32
+    std::ifstream file( fname.c_str(), std::ios::in | std::ios::binary | std::ios::ate );
+    UTILS_ASSERT( file.good(), "bundleReader, cannot open `{}`", fname );
+    m_size = size_t( file.tellg() );
+    m_buffer.resize( ( m_size + 7 ) / 8 );
+    file.seekg( 0 );
+    file.read( reinterpret_cast<char*>( m_buffer.data() ), std::streamsize(m_size) );
+    UTILS_ASSERT( file.good(), "bundleReader, cannot read `{}`", fname );
+    m_base = reinterpret_cast<char const *>( m_buffer.data() );
+#else
+    int fd = ::open( fname.c_str(), O_RDONLY );
+    UTILS_ASSERT( fd >= 0, "bundleReader, cannot open `{}`", fname );
+    struct stat st;
+    bool ok = ::fstat( fd, &st ) == 0 && size_t(st.st_size) >= sizeof(nl_bundle_header);
+    if ( ok ) {
+      m_size = size_t(st.st_size);
+      void * p = ::mmap( nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+      ok = p != MAP_FAILED;
+      if ( ok ) m_base = static_cast<char const *>( p );
+    }
+    ::close( fd );
+    UTILS_ASSERT( ok, "bundleReader, cannot map `{}`", fname );
+#endif
+    try {
+      check();
+    } catch ( ... ) {
+#ifndef _WIN32
+      ::munmap( const_cast<char*>( m_base ), m_size );
+#endif
+      throw;
+    }
+  }
+
+  bundleReader::~bundleReader() {
+#ifndef _WIN32
+    if ( m_base != nullptr ) ::munmap( const_cast<char*>( m_base ), m_size );
+#endif
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  bundleReader::check() const {
+    UTILS_ASSERT0(
+      m_size >= sizeof(nl_bundle_header) &&
+      std::memcmp( H().magic, NL_BUNDLE_MAGIC, sizeof(H().magic) ) == 0,
+      "bundleReader, not a problem bundle"
+    );
+    nl_bundle_header const & h = H();
+    UTILS_ASSERT( h.endian == NL_BUNDLE_ENDIAN, "bundleReader, byte order {:#x}", h.endian );
+    UTILS_ASSERT(
+      h.n > 0 && h.nnz >= 0 && h.num_init >= 0 && h.num_exact >= 0 &&
+      h.num_samples >= 0 && h.title_len >= 0 && h.file_size == m_size,
+      "bundleReader, bad header (n = {}, nnz = {}, size {} of {})",
+      h.n, h.nnz, h.file_size, m_size
+    );
+    uint64_t const n   = uint64_t(h.n);
+    uint64_t const nnz = uint64_t(h.nnz);
+    struct { uint64_t off, bytes; } const sec[] = {
+      { h.off_title,   uint64_t(h.title_len)+1 },
+      { h.off_lower,   n*sizeof(real_type) },
+      { h.off_upper,   n*sizeof(real_type) },
+      { h.off_init,    uint64_t(h.num_init)*n*sizeof(real_type) },
+      { h.off_exact,   uint64_t(h.num_exact)*n*sizeof(real_type) },
+      { h.off_row,     (n+1)*sizeof(int32_t) },
+      { h.off_col,     nnz*sizeof(int32_t) },
+      { h.off_samples, uint64_t(h.num_samples)*(2*n+nnz)*sizeof(real_type) }
+    };
+    for ( auto const & s : sec )
+      UTILS_ASSERT(
+        s.off % 8 == 0 && s.off <= m_size && s.bytes <= m_size - s.off,
+        "bundleReader, section at {} of {} bytes out of the file", s.off, s.bytes
+      );
+    UTILS_ASSERT0( title()[h.title_len] == 0, "bundleReader, title not terminated" );
+    UTILS_ASSERT(
+      rowPtr()(0) == 0 && rowPtr()(h.n) == h.nnz,
+      "bundleReader, row pointers from {} to {}, expected 0 to {}",
+      rowPtr()(0), rowPtr()(h.n), h.nnz
+    );
+  }
+
+  /*\
+   |  validateBundle
+  \*/
+
+  real_type
+  validateBundle(
+    bundleReader    const & B,
+    nonlinearSystem const & P,
+    integer               & num_different
+  ) {
+    integer const n = P.numEqns();
+    ivec_t          slot;
+    vector<int32_t> row, col;
+    csrPattern( P, slot, row, col );
+    integer const nnz = integer(col.size());
+    UTILS_ASSERT(
+      n == B.numEqns() && nnz == B.nnz() &&
+      std::equal( row.begin(), row.end(), B.rowPtr().data() ) &&
+      std::equal( col.begin(), col.end(), B.colIdx().data() ),
+      "validateBundle, `{}` and the bundle of `{}` have different patterns",
+      P.title(), B.title()
+    );
+
+    dvec_t x( n ), f( n ), jac( P.jacobianNnz() ), jv( nnz );
+    real_type max_diff = 0;
+    num_different = 0;
+    for ( integer s = 0; s < B.numSamples(); ++s ) {
+      x = B.sampleX( s );
+      P.evalF( x, f );
+      P.jacobian( x, jac );
+      jv.setZero();
+      for ( integer k = 0; k < jac.size(); ++k ) jv(slot(k)) += jac(k);
+      bundleReader::dmap_t F0 = B.sampleF( s );
+      bundleReader::dmap_t J0 = B.sampleJ( s );
+      if ( std::memcmp( f.data(),  F0.data(), n*sizeof(real_type) ) == 0 &&
+           std::memcmp( jv.data(), J0.data(), nnz*sizeof(real_type) ) == 0 ) continue;
+      ++num_different;
+      for ( integer i = 0; i < n; ++i )
+        max_diff = max( max_diff, std::abs( f(i)-F0(i) )/( 1+std::abs( F0(i) ) ) );
+      for ( integer k = 0; k < nnz; ++k )
+        max_diff = max( max_diff, std::abs( jv(k)-J0(k) )/( 1+std::abs( J0(k) ) ) );
+    }
+    return max_diff;
+  }
+
+}
@@ -0,0 +1,145 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+#ifndef NL_BUNDLE_HH
+#define NL_BUNDLE_HH
+
+#include "testsNonlin.hh"
+#include "NLbundleFormat.h"
+
+#include <cstdint>
+
+namespace NLproblem {
+
+  //!
+  //! Write `P` into the bundle `fname` (layout in NLbundleFormat.h):
+  //! sizes, bounding box, initial points, exact solutions, the sorted
+  //! CSR pattern of the jacobian (duplicated entries summed) and
+  //! `num_samples` tuples (x, F, J) at the initial points and at random
+  //! admissible points around them (`seed`). The points where `F` or
+  //! the jacobian throw or are not finite are not sampled, so the
+  //! bundle can hold fewer samples. `problem` is the index of `P` in
+  //! `theProblems` (-1 if not from the catalogue). Return the number of
+  //! samples written.
+  //!
+  integer
+  exportBundle(
+    nonlinearSystem const & P,
+    string          const & fname,
+    integer                 num_samples,
+    integer                 problem = -1,
+    integer                 seed    = 0
+  );
+
+  /*\
+   |   ____                  _ _
+   |  | __ ) _   _ _ __   __| | | ___
+   |  |  _ \| | | | '_ \ / _` | |/ _ \
+   |  | |_) | |_| | | | | (_| | |  __/
+   |  |____/ \__,_|_| |_|\__,_|_|\___|
+  \*/
+
+  //!
+  //! Zero-copy reader of a bundle: the file is mapped in memory (read
+  //! whole on the platforms without `mmap`) and the accessors point
+  //! into the mapping, opening a bundle costs the page-in of what is
+  //! used. The header is checked (magic, byte order, offsets inside the
+  //! file) when opening.
+  //!
+  class bundleReader {
+
+    bundleReader( bundleReader const & );
+    bundleReader const & operator = ( bundleReader const & );
+
+    char const *       m_base;
+    size_t             m_size;
+    vector<uint64_t>   m_buffer; // without mmap
+
+    nl_bundle_header const & H() const
+    { return *reinterpret_cast<nl_bundle_header const *>( m_base ); }
+
+    template <typename T>
+    T const * at( uint64_t off ) const
+    { return reinterpret_cast<T const *>( m_base + off ); }
+
+    void check() const;
+
+  public:
+
+    typedef Eigen::Map<dvec_t const> dmap_t;
+    typedef Eigen::Map<ivec_t const> imap_t;
+
+    explicit bundleReader( string const & fname );
+    ~bundleReader();
+
+    nl_bundle_header const & header() const { return H(); }
+
+    integer problem()          const { return H().problem; }
+    integer numEqns()          const { return H().n; }
+    integer nnz()              const { return H().nnz; }
+    integer numInitialPoint()  const { return H().num_init; }
+    integer numExactSolution() const { return H().num_exact; }
+    integer numSamples()       const { return H().num_samples; }
+    size_t  fileBytes()        const { return m_size; }
+
+    char const * title() const { return at<char>( H().off_title ); }
+
+    dmap_t lower() const { return dmap_t( at<real_type>( H().off_lower ), H().n ); }
+    dmap_t upper() const { return dmap_t( at<real_type>( H().off_upper ), H().n ); }
+
+    dmap_t
+    initialPoint( integer k ) const
+    { return dmap_t( at<real_type>( H().off_init ) + size_t(k)*size_t(H().n), H().n ); }
+
+    dmap_t
+    exactSolution( integer k ) const
+    { return dmap_t( at<real_type>( H().off_exact ) + size_t(k)*size_t(H().n), H().n ); }
+
+    imap_t rowPtr() const { return imap_t( at<integer>( H().off_row ), H().n+1 ); }
+    imap_t colIdx() const { return imap_t( at<integer>( H().off_col ), H().nnz ); }
+
+    //! x of the sample `k`
+    dmap_t
+    sampleX( integer k ) const
+    { return dmap_t( sample( k ), H().n ); }
+
+    //! F(x) of the sample `k`
+    dmap_t
+    sampleF( integer k ) const
+    { return dmap_t( sample( k ) + H().n, H().n ); }
+
+    //! jacobian values of the sample `k`, in the order of `colIdx`
+    dmap_t
+    sampleJ( integer k ) const
+    { return dmap_t( sample( k ) + 2*H().n, H().nnz ); }
+
+    real_type const *
+    sample( integer k ) const {
+      size_t stride = 2*size_t(H().n) + size_t(H().nnz);
+      return at<real_type>( H().off_samples ) + size_t(k)*stride;
+    }
+  };
+
+  //!
+  //! Evaluate `P` at the samples of `B` and compare with the stored
+  //! values: return the largest difference relative to
+  //! \f$ 1+|v| \f$, `num_different` is the number of samples with some
+  //! value not bitwise equal.
+  //!
+  real_type
+  validateBundle(
+    bundleReader    const & B,
+    nonlinearSystem const & P,
+    integer               & num_different
+  );
+
+}
+
+#endif
@@ -0,0 +1,64 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+/*
+ |  Layout of the problem bundles written by NLproblem::exportBundle,
+ |  plain C so that the external codes can map a bundle and read it in
+ |  place without this library.
+ |
+ |  A bundle is the header below followed by the sections it points to,
+ |  each one at an offset (bytes from the start of the file) multiple of
+ |  8, in native byte order (`endian` is 0x01020304 when written):
+ |
+ |    title    title_len chars, NUL terminated
+ |    lower    n doubles, lower bounds (-DBL_MAX if none)
+ |    upper    n doubles, upper bounds (DBL_MAX if none)
+ |    init     num_init*n doubles, the initial points one after the other
+ |    exact    num_exact*n doubles, the exact solutions
+ |    row      n+1 int32, row pointers of the jacobian (CSR, 0-based)
+ |    col      nnz int32, columns sorted in each row, no duplicates
+ |    samples  num_samples tuples of n+n+nnz doubles: x, F(x) and the
+ |             jacobian values at x in the order of `col`
+ |
+ |  The samples are reference values to validate an implementation of
+ |  the problem: the initial points first, then random admissible points
+ |  around them.
+ */
+
+#ifndef NL_BUNDLE_FORMAT_H
+#define NL_BUNDLE_FORMAT_H
+
+#include <stdint.h>
+
+#define NL_BUNDLE_MAGIC   "NLBNDL\0\1"
+#define NL_BUNDLE_ENDIAN  0x01020304u
+
+typedef struct {
+  char     magic[8];    /* NL_BUNDLE_MAGIC */
+  uint32_t endian;      /* NL_BUNDLE_ENDIAN */
+  int32_t  problem;     /* index in the catalogue, -1 if none */
+  int32_t  n;           /* equations and unknowns */
+  int32_t  nnz;         /* nonzeros of the jacobian */
+  int32_t  num_init;    /* initial points */
+  int32_t  num_exact;   /* exact solutions */
+  int32_t  num_samples; /* reference tuples (x, F, J) */
+  int32_t  title_len;   /* without the NUL */
+  uint64_t off_title;
+  uint64_t off_lower;
+  uint64_t off_upper;
+  uint64_t off_init;
+  uint64_t off_exact;
+  uint64_t off_row;
+  uint64_t off_col;
+  uint64_t off_samples;
+  uint64_t file_size;
+} nl_bundle_header;
+
+#endif
@@ -0,0 +1,340 @@
+#include "NLcontinuation.hh"
+
+namespace NLproblem {
+
+  // relative Newton step under which a corrector that stops decreasing
+  // ||F|| has reached the rounding level of F
+  static real_type const stall_step = 1e-6;
+
+  // position in the compressed storage of A of the entry (i,j)
+  static
+  integer
+  entryPosition( spmat_t const & A, integer i, integer j ) {
+    integer const * outer = A.outerIndexPtr();
+    integer const * inner = A.innerIndexPtr();
+    integer const * p     = std::lower_bound( inner + outer[j], inner + outer[j+1], i );
+    return integer( p - inner );
+  }
+
+  /*\
+   |  ContinuationDriver
+  \*/
+
+  ContinuationDriver::ContinuationDriver()
+  : m_tolerance(1e-10)
+  , m_ds_max(1)
+  , m_ds_min(1e-10)
+  , m_max_corr(8)
+  , m_max_steps(500)
+  , m_log_scale(false)
+  , m_P(nullptr)
+  , m_k(0)
+  , m_n(0)
+  , m_num_steps(0)
+  , m_num_rejected(0)
+  , m_num_newton(0)
+  , m_num_F(0)
+  , m_num_J(0)
+  , m_num_factorize(0)
+  , m_elapsed_ms(0)
+  , m_completed(false)
+  {}
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  ContinuationDriver::setup( nonlinearSystem const & P ) {
+    integer const n   = P.numEqns();
+    integer const nnz = P.jacobianNnz();
+
+    ivec_t I( nnz ), J( nnz );
+    P.jacobianPattern( I, J );
+
+    // pattern of J, its diagonal, the column F_q and the row c^T
+    typedef Eigen::Triplet<real_type,integer> T;
+    vector<T> triplets;
+    triplets.reserve( size_t(nnz+3*n+1) );
+    for ( integer k = 0; k < nnz; ++k ) {
+      UTILS_ASSERT(
+        I(k) >= 0 && I(k) < n && J(k) >= 0 && J(k) < n,
+        "ContinuationDriver::setup, bad pattern (i,j) = ({},{}) at k = {}",
+        I(k), J(k), k
+      );
+      triplets.push_back( T( I(k), J(k), 1 ) );
+    }
+    for ( integer i = 0; i < n; ++i ) {
+      triplets.push_back( T( i, i, 0 ) );
+      triplets.push_back( T( i, n, 1 ) );
+      triplets.push_back( T( n, i, 1 ) );
+    }
+    triplets.push_back( T( n, n, 1 ) );
+
+    m_A.resize( n+1, n+1 );
+    m_A.setFromTriplets( triplets.begin(), triplets.end() );
+    m_A.makeCompressed();
+
+    m_pos_J.resize( nnz );
+    m_pos_q.resize( n );
+    m_pos_c.resize( n+1 );
+    for ( integer k = 0; k < nnz; ++k ) m_pos_J(k) = entryPosition( m_A, I(k), J(k) );
+    for ( integer i = 0; i < n; ++i ) {
+      m_pos_q(i) = entryPosition( m_A, i, n );
+      m_pos_c(i) = entryPosition( m_A, n, i );
+    }
+    m_pos_c(n) = entryPosition( m_A, n, n );
+
+    m_LU.analyzePattern( m_A );
+
+    m_n = n;
+    m_x.resize( n );
+    m_F.resize( n );
+    m_Fq.resize( n );
+    m_jac.resize( nnz );
+    m_rhs.resize( n+1 );
+    m_dy.resize( n+1 );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  ContinuationDriver::evalF( dvec_t const & y ) {
+    m_x = y.head( m_n );
+    m_P->setParam( m_k, toParam( y(m_n) ) );
+    integer which;
+    if ( m_P->isAdmissible( m_x, which ) != POINT_ADMISSIBLE ) return false;
+    ++m_num_F;
+    return m_P->safeEvalF( m_x, m_F ) < 0;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  ContinuationDriver::factorize( dvec_t const & y, dvec_t const & c ) {
+    // m_x and the parameter are those of the last evalF( y )
+    ++m_num_J;
+    if ( m_P->safeJacobian( m_x, m_jac ) >= 0 ) return false;
+    m_P->dFdp( m_x, m_k, m_Fq );
+    if ( m_log_scale ) m_Fq *= toParam( y(m_n) ); // dF/dq = p dF/dp
+    if ( firstNonFinite( m_Fq ) >= 0 ) return false;
+
+    real_type * V = m_A.valuePtr();
+    m_A.coeffs().setZero();
+    for ( integer k = 0; k < m_jac.size(); ++k ) V[m_pos_J(k)] += m_jac(k);
+    for ( integer i = 0; i < m_n; ++i ) V[m_pos_q(i)] = m_Fq(i);
+    for ( integer j = 0; j <= m_n; ++j ) V[m_pos_c(j)] = c(j);
+
+    ++m_num_factorize;
+    m_LU.factorize( m_A );
+    return m_LU.info() == Eigen::Success;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  ContinuationDriver::correct(
+    dvec_t       & y,
+    dvec_t const & c,
+    dvec_t const & y_pred,
+    integer      & iter
+  ) {
+    real_type normF_old = real_max;
+    real_type step      = real_max; // last |dy|/(1+|y|)
+    for ( iter = 0;; ++iter ) {
+      if ( !evalF( y ) ) return false;
+      real_type normF = m_F.lpNorm<Eigen::Infinity>();
+      if ( normF <= m_tolerance || step <= m_tolerance ) return true;
+      // no decrease after a step at the level of rounding: the terms of
+      // F are too large to reach the tolerance, y is as good as it gets
+      if ( normF >= normF_old ) return step <= stall_step;
+      if ( iter >= m_max_corr ) return false;
+      normF_old = normF;
+
+      if ( !factorize( y, c ) ) return false;
+      m_rhs.head( m_n ) = -m_F;
+      m_rhs( m_n )      = -c.dot( y - y_pred );
+      m_dy = m_LU.solve( m_rhs );
+      ++m_num_newton;
+      if ( firstNonFinite( m_dy ) >= 0 ) return false;
+      y += m_dy;
+      step = m_dy.lpNorm<Eigen::Infinity>()/(1+y.lpNorm<Eigen::Infinity>());
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  ContinuationDriver::tangent(
+    dvec_t const & y,
+    dvec_t const & c,
+    bool           reuse,
+    dvec_t const & t_old,
+    dvec_t       & t
+  ) {
+    if ( !reuse && !( evalF( y ) && factorize( y, c ) ) ) return false;
+    // [ J F_q ; c^T ] t = e_{n+1}: t is in the kernel of [ J F_q ]
+    m_rhs.setZero();
+    m_rhs( m_n ) = 1;
+    t = m_LU.solve( m_rhs );
+    real_type nt = t.norm();
+    if ( !std::isfinite( nt ) || nt == 0 ) return false;
+    t /= nt;
+    if ( t.dot( t_old ) < 0 ) t = -t;
+    return true;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  ContinuationDriver::track(
+    real_type             p0,
+    real_type             p1,
+    integer               npts,
+    dvec_t              & x,
+    vector<branchPoint> & branch
+  ) {
+    integer const n  = m_n;
+    real_type const q0 = m_log_scale ? std::log(p0) : p0;
+    real_type const q1 = m_log_scale ? std::log(p1) : p1;
+    real_type const dq = (q1-q0)/(npts-1);
+
+    dvec_t y(n+1), y_pred(n+1), y_new(n+1), t(n+1), t_new(n+1), e_q(n+1);
+    e_q.setZero();
+    e_q(n) = 1;
+
+    // solve at p0 from the guess (with line search, it can be far)
+    NewtonSolver S;
+    S.setTolerance( m_tolerance );
+    m_P->setParam( m_k, toParam( q0 ) );
+    S.solve( *m_P, x );
+    m_num_newton    += S.numIter();
+    m_num_F         += S.numF();
+    m_num_J         += S.numJ();
+    m_num_factorize += S.numFactorize();
+
+    branchPoint bp;
+    integer     iter;
+    y.head(n) = x;
+    y(n)      = q0;
+    y_pred    = y;
+    bool ok = correct( y, e_q, y_pred, iter ) && tangent( y, e_q, false, dq >= 0 ? e_q : -e_q, t );
+    x = y.head(n);
+    if ( !ok ) return false;
+    bp.p          = p0;
+    bp.x          = x;
+    bp.num_newton = S.numIter() + iter;
+    branch.push_back( bp );
+
+    real_type ds   = min( m_ds_max, 4*std::abs(dq) );
+    integer   j    = 1;
+    integer   acc  = 0; // iterations since the last point stored
+    integer   nstp = 0; // steps since the last point stored
+    while ( j < npts && nstp < m_max_steps ) {
+      ++m_num_steps;
+      ++nstp;
+      real_type qj   = j == npts-1 ? q1 : q0 + j*dq;
+      real_type s    = (qj-y(n))/t(n);
+      bool      land = s > 0 && s <= ds;
+      if ( !land ) s = ds;
+
+      y_pred = y + s*t;
+      if ( land ) y_pred(n) = qj;
+      y_new = y_pred;
+      dvec_t const & c = land ? e_q : t;
+      ok = correct( y_new, c, y_pred, iter ) && tangent( y_new, c, iter > 0, t, t_new );
+      // an arclength step must not jump over the next point, unless
+      // the branch turned back
+      if ( ok && !land ) ok = (y_new(n)-qj)*dq <= 0 || t_new(n)*dq <= 0;
+      acc += iter;
+      if ( !ok ) {
+        ++m_num_rejected;
+        ds = s/2;
+        if ( ds < m_ds_min ) break;
+        continue;
+      }
+      y.swap( y_new );
+      t.swap( t_new );
+      if ( land ) {
+        bp.p          = j == npts-1 ? p1 : toParam( qj );
+        bp.x          = y.head(n);
+        bp.num_newton = acc;
+        branch.push_back( bp );
+        acc  = 0;
+        nstp = 0;
+        ++j;
+      }
+      // step size from the effort of the corrector
+      if      ( iter <= 2 ) ds = min( m_ds_max, 2*s );
+      else if ( iter <= 4 ) ds = s;
+      else                  ds = s/2;
+    }
+    x = y.head(n);
+    return j == npts;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  ContinuationDriver::sweep(
+    nonlinearSystem     & P,
+    integer               k,
+    real_type             p0,
+    real_type             p1,
+    integer               npts,
+    dvec_t              & x,
+    vector<branchPoint> & branch
+  ) {
+    UTILS_ASSERT(
+      k >= 0 && k < P.numParams(),
+      "ContinuationDriver::sweep, `{}` has no parameter {}", P.title(), k
+    );
+    UTILS_ASSERT( npts >= 2, "ContinuationDriver::sweep, npts = {} must be >= 2", npts );
+    UTILS_ASSERT(
+      !m_log_scale || ( p0 > 0 && p1 > 0 ),
+      "ContinuationDriver::sweep, p0 = {} and p1 = {} must be > 0 in log scale", p0, p1
+    );
+
+    Utils::TicToc tictoc;
+    tictoc.tic();
+    m_num_steps     = 0;
+    m_num_rejected  = 0;
+    m_num_newton    = 0;
+    m_num_F         = 0;
+    m_num_J         = 0;
+    m_num_factorize = 0;
+    m_completed     = false;
+
+    m_P = &P;
+    m_k = k;
+    real_type const p_save = P.getParam( k );
+    setup( P );
+    branch.clear();
+    try {
+      m_completed = track( p0, p1, npts, x, branch );
+    } catch ( ... ) {
+      P.setParam( k, p_save );
+      m_P = nullptr;
+      throw;
+    }
+    P.setParam( k, p_save );
+    m_P = nullptr;
+
+    tictoc.toc();
+    m_elapsed_ms = tictoc.elapsed_ms();
+    return m_completed;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  ContinuationDriver::info( ostream_type & stream ) const {
+    fmt::print(
+      stream,
+      "{:<12} {:<4} steps = {:<6} rejected = {:<5} newton = {:<6} "
+      "#F = {:<6} #J = {:<6} #LU = {:<6} [{:.3} ms]\n",
+      "Continuation", m_completed ? "OK" : "FAIL",
+      m_num_steps, m_num_rejected, m_num_newton,
+      m_num_F, m_num_J, m_num_factorize, m_elapsed_ms
+    );
+  }
+
+}
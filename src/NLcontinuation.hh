@@ -0,0 +1,189 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+#ifndef NL_CONTINUATION_HH
+#define NL_CONTINUATION_HH
+
+#include "NLsolver.hh"
+
+namespace NLproblem {
+
+  /*\
+   |    ____            _   _                    _   _
+   |   / ___|___  _ __ | |_(_)_ __  _   _  __ _| |_(_) ___  _ __
+   |  | |   / _ \| '_ \| __| | '_ \| | | |/ _` | __| |/ _ \| '_ \
+   |  | |__| (_) | | | | |_| | | | | |_| | (_| | |_| | (_) | | | |
+   |   \____\___/|_| |_|\__|_|_| |_|\__,_|\__,_|\__|_|\___/|_| |_|
+  \*/
+
+  //!
+  //! Pseudo-arclength continuation of \f$ F(x,p) = 0 \f$ along a
+  //! parameter \f$ p \f$ of a family of problems (`numParams`,
+  //! `setParam`, `dFdp` of `nonlinearSystem`).
+  //!
+  //! The unknowns are \f$ y = (x,q) \f$, with \f$ q = p \f$ or
+  //! \f$ q = \log p \f$ (`setLogScale`, for the parameters that span
+  //! decades as the `tau` of HAS 64). From a point of the branch and its
+  //! unit tangent \f$ t \f$ the predictor is \f$ y + s\,t \f$ and the
+  //! Newton corrector solves
+  //! \f[
+  //!   \begin{pmatrix} F_x & F_q \\ c^T & \end{pmatrix} \delta y =
+  //!   -\begin{pmatrix} F \\ c^T(y-y_{pred}) \end{pmatrix}
+  //! \f]
+  //! with \f$ c = t \f$ (arclength step) or \f$ c = e_q \f$ (step that
+  //! lands on a requested value of \f$ q \f$, taken when it is within
+  //! the current step size along the tangent). The bordered matrix has a
+  //! fixed pattern, the pattern of the jacobian plus a dense last row
+  //! and column: its symbolic analysis is done once per sweep, each
+  //! Newton step only refactorizes the values. The new tangent is solved
+  //! with the last factorization of the corrector, so the folds of the
+  //! branch are passed with arclength steps.
+  //! The step size grows after fast corrections and is halved when the
+  //! corrector fails (non finite values, no decrease of
+  //! \f$ \|F\|_\infty \f$ above the rounding level, too many
+  //! iterations).
+  //!
+  class ContinuationDriver {
+  public:
+
+    //! a point of the branch at a requested parameter value
+    struct branchPoint {
+      real_type p;
+      dvec_t    x;
+      integer   num_newton; // corrector iterations since the previous point
+    };
+
+  private:
+
+    typedef Eigen::SparseLU<spmat_t,Eigen::COLAMDOrdering<integer> > LU_t;
+
+    ContinuationDriver( ContinuationDriver const & );
+    ContinuationDriver const & operator = ( ContinuationDriver const & );
+
+    // parameters
+    real_type m_tolerance;  // on ||F||_inf
+    real_type m_ds_max;     // maximum arclength step
+    real_type m_ds_min;     // the sweep fails below
+    integer   m_max_corr;   // corrector iterations
+    integer   m_max_steps;  // continuation steps between two points
+    bool      m_log_scale;
+
+    // problem and parameter of the current sweep
+    nonlinearSystem * m_P;
+    integer           m_k;
+    integer           m_n;
+
+    // bordered matrix [ J F_q ; c^T ], pattern analysed in setup
+    spmat_t m_A;
+    ivec_t  m_pos_J; // position in m_A.valuePtr() of the k-th nonzero of J
+    ivec_t  m_pos_q; // position of (i,n)
+    ivec_t  m_pos_c; // position of (n,j)
+    LU_t    m_LU;
+
+    dvec_t m_x, m_F, m_Fq, m_jac, m_rhs, m_dy;
+
+    // statistics of the last sweep
+    integer   m_num_steps;
+    integer   m_num_rejected;
+    integer   m_num_newton;
+    integer   m_num_F;
+    integer   m_num_J;
+    integer   m_num_factorize;
+    real_type m_elapsed_ms;
+    bool      m_completed;
+
+    void setup( nonlinearSystem const & P );
+
+    real_type toParam( real_type q ) const { return m_log_scale ? std::exp(q) : q; }
+
+    //! F at \f$ y = (x,q) \f$ in `m_F`, `false` if not finite
+    bool evalF( dvec_t const & y );
+
+    //! assemble and factorize the bordered matrix at `y` with last row `c`
+    bool factorize( dvec_t const & y, dvec_t const & c );
+
+    //!
+    //! Newton corrector from `y` on \f$ F = 0 \f$,
+    //! \f$ c^T(y-y_{pred}) = 0 \f$, `iter` is the number of Newton
+    //! steps; on success `m_LU` holds the last factorization when
+    //! `iter` > 0.
+    //!
+    bool correct( dvec_t & y, dvec_t const & c, dvec_t const & y_pred, integer & iter );
+
+    //!
+    //! Unit tangent at `y` oriented as `t_old`, in `t`; with `reuse` the
+    //! last factorization (row `c`) of the corrector is used.
+    //!
+    bool
+    tangent(
+      dvec_t const & y,
+      dvec_t const & c,
+      bool           reuse,
+      dvec_t const & t_old,
+      dvec_t       & t
+    );
+
+    bool
+    track(
+      real_type             p0,
+      real_type             p1,
+      integer               npts,
+      dvec_t              & x,
+      vector<branchPoint> & branch
+    );
+
+  public:
+
+    ContinuationDriver();
+
+    void setTolerance( real_type tol )      { m_tolerance = tol; }
+    void setMaxStep( real_type ds )         { m_ds_max = ds; }
+    void setMinStep( real_type ds )         { m_ds_min = ds; }
+    void setMaxCorrections( integer mc )    { m_max_corr = mc; }
+    void setMaxSteps( integer ms )          { m_max_steps = ms; }
+    void setLogScale( bool yes )            { m_log_scale = yes; }
+
+    //!
+    //! Follow the branch of the parameter `k` of `P` from `p0` to `p1`
+    //! and store in `branch` the solutions at the `npts` equispaced
+    //! values (in \f$ q \f$) of \f$ [p_0,p_1] \f$. `x` is the starting
+    //! guess at `p0`, solved with `NewtonSolver`, on exit the last point
+    //! reached. Each point is warm started from the previous one.
+    //! Return `false` if the branch is lost before `p1` (the points
+    //! reached are in `branch`), for instance when it turns back at a
+    //! fold. The parameter of `P` is restored on exit.
+    //!
+    bool
+    sweep(
+      nonlinearSystem     & P,
+      integer               k,
+      real_type             p0,
+      real_type             p1,
+      integer               npts,
+      dvec_t              & x,
+      vector<branchPoint> & branch
+    );
+
+    integer   numSteps()     const { return m_num_steps; }
+    integer   numRejected()  const { return m_num_rejected; }
+    integer   numNewton()    const { return m_num_newton; }
+    integer   numF()         const { return m_num_F; }
+    integer   numJ()         const { return m_num_J; }
+    integer   numFactorize() const { return m_num_factorize; }
+    real_type elapsedMs()    const { return m_elapsed_ms; }
+    bool      completed()    const { return m_completed; }
+
+    void info( ostream_type & stream ) const;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,158 @@
+#include "NLperfCounters.hh"
+
+#include <chrono>
+#include <cstring>
+
+#ifdef __linux__
+  #include <cerrno>
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+namespace NLproblem {
+
+  char const *
+  perfCounters::name( perfEvent e ) {
+    switch ( e ) {
+    case PERF_CYCLES:        return "cycles";
+    case PERF_INSTRUCTIONS:  return "instructions";
+    case PERF_CACHE_MISSES:  return "cache-misses";
+    case PERF_BRANCH_MISSES: return "branch-misses";
+    case PERF_NUM_EVENTS:    break;
+    }
+    return "";
+  }
+
+#ifdef __linux__
+
+  static
+  int
+  openEvent( uint64_t config, int group_fd ) {
+    perf_event_attr attr;
+    std::memset( &attr, 0, sizeof(attr) );
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof(attr);
+    attr.config         = config;
+    attr.disabled       = group_fd < 0 ? 1 : 0; // the leader starts the group
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_GROUP |
+                          PERF_FORMAT_TOTAL_TIME_ENABLED |
+                          PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return int( syscall( __NR_perf_event_open, &attr, 0, -1, group_fd, 0 ) );
+  }
+
+  perfCounters::perfCounters() : m_leader(-1) {
+    uint64_t const config[PERF_NUM_EVENTS] = {
+      PERF_COUNT_HW_CPU_CYCLES,
+      PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_MISSES,
+      PERF_COUNT_HW_BRANCH_MISSES
+    };
+    for ( integer e = 0; e < PERF_NUM_EVENTS; ++e ) {
+      m_fd[e] = openEvent( config[e], m_leader < 0 ? -1 : m_fd[m_leader] );
+      if ( m_fd[e] < 0 ) {
+        if ( !m_reason.empty() ) m_reason += ", ";
+        m_reason += fmt::format(
+          "{}: {}", name( perfEvent(e) ), std::strerror( errno )
+        );
+      } else if ( m_leader < 0 ) {
+        m_leader = e;
+      }
+    }
+  }
+
+  perfCounters::~perfCounters() {
+    for ( integer e = 0; e < PERF_NUM_EVENTS; ++e )
+      if ( m_fd[e] >= 0 ) close( m_fd[e] );
+  }
+
+  void
+  perfCounters::start() {
+    if ( m_leader < 0 ) return;
+    ioctl( m_fd[m_leader], PERF_EVENT_IOC_RESET,  PERF_IOC_FLAG_GROUP );
+    ioctl( m_fd[m_leader], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP );
+  }
+
+  void
+  perfCounters::stop( real_type counts[PERF_NUM_EVENTS] ) {
+    for ( integer e = 0; e < PERF_NUM_EVENTS; ++e ) counts[e] = -1;
+    if ( m_leader < 0 ) return;
+    ioctl( m_fd[m_leader], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP );
+    // nr, time_enabled, time_running, value[nr] (in the order of opening)
+    uint64_t buffer[3+PERF_NUM_EVENTS];
+    ssize_t  nb = read( m_fd[m_leader], buffer, sizeof(buffer) );
+    if ( nb < ssize_t(3*sizeof(uint64_t)) || buffer[2] == 0 ) return;
+    real_type scale = real_type(buffer[1]) / real_type(buffer[2]);
+    uint64_t  k     = 0;
+    for ( integer e = 0; e < PERF_NUM_EVENTS && k < buffer[0]; ++e )
+      if ( m_fd[e] >= 0 ) counts[e] = scale * real_type(buffer[3+k++]);
+  }
+
+#else
+
+  perfCounters::perfCounters() : m_leader(-1) {
+    for ( integer e = 0; e < PERF_NUM_EVENTS; ++e ) m_fd[e] = -1;
+    m_reason = "perf_event_open is available only on Linux";
+  }
+
+  perfCounters::~perfCounters() {}
+
+  void perfCounters::start() {}
+
+  void
+  perfCounters::stop( real_type counts[PERF_NUM_EVENTS] ) {
+    for ( integer e = 0; e < PERF_NUM_EVENTS; ++e ) counts[e] = -1;
+  }
+
+#endif
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  template <typename CALL>
+  static
+  void
+  profileKernel(
+    char const * kernel,
+    CALL const & call,
+    long long    calls,
+    perfCounters & pc,
+    kernelPerf   & K
+  ) {
+    typedef std::chrono::steady_clock clock_type;
+    K.kernel = kernel;
+    K.calls  = calls;
+    call(); // warmup
+    clock_type::time_point t0 = clock_type::now();
+    pc.start();
+    for ( long long k = 0; k < calls; ++k ) call();
+    pc.stop( K.count );
+    real_type ns = real_type(
+      std::chrono::duration_cast<std::chrono::nanoseconds>( clock_type::now() - t0 ).count()
+    );
+    K.ns = ns / real_type(calls);
+    for ( integer e = 0; e < PERF_NUM_EVENTS; ++e )
+      if ( K.count[e] >= 0 ) K.count[e] /= real_type(calls);
+  }
+
+  void
+  profileKernels(
+    nonlinearSystem const & P,
+    integer                 guess,
+    long long               calls,
+    perfCounters          & pc,
+    vector<kernelPerf>    & res
+  ) {
+    integer const n   = P.numEqns();
+    integer const nnz = P.jacobianNnz();
+    calls = max( calls, 1LL );
+    dvec_t x(n), f(n), jac(nnz);
+    P.getInitialPoint( x, guess );
+    res.resize( 2 );
+    profileKernel( "evalF",    [&]() { P.evalF( x, f ); },      calls, pc, res[0] );
+    profileKernel( "jacobian", [&]() { P.jacobian( x, jac ); }, calls, pc, res[1] );
+  }
+
+}
@@ -0,0 +1,104 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+#ifndef NL_PERF_COUNTERS_HH
+#define NL_PERF_COUNTERS_HH
+
+#include "testsNonlin.hh"
+
+namespace NLproblem {
+
+  //! hardware events counted by `perfCounters`
+  typedef enum {
+    PERF_CYCLES = 0,
+    PERF_INSTRUCTIONS,
+    PERF_CACHE_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_NUM_EVENTS
+  } perfEvent;
+
+  /*\
+   |   ____            __  ____                  _
+   |  |  _ \ ___ _ __ / _|/ ___|___  _   _ _ __ | |_ ___ _ __ ___
+   |  | |_) / _ \ '__| |_| |   / _ \| | | | '_ \| __/ _ \ '__/ __|
+   |  |  __/  __/ |  |  _| |__| (_) | |_| | | | | ||  __/ |  \__ \
+   |  |_|   \___|_|  |_|  \____\___/ \__,_|_| |_|\__\___|_|  |___/
+  \*/
+
+  //!
+  //! Hardware performance counters of the calling thread (user space
+  //! only) by the Linux `perf_event_open` interface.
+  //!
+  //! The events are opened as one group so that they count the same
+  //! interval; the events that the machine does not support are left
+  //! out (their count is -1). When no event can be opened (no PMU, as
+  //! in many virtual machines, `perf_event_paranoid` too high, not
+  //! Linux) the object is not `available` and only the wall time is
+  //! measured. When the kernel multiplexes the group the counts are
+  //! scaled by the fraction of the time it was running.
+  //!
+  class perfCounters {
+
+    perfCounters( perfCounters const & );
+    perfCounters const & operator = ( perfCounters const & );
+
+    int    m_fd[PERF_NUM_EVENTS];  // -1 = not opened
+    int    m_leader;
+    string m_reason;
+
+  public:
+
+    perfCounters();
+    ~perfCounters();
+
+    //! true if at least one event is counted
+    bool available() const { return m_leader >= 0; }
+
+    //! true if the event `e` is counted
+    bool counting( perfEvent e ) const { return m_fd[e] >= 0; }
+
+    //! why the counters (or some of them) are not available
+    string const & reason() const { return m_reason; }
+
+    static char const * name( perfEvent e );
+
+    //! zero and start the counters
+    void start();
+
+    //! stop the counters and read them, -1 for the events not counted
+    void stop( real_type counts[PERF_NUM_EVENTS] );
+  };
+
+  //! counters per call of a kernel of a problem
+  struct kernelPerf {
+    string    kernel;
+    long long calls;
+    real_type ns;                      //!< wall time per call
+    real_type count[PERF_NUM_EVENTS];  //!< per call, -1 = not counted
+  };
+
+  //!
+  //! Call `evalF` and `jacobian` of `P` at its initial point `guess`
+  //! `calls` times each (after one warmup call) and return the time and
+  //! the counters per call. The counts per nonzero are the counts per
+  //! call divided by `P.jacobianNnz()`.
+  //!
+  void
+  profileKernels(
+    nonlinearSystem const & P,
+    integer                 guess,
+    long long               calls,
+    perfCounters          & pc,
+    vector<kernelPerf>    & res
+  );
+
+}
+
+#endif
@@ -0,0 +1,272 @@
+#include "NLprofiles.hh"
+#include <algorithm>
+#include <fstream>
+
+namespace NLproblem {
+
+  void
+  profileTable::writeCSV( ostream_type & stream ) const {
+    auto quoted = []( string const & s ) -> string {
+      if ( s.find_first_of( ",\"" ) == string::npos ) return s;
+      string res = "\"";
+      for ( char c : s ) { if ( c == '"' ) res += '"'; res += c; }
+      return res + "\"";
+    };
+    stream << quoted( x_name );
+    for ( auto const & s : solvers ) stream << ',' << quoted( s );
+    stream << '\n';
+    for ( size_t i = 0; i < x.size(); ++i ) {
+      fmt::print( stream, "{:.6g}", x[i] );
+      for ( auto const & ys : y ) fmt::print( stream, ",{:.6g}", ys[i] );
+      stream << '\n';
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  profileTable::writeText( ostream_type & stream ) const {
+    size_t w = 10;
+    for ( auto const & s : solvers ) w = max( w, s.size()+1 );
+    fmt::print( stream, "{:>12}", x_name );
+    for ( auto const & s : solvers ) fmt::print( stream, "{:>{}}", s, w );
+    stream << '\n';
+    for ( size_t i = 0; i < x.size(); ++i ) {
+      fmt::print( stream, "{:>12.5g}", x[i] );
+      for ( auto const & ys : y ) fmt::print( stream, "{:>{}.4f}", ys[i], w );
+      stream << '\n';
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  RunRecords::reserve( size_t nrec ) {
+    m_instance.reserve( nrec );
+    m_solver.reserve( nrec );
+    m_ms.reserve( nrec );
+    m_num_F.reserve( nrec );
+    m_num_J.reserve( nrec );
+    m_norm_F.reserve( nrec );
+    m_converged.reserve( nrec );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  RunRecords::add(
+    string const & problem,
+    integer        guess,
+    integer        n,
+    string const & solver,
+    real_type      ms,
+    integer        num_F,
+    integer        num_J,
+    real_type      norm_F,
+    bool           converged
+  ) {
+    string key = fmt::format( "{} #{}", problem, guess );
+    auto ip = m_instance_map.find( key );
+    if ( ip == m_instance_map.end() ) {
+      ip = m_instance_map.insert( std::make_pair( key, numInstances() ) ).first;
+      m_instance_name.push_back( key );
+      m_instance_n.push_back( n );
+    }
+    auto is = m_solver_map.find( solver );
+    if ( is == m_solver_map.end() ) {
+      is = m_solver_map.insert( std::make_pair( solver, numSolvers() ) ).first;
+      m_solver_name.push_back( solver );
+    }
+    m_instance.push_back( ip->second );
+    m_solver.push_back( is->second );
+    m_ms.push_back( ms );
+    m_num_F.push_back( num_F );
+    m_num_J.push_back( num_J );
+    m_norm_F.push_back( norm_F );
+    m_converged.push_back( converged );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  integer
+  RunRecords::loadBatch( string const & fname ) {
+    std::ifstream file( fname.c_str() );
+    UTILS_ASSERT( file.good(), "RunRecords::loadBatch, cannot open `{}`", fname );
+    integer const np = integer(theProblems.size());
+    integer nread = 0;
+    string  line;
+    size_t  tab[9];
+    while ( std::getline( file, line ) ) {
+      if ( line.empty() || line[0] == '#' ) continue;
+      // problem title guess solver status iter #F #J ||F|| ms
+      size_t nt = 0;
+      for ( size_t pos = line.find('\t'); pos != string::npos && nt < 9; pos = line.find( '\t', pos+1 ) )
+        tab[nt++] = pos;
+      if ( nt != 9 || line.find( '\t', tab[8]+1 ) != string::npos ) continue; // truncated line
+      char const * s = line.c_str();
+      integer ip = integer( std::atol( s ) );
+      integer n  = ip >= 0 && ip < np ? theProblems[size_t(ip)]->numEqns() : 0;
+      add(
+        line.substr( 0, tab[0] ) + " " + line.substr( tab[0]+1, tab[1]-tab[0]-1 ),
+        integer( std::atol( s+tab[1]+1 ) ),
+        n,
+        line.substr( tab[2]+1, tab[3]-tab[2]-1 ),
+        std::atof( s+tab[8]+1 ),
+        integer( std::atol( s+tab[5]+1 ) ),
+        integer( std::atol( s+tab[6]+1 ) ),
+        std::atof( s+tab[7]+1 ),
+        line.compare( tab[3]+1, tab[4]-tab[3]-1, "OK" ) == 0
+      );
+      ++nread;
+    }
+    return nread;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  string
+  RunRecords::metricName( profileMetric m ) {
+    switch ( m ) {
+    case PROFILE_TIME:  return "ms";
+    case PROFILE_NUM_F: return "#F";
+    case PROFILE_NUM_J: return "#J";
+    }
+    return "";
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  RunRecords::costTable( profileMetric m, vector<real_type> & T ) const {
+    integer const ns = numSolvers();
+    T.assign( size_t(numInstances()) * size_t(ns), real_max );
+    integer const nr = numRecords();
+    for ( integer k = 0; k < nr; ++k ) {
+      size_t    idx = size_t(m_instance[k]) * size_t(ns) + size_t(m_solver[k]);
+      bool      ok  = m_converged[k] && ( m_tolerance <= 0 || m_norm_F[k] <= m_tolerance );
+      real_type c   = real_max;
+      if ( ok ) {
+        switch ( m ) {
+        case PROFILE_TIME:  c = max( m_ms[k], real_type(1e-3) );    break;
+        case PROFILE_NUM_F: c = real_type( max( m_num_F[k], 1 ) ); break;
+        case PROFILE_NUM_J: c = real_type( max( m_num_J[k], 1 ) ); break;
+        }
+      }
+      T[idx] = c;
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  RunRecords::logGrid( real_type a, real_type b, integer npts, vector<real_type> & x ) {
+    npts = max( npts, 2 );
+    x.resize( size_t(npts) );
+    real_type la = std::log( a ), lb = std::log( max( a, b ) );
+    for ( integer i = 0; i < npts; ++i )
+      x[size_t(i)] = std::exp( la + (lb-la) * i / (npts-1) );
+    x.front() = a;
+    x.back()  = max( a, b );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  integer
+  RunRecords::numSolved( integer s ) const {
+    vector<real_type> T;
+    costTable( PROFILE_NUM_F, T );
+    integer const ns = numSolvers();
+    integer count = 0;
+    for ( size_t idx = size_t(s); idx < T.size(); idx += size_t(ns) )
+      if ( T[idx] < real_max ) ++count;
+    return count;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  RunRecords::performanceRatios( profileMetric m, vector<vector<real_type> > & r ) const {
+    vector<real_type> T;
+    costTable( m, T );
+    integer const ni = numInstances();
+    integer const ns = numSolvers();
+    r.assign( size_t(ns), vector<real_type>( size_t(ni), real_max ) );
+    for ( integer p = 0; p < ni; ++p ) {
+      real_type const * Tp = &T[size_t(p)*size_t(ns)];
+      real_type best = *std::min_element( Tp, Tp+ns );
+      if ( best == real_max ) continue; // not solved by any solver
+      for ( integer s = 0; s < ns; ++s )
+        if ( Tp[s] < real_max ) r[size_t(s)][size_t(p)] = Tp[s] / best;
+    }
+    for ( auto & rs : r ) std::sort( rs.begin(), rs.end() );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  RunRecords::performanceProfile(
+    profileMetric  m,
+    integer        npts,
+    real_type      tau_max,
+    profileTable & T
+  ) const {
+    vector<vector<real_type> > r;
+    performanceRatios( m, r );
+    if ( tau_max <= 0 ) {
+      tau_max = 1;
+      for ( auto const & rs : r ) {
+        auto it = std::lower_bound( rs.begin(), rs.end(), real_max );
+        if ( it != rs.begin() ) tau_max = max( tau_max, *(it-1) );
+      }
+    }
+    T.x_name  = "tau(" + metricName( m ) + ")";
+    T.solvers = m_solver_name;
+    logGrid( 1, tau_max, npts, T.x );
+    real_type const ni = real_type( max( numInstances(), 1 ) );
+    T.y.assign( r.size(), vector<real_type>( T.x.size() ) );
+    for ( size_t s = 0; s < r.size(); ++s )
+      for ( size_t i = 0; i < T.x.size(); ++i )
+        T.y[s][i] = real_type( std::upper_bound( r[s].begin(), r[s].end(), T.x[i] ) - r[s].begin() ) / ni;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  RunRecords::dataProfile(
+    profileMetric  m,
+    integer        npts,
+    real_type      alpha_max,
+    profileTable & T
+  ) const {
+    vector<real_type> C;
+    costTable( m, C );
+    integer const ni = numInstances();
+    integer const ns = numSolvers();
+    vector<vector<real_type> > c( static_cast<size_t>(ns), vector<real_type>( static_cast<size_t>(ni) ) );
+    real_type cmin = real_max, cmax = 0;
+    for ( integer p = 0; p < ni; ++p ) {
+      real_type scale = m == PROFILE_NUM_F ? real_type( m_instance_n[size_t(p)] + 1 ) : 1;
+      for ( integer s = 0; s < ns; ++s ) {
+        real_type v = C[size_t(p)*size_t(ns)+size_t(s)];
+        if ( v < real_max ) {
+          v /= scale;
+          cmin = min( cmin, v );
+          cmax = max( cmax, v );
+        }
+        c[size_t(s)][size_t(p)] = v;
+      }
+    }
+    for ( auto & cs : c ) std::sort( cs.begin(), cs.end() );
+    if ( cmin == real_max ) cmin = cmax = 1;
+    if ( alpha_max <= 0 ) alpha_max = cmax;
+    T.x_name  = m == PROFILE_NUM_F ? string("alpha(grad)") : "alpha(" + metricName( m ) + ")";
+    T.solvers = m_solver_name;
+    logGrid( cmin, alpha_max, npts, T.x );
+    real_type const nd = real_type( max( ni, 1 ) );
+    T.y.assign( c.size(), vector<real_type>( T.x.size() ) );
+    for ( size_t s = 0; s < c.size(); ++s )
+      for ( size_t i = 0; i < T.x.size(); ++i )
+        T.y[s][i] = real_type( std::upper_bound( c[s].begin(), c[s].end(), T.x[i] ) - c[s].begin() ) / nd;
+  }
+
+}
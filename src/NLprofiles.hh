@@ -0,0 +1,170 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+#ifndef NL_PROFILES_HH
+#define NL_PROFILES_HH
+
+#include "testsNonlin.hh"
+
+namespace NLproblem {
+
+  //! cost of a run compared by the profiles
+  typedef enum { PROFILE_TIME = 0, PROFILE_NUM_F, PROFILE_NUM_J } profileMetric;
+
+  //!
+  //! A profile sampled on a grid: the abscissae `x` and for each solver
+  //! the fraction of the instances `y[s][i]` at `x[i]`.
+  //!
+  class profileTable {
+  public:
+    string                     x_name;
+    vector<real_type>          x;
+    vector<string>             solvers;
+    vector<vector<real_type> > y;
+
+    //! comma separated values, a header line then one line for each abscissa
+    void writeCSV( ostream_type & stream ) const;
+
+    //! aligned columns
+    void writeText( ostream_type & stream ) const;
+  };
+
+  /*\
+   |   ____             __ _ _
+   |  |  _ \ _ __ ___  / _(_) | ___  ___
+   |  | |_) | '__/ _ \| |_| | |/ _ \/ __|
+   |  |  __/| | | (_) |  _| | |  __/\__ \
+   |  |_|   |_|  \___/|_| |_|_|\___||___/
+  \*/
+
+  //!
+  //! Results of many runs (problem, initial point, solver) and their
+  //! Dolan-Moré performance profiles and Moré-Wild data profiles.
+  //!
+  //! The records are stored by columns, the problem and initial point
+  //! (an instance) and the solver are interned to integers. A run is
+  //! solved when it converged and, if a tolerance is set, its final
+  //! \f$ \|F\| \f$ is below it; the cost of the unsolved runs (and of
+  //! the missing ones) is infinite. When a run is recorded twice the
+  //! last record counts.
+  //!
+  //! Performance profile: with \f$ t_{p,s} \f$ the cost of the solver
+  //! \f$ s \f$ on the instance \f$ p \f$ the ratio is
+  //! \f$ r_{p,s} = t_{p,s} / \min_s t_{p,s} \f$ and
+  //! \f$ \rho_s(\tau) \f$ is the fraction of the instances with
+  //! \f$ r_{p,s} \le \tau \f$.
+  //!
+  //! Data profile: \f$ d_s(\alpha) \f$ is the fraction of the instances
+  //! solved with cost \f$ \le \alpha \f$, for `PROFILE_NUM_F` the cost is
+  //! measured in simplex gradients (\f$ n_p+1 \f$ evaluations of F).
+  //!
+  //! The ratios of each solver are sorted once, a value of a profile is
+  //! then a binary search. Costs below the resolution (1 evaluation,
+  //! 1 microsecond) are rounded up so that the ratios are finite.
+  //!
+  class RunRecords {
+
+    // columns, one entry for each record
+    vector<integer>   m_instance;
+    vector<integer>   m_solver;
+    vector<real_type> m_ms;
+    vector<integer>   m_num_F;
+    vector<integer>   m_num_J;
+    vector<real_type> m_norm_F;
+    vector<bool>      m_converged;
+
+    // interned instances and solvers
+    vector<string>           m_instance_name;
+    vector<integer>          m_instance_n;
+    std::map<string,integer> m_instance_map;
+    vector<string>           m_solver_name;
+    std::map<string,integer> m_solver_map;
+
+    real_type m_tolerance;
+
+    //! cost of each instance (by rows) and solver, infinite if not solved
+    void costTable( profileMetric m, vector<real_type> & T ) const;
+
+    static string metricName( profileMetric m );
+
+    static void logGrid( real_type a, real_type b, integer npts, vector<real_type> & x );
+
+  public:
+
+    RunRecords() : m_tolerance(0) {}
+
+    void reserve( size_t nrec );
+
+    //! add the result of `solver` on `problem` (`n` equations) from the initial point `guess`
+    void
+    add(
+      string const & problem,
+      integer        guess,
+      integer        n,
+      string const & solver,
+      real_type      ms,
+      integer        num_F,
+      integer        num_J,
+      real_type      norm_F,
+      bool           converged
+    );
+
+    //!
+    //! Read the results written by `BatchRunner`, the number of equations
+    //! is taken from `theProblems` when it is loaded. Return the number
+    //! of records read.
+    //!
+    integer loadBatch( string const & fname );
+
+    //! a run is solved only when also its final ||F|| is <= tol (0 = no test)
+    void setTolerance( real_type tol ) { m_tolerance = tol; }
+
+    integer numRecords()   const { return integer(m_instance.size()); }
+    integer numInstances() const { return integer(m_instance_name.size()); }
+    integer numSolvers()   const { return integer(m_solver_name.size()); }
+
+    string const & solverName( integer s ) const { return m_solver_name[size_t(s)]; }
+    string const & instanceName( integer p ) const { return m_instance_name[size_t(p)]; }
+
+    //! number of instances solved by the solver `s`
+    integer numSolved( integer s ) const;
+
+    //! for each solver the sorted performance ratios of all the instances
+    void performanceRatios( profileMetric m, vector<vector<real_type> > & r ) const;
+
+    //!
+    //! Performance profile on `npts` values of \f$ \tau \f$ equally spaced in
+    //! log scale from 1 to `tau_max` (0 = the largest finite ratio).
+    //!
+    void
+    performanceProfile(
+      profileMetric  m,
+      integer        npts,
+      real_type      tau_max,
+      profileTable & T
+    ) const;
+
+    //!
+    //! Data profile on `npts` values of \f$ \alpha \f$ equally spaced in log
+    //! scale from the smallest finite cost to `alpha_max` (0 = the largest).
+    //!
+    void
+    dataProfile(
+      profileMetric  m,
+      integer        npts,
+      real_type      alpha_max,
+      profileTable & T
+    ) const;
+
+  };
+
+}
+
+#endif
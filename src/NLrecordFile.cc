@@ -0,0 +1,354 @@
+#include "NLrecordFile.hh"
+#include "Utils_zstream.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace NLproblem {
+
+  static char const record_magic[8] = { 'N', 'L', 'R', 'E', 'C', 'S', 0, 1 };
+
+  // compressed size, raw size, number of records
+  static size_t const frame_header_bytes = 8+8+4;
+
+  // problem, guess, solver, kind, number of values
+  static size_t const record_header_bytes = 5*4;
+
+  template <typename T>
+  static
+  void
+  putRaw( std::ostream & stream, T const & v ) {
+    stream.write( reinterpret_cast<char const *>(&v), sizeof(T) );
+  }
+
+  template <typename T>
+  static
+  void
+  getRaw( std::istream & stream, T & v ) {
+    stream.read( reinterpret_cast<char *>(&v), sizeof(T) );
+    UTILS_ASSERT0( stream.good(), "recordFileReader, truncated file" );
+  }
+
+  template <typename T>
+  static
+  void
+  appendRaw( string & buffer, T const & v ) {
+    buffer.append( reinterpret_cast<char const *>(&v), sizeof(T) );
+  }
+
+  /*\
+   |  asyncRecordWriter
+  \*/
+
+  asyncRecordWriter::asyncRecordWriter(
+    string const & fname,
+    unsigned       nslots,
+    size_t         frame_bytes,
+    integer        level,
+    size_t         max_pending
+  )
+  : m_slots( max( nslots, 1u ) )
+  , m_frame_bytes( max( frame_bytes, size_t(4096) ) )
+  , m_max_pending( max_pending > 0 ? max_pending : 2*m_slots.size() )
+  , m_level( level )
+  , m_offset(0)
+  , m_busy(false)
+  , m_closing(false)
+  , m_num_records(0)
+  , m_raw_bytes(0)
+  {
+    for ( auto & S : m_slots ) S.buffer.nrec = 0;
+    m_file.open( fname.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+    UTILS_ASSERT( m_file.good(), "asyncRecordWriter, cannot open `{}`", fname );
+    m_file.write( record_magic, sizeof(record_magic) );
+    m_offset = sizeof(record_magic);
+    m_thread = std::thread( &asyncRecordWriter::background, this );
+  }
+
+  asyncRecordWriter::~asyncRecordWriter() {
+    try {
+      close();
+    } catch ( ... ) {
+      // nothing to do in a destructor
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  asyncRecordWriter::append(
+    unsigned          islot,
+    integer           problem,
+    integer           guess,
+    integer           solver,
+    integer           kind,
+    real_type const * values,
+    integer           nvalues
+  ) {
+    UTILS_ASSERT(
+      islot < m_slots.size(),
+      "asyncRecordWriter::append, slot {} >= {}", islot, m_slots.size()
+    );
+    frame & F = m_slots[islot].buffer;
+    if ( F.raw.capacity() < m_frame_bytes ) F.raw.reserve( m_frame_bytes + (m_frame_bytes >> 3) );
+    appendRaw( F.raw, int32_t(problem) );
+    appendRaw( F.raw, int32_t(guess) );
+    appendRaw( F.raw, int32_t(solver) );
+    appendRaw( F.raw, int32_t(kind) );
+    appendRaw( F.raw, uint32_t(nvalues) );
+    F.raw.append( reinterpret_cast<char const *>(values), size_t(nvalues)*sizeof(real_type) );
+    ++F.nrec;
+    if ( F.problems.empty() || F.problems.back() != problem ) F.problems.push_back( problem );
+    m_num_records.fetch_add( 1, std::memory_order_relaxed );
+    if ( F.raw.size() >= m_frame_bytes ) push( F );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  asyncRecordWriter::push( frame & F ) {
+    std::unique_lock<std::mutex> lock( m_mtx );
+    m_cv_space.wait( lock, [this]() -> bool { return m_queue.size() < m_max_pending; } );
+    m_queue.push_back( frame() );
+    std::swap( m_queue.back(), F );
+    F.nrec = 0;
+    if ( !m_spares.empty() ) {
+      F.raw.swap( m_spares.back() );
+      m_spares.pop_back();
+    }
+    m_cv_work.notify_one();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  asyncRecordWriter::background() {
+    std::unique_lock<std::mutex> lock( m_mtx );
+    while ( true ) {
+      m_cv_work.wait( lock, [this]() -> bool { return !m_queue.empty() || m_closing; } );
+      if ( m_queue.empty() ) break; // closing
+      frame F;
+      std::swap( F, m_queue.front() );
+      m_queue.pop_front();
+      m_busy = true;
+      m_cv_space.notify_all();
+      lock.unlock();
+      writeFrame( F );
+      lock.lock();
+      m_busy = false;
+      F.raw.clear();
+      m_spares.push_back( string() );
+      m_spares.back().swap( F.raw );
+      m_cv_space.notify_all();
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  asyncRecordWriter::writeFrame( frame & F ) {
+    std::ostringstream zbuffer;
+    {
+      zstream::ozstream z( zbuffer, size_t(m_level) );
+      z.write( F.raw.data(), std::streamsize(F.raw.size()) );
+      z.close();
+    }
+    string const zs = zbuffer.str();
+
+    frameIndex I;
+    I.offset = m_offset;
+    I.zsize  = zs.size();
+    I.rsize  = F.raw.size();
+    I.nrec   = F.nrec;
+    I.problems.swap( F.problems );
+    std::sort( I.problems.begin(), I.problems.end() );
+    I.problems.erase( std::unique( I.problems.begin(), I.problems.end() ), I.problems.end() );
+
+    putRaw( m_file, I.zsize );
+    putRaw( m_file, I.rsize );
+    putRaw( m_file, I.nrec );
+    m_file.write( zs.data(), std::streamsize(zs.size()) );
+    m_offset    += frame_header_bytes + zs.size();
+    m_raw_bytes += F.raw.size();
+    m_index.push_back( I );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  asyncRecordWriter::flush() {
+    for ( auto & S : m_slots )
+      if ( S.buffer.nrec > 0 ) push( S.buffer );
+    std::unique_lock<std::mutex> lock( m_mtx );
+    m_cv_space.wait( lock, [this]() -> bool { return m_queue.empty() && !m_busy; } );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  asyncRecordWriter::close() {
+    if ( !m_file.is_open() ) return;
+    flush();
+    {
+      std::lock_guard<std::mutex> lock( m_mtx );
+      m_closing = true;
+    }
+    m_cv_work.notify_one();
+    m_thread.join();
+
+    uint64_t const index_offset = m_offset;
+    putRaw( m_file, uint64_t(m_index.size()) );
+    for ( auto const & I : m_index ) {
+      putRaw( m_file, I.offset );
+      putRaw( m_file, I.zsize );
+      putRaw( m_file, I.rsize );
+      putRaw( m_file, I.nrec );
+      putRaw( m_file, uint32_t(I.problems.size()) );
+      for ( integer p : I.problems ) putRaw( m_file, int32_t(p) );
+    }
+    putRaw( m_file, index_offset );
+    m_file.write( record_magic, sizeof(record_magic) );
+    m_offset = uint64_t( m_file.tellp() );
+    bool ok = m_file.good();
+    m_file.close();
+    UTILS_ASSERT0( ok, "asyncRecordWriter::close, write failed" );
+  }
+
+  /*\
+   |  recordFileReader
+  \*/
+
+  recordFileReader::recordFileReader( string const & fname ) {
+    m_file.open( fname.c_str(), std::ios::in | std::ios::binary );
+    UTILS_ASSERT( m_file.good(), "recordFileReader, cannot open `{}`", fname );
+    char magic[sizeof(record_magic)];
+    m_file.read( magic, sizeof(magic) );
+    UTILS_ASSERT(
+      m_file.good() && std::memcmp( magic, record_magic, sizeof(magic) ) == 0,
+      "recordFileReader, `{}` is not a record file", fname
+    );
+    // trailer
+    m_file.seekg( -std::streamoff(8+sizeof(record_magic)), std::ios::end );
+    uint64_t index_offset;
+    getRaw( m_file, index_offset );
+    m_file.read( magic, sizeof(magic) );
+    UTILS_ASSERT(
+      m_file.good() && std::memcmp( magic, record_magic, sizeof(magic) ) == 0,
+      "recordFileReader, `{}` has no index (not closed?)", fname
+    );
+    // index
+    m_file.seekg( std::streamoff(index_offset), std::ios::beg );
+    uint64_t nframes;
+    getRaw( m_file, nframes );
+    m_index.resize( size_t(nframes) );
+    for ( auto & I : m_index ) {
+      uint32_t np;
+      getRaw( m_file, I.offset );
+      getRaw( m_file, I.zsize );
+      getRaw( m_file, I.rsize );
+      getRaw( m_file, I.nrec );
+      getRaw( m_file, np );
+      I.problems.resize( np );
+      for ( auto & p : I.problems ) {
+        int32_t p32;
+        getRaw( m_file, p32 );
+        p = p32;
+      }
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  uint64_t
+  recordFileReader::numRecords() const {
+    uint64_t nr = 0;
+    for ( auto const & I : m_index ) nr += I.nrec;
+    return nr;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  recordFileReader::problems( vector<integer> & P ) const {
+    P.clear();
+    for ( auto const & I : m_index ) P.insert( P.end(), I.problems.begin(), I.problems.end() );
+    std::sort( P.begin(), P.end() );
+    P.erase( std::unique( P.begin(), P.end() ), P.end() );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  recordFileReader::readFrame( integer k, vector<recordData> & R ) const {
+    UTILS_ASSERT(
+      k >= 0 && k < numFrames(),
+      "recordFileReader::readFrame, frame {} out of range", k
+    );
+    frameIndex const & I = m_index[size_t(k)];
+    m_file.clear();
+    m_file.seekg( std::streamoff(I.offset), std::ios::beg );
+    uint64_t zsize, rsize;
+    uint32_t nrec;
+    getRaw( m_file, zsize );
+    getRaw( m_file, rsize );
+    getRaw( m_file, nrec );
+    UTILS_ASSERT0(
+      zsize == I.zsize && rsize == I.rsize && nrec == I.nrec,
+      "recordFileReader::readFrame, frame header does not match the index"
+    );
+    string zs( size_t(zsize), '\0' );
+    m_file.read( &zs[0], std::streamsize(zsize) );
+    UTILS_ASSERT0( m_file.good(), "recordFileReader, truncated file" );
+
+    string raw( size_t(rsize), '\0' );
+    {
+      std::istringstream zbuffer( zs );
+      zstream::izstream  z( zbuffer );
+      z.read( &raw[0], std::streamsize(rsize) );
+      UTILS_ASSERT0(
+        uint64_t(z.gcount()) == rsize,
+        "recordFileReader::readFrame, corrupted frame"
+      );
+    }
+
+    char const * p   = raw.data();
+    char const * end = p + raw.size();
+    for ( uint32_t r = 0; r < nrec; ++r ) {
+      UTILS_ASSERT0( p + record_header_bytes <= end, "recordFileReader, corrupted frame" );
+      int32_t  h[4];
+      uint32_t nv;
+      std::memcpy( h, p, sizeof(h) );
+      std::memcpy( &nv, p+sizeof(h), sizeof(nv) );
+      p += record_header_bytes;
+      UTILS_ASSERT0( p + nv*sizeof(real_type) <= end, "recordFileReader, corrupted frame" );
+      R.push_back( recordData() );
+      recordData & D = R.back();
+      D.problem = h[0];
+      D.guess   = h[1];
+      D.solver  = h[2];
+      D.kind    = h[3];
+      D.values.resize( nv );
+      if ( nv > 0 ) std::memcpy( D.values.data(), p, nv*sizeof(real_type) );
+      p += nv*sizeof(real_type);
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  recordFileReader::readProblem( integer problem, vector<recordData> & R, integer kind ) const {
+    R.clear();
+    vector<recordData> tmp;
+    for ( integer k = 0; k < numFrames(); ++k ) {
+      vector<integer> const & P = m_index[size_t(k)].problems;
+      if ( !std::binary_search( P.begin(), P.end(), problem ) ) continue;
+      tmp.clear();
+      readFrame( k, tmp );
+      for ( auto & D : tmp )
+        if ( D.problem == problem && ( kind < 0 || D.kind == kind ) )
+          R.push_back( std::move(D) );
+    }
+  }
+
+}
@@ -0,0 +1,218 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+#ifndef NL_RECORD_FILE_HH
+#define NL_RECORD_FILE_HH
+
+#include "testsNonlin.hh"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace NLproblem {
+
+  //! predefined kinds of record, the others are free for the user
+  typedef enum {
+    RECORD_SOLUTION = 0, //!< final point of a run
+    RECORD_ITERATE,      //!< a point of the iterations
+    RECORD_RESIDUAL,     //!< a residual vector
+    RECORD_HISTORY,      //!< a history of scalars (e.g. ||F|| by iteration)
+    RECORD_USER = 100
+  } recordKind;
+
+  //! a record: a vector of reals tagged by problem, initial point, solver and kind
+  struct recordData {
+    integer           problem;
+    integer           guess;
+    integer           solver;
+    integer           kind;
+    vector<real_type> values;
+  };
+
+  /*\
+   |   ____                        _ _____ _ _
+   |  |  _ \ ___  ___ ___  _ __ __| |  ___(_) | ___
+   |  | |_) / _ \/ __/ _ \| '__/ _` | |_  | | |/ _ \
+   |  |  _ <  __/ (_| (_) | | | (_| |  _| | | |  __/
+   |  |_| \_\___|\___\___/|_|  \__,_|_|   |_|_|\___|
+  \*/
+
+  //!
+  //! Binary file of records written by frames.
+  //!
+  //!     magic "NLRECS" 0 1
+  //!     frames:  compressed size (uint64), raw size (uint64),
+  //!              number of records (uint32), zlib data
+  //!     index:   number of frames (uint64), then for each frame its
+  //!              offset, sizes, records and the sorted list of its
+  //!              problems
+  //!     trailer: offset of the index (uint64), magic
+  //!
+  //! A raw record is problem, guess, solver, kind (int32), the number of
+  //! values (uint32) and the values (double), in native byte order.
+  //!
+  //! `asyncRecordWriter` keeps a buffer for each slot (a worker thread
+  //! owns a slot, as the workers of `BatchRunner`), so appending a
+  //! record copies it into memory owned by the calling thread without
+  //! any lock. A full buffer (`frame_bytes`) is handed to a background
+  //! thread that compresses it with the zstream of Utils and writes the
+  //! frame; the slot continues on a spare buffer. When the background
+  //! thread falls behind by more than `max_pending` frames the slots
+  //! wait for it, so the memory stays bounded.
+  //!
+  class asyncRecordWriter {
+
+    asyncRecordWriter( asyncRecordWriter const & );
+    asyncRecordWriter const & operator = ( asyncRecordWriter const & );
+
+    struct frame {
+      string           raw;
+      uint32_t         nrec;
+      vector<integer>  problems;  // sorted, unique when written
+    };
+
+    struct frameIndex {
+      uint64_t        offset;
+      uint64_t        zsize;
+      uint64_t        rsize;
+      uint32_t        nrec;
+      vector<integer> problems;
+    };
+
+    // one for each slot, touched only by the thread owning the slot
+    struct slot {
+      frame buffer;
+      char  pad[64]; // keep the slots on different cache lines
+    };
+
+    vector<slot> m_slots;
+    size_t       m_frame_bytes;
+    size_t       m_max_pending;
+    integer      m_level;
+
+    std::ofstream m_file;
+    uint64_t      m_offset;
+
+    std::mutex              m_mtx;
+    std::condition_variable m_cv_work;  // frames to write
+    std::condition_variable m_cv_space; // room in the queue
+    std::deque<frame>       m_queue;
+    vector<string>          m_spares;   // buffers to reuse
+    bool                    m_busy;
+    bool                    m_closing;
+    std::thread             m_thread;
+
+    vector<frameIndex> m_index;
+
+    std::atomic<uint64_t> m_num_records;
+    uint64_t              m_raw_bytes;
+
+    void push( frame & F );
+    void background();
+    void writeFrame( frame & F );
+
+  public:
+
+    //!
+    //! Open `fname` for `nslots` writers, `level` is the zlib
+    //! compression level (0-9, -1 the default).
+    //!
+    asyncRecordWriter(
+      string const & fname,
+      unsigned       nslots,
+      size_t         frame_bytes = size_t(1) << 20,
+      integer        level       = -1,
+      size_t         max_pending = 0 // 0 = 2*nslots
+    );
+
+    ~asyncRecordWriter();
+
+    unsigned numSlots() const { return unsigned(m_slots.size()); }
+
+    //! append a record from the thread owning `slot`
+    void
+    append(
+      unsigned          slot,
+      integer           problem,
+      integer           guess,
+      integer           solver,
+      integer           kind,
+      real_type const * values,
+      integer           nvalues
+    );
+
+    void
+    append(
+      unsigned       slot,
+      integer        problem,
+      integer        guess,
+      integer        solver,
+      integer        kind,
+      dvec_t const & v
+    ) { append( slot, problem, guess, solver, kind, v.data(), integer(v.size()) ); }
+
+    //!
+    //! Write the partial buffers and wait for the background thread,
+    //! the slots must be idle.
+    //!
+    void flush();
+
+    //! flush, write the index and close the file (called by the destructor)
+    void close();
+
+    uint64_t numRecords()  const { return m_num_records; }
+    uint64_t rawBytes()    const { return m_raw_bytes; }
+    uint64_t fileBytes()   const { return m_offset; }
+  };
+
+  //!
+  //! Reader of the files of `asyncRecordWriter`: only the index is read
+  //! when opening, `readProblem` decompresses only the frames holding
+  //! records of the problem.
+  //!
+  class recordFileReader {
+
+    struct frameIndex {
+      uint64_t        offset;
+      uint64_t        zsize;
+      uint64_t        rsize;
+      uint32_t        nrec;
+      vector<integer> problems;
+    };
+
+    mutable std::ifstream m_file;
+    vector<frameIndex>    m_index;
+
+  public:
+
+    explicit recordFileReader( string const & fname );
+
+    integer numFrames() const { return integer(m_index.size()); }
+
+    uint64_t numRecords() const;
+
+    //! the problems with records in the file, sorted
+    void problems( vector<integer> & P ) const;
+
+    //! append the records of frame `k` to `R`
+    void readFrame( integer k, vector<recordData> & R ) const;
+
+    //! the records of `problem` (optionally only of `kind`, -1 = all)
+    void readProblem( integer problem, vector<recordData> & R, integer kind = -1 ) const;
+  };
+
+}
+
+#endif
@@ -0,0 +1,325 @@
+#include "NLreplay.hh"
+#include "Utils_zstream.hh"
+
+#include <chrono>
+#include <cstring>
+
+namespace NLproblem {
+
+  static char const replay_magic[8] = { 'N', 'L', 'E', 'V', 'T', 'R', 0, 1 };
+
+  template <typename T>
+  static
+  void
+  putRaw( std::ostream & stream, T const & v ) {
+    stream.write( reinterpret_cast<char const *>(&v), sizeof(T) );
+  }
+
+  template <typename T>
+  static
+  bool
+  getRaw( std::istream & stream, T & v ) {
+    stream.read( reinterpret_cast<char *>(&v), sizeof(T) );
+    return stream.gcount() == std::streamsize(sizeof(T));
+  }
+
+  /*\
+   |  nonlinearSystemRecorder
+  \*/
+
+  nonlinearSystemRecorder::nonlinearSystemRecorder(
+    nonlinearSystem const * P,
+    string          const & fname,
+    integer                 problem,
+    bool                    results
+  )
+  : nonlinearSystem( P )
+  , pNS(P)
+  , pNSmutable(nullptr)
+  , m_results(results)
+  , m_num_queries(0)
+  {
+    m_file.open( fname.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+    UTILS_ASSERT( m_file.good(), "nonlinearSystemRecorder, cannot open `{}`", fname );
+    m_stream.reset( new zstream::ozstream( m_file ) );
+    std::ostream & s = *m_stream;
+    s.write( replay_magic, sizeof(replay_magic) );
+    putRaw( s, int32_t(problem) );
+    putRaw( s, uint32_t(title().size()) );
+    s.write( title().data(), std::streamsize(title().size()) );
+    putRaw( s, int32_t(n) );
+    putRaw( s, int32_t(pNS->jacobianNnz()) );
+    putRaw( s, uint8_t(results ? 1 : 0) );
+  }
+
+  nonlinearSystemRecorder::nonlinearSystemRecorder(
+    nonlinearSystem       * P,
+    string          const & fname,
+    integer                 problem,
+    bool                    results
+  )
+  : nonlinearSystemRecorder( static_cast<nonlinearSystem const *>(P), fname, problem, results )
+  { pNSmutable = P; }
+
+  nonlinearSystemRecorder::~nonlinearSystemRecorder() {
+    try {
+      close();
+    } catch ( ... ) {
+      // nothing to do in a destructor
+    }
+  }
+
+  void
+  nonlinearSystemRecorder::close() {
+    std::lock_guard<std::mutex> lock( m_mtx );
+    if ( !m_stream ) return;
+    static_cast<zstream::ozstream&>( *m_stream ).close();
+    m_stream.reset();
+    bool ok = m_file.good();
+    m_file.close();
+    UTILS_ASSERT0( ok, "nonlinearSystemRecorder::close, write failed" );
+  }
+
+  void
+  nonlinearSystemRecorder::setParam( integer k, real_type value ) {
+    UTILS_ASSERT(
+      pNSmutable != nullptr,
+      "setParam, `{}` wraps a const problem", title()
+    );
+    pNSmutable->setParam( k, value );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  nonlinearSystemRecorder::record(
+    queryKind         kind,
+    bool              thrown,
+    integer           k,
+    dvec_t    const & x,
+    real_type const * res,
+    integer           nres
+  ) const {
+    std::lock_guard<std::mutex> lock( m_mtx );
+    UTILS_ASSERT0( m_stream, "nonlinearSystemRecorder, trace already closed" );
+    std::ostream & s = *m_stream;
+    putRaw( s, uint8_t(kind) );
+    putRaw( s, uint8_t(thrown ? 1 : 0) );
+    putRaw( s, int32_t(k) );
+    s.write( reinterpret_cast<char const *>(x.data()), std::streamsize(n*sizeof(real_type)) );
+    if ( m_results && !thrown )
+      s.write( reinterpret_cast<char const *>(res), std::streamsize(nres*sizeof(real_type)) );
+    ++m_num_queries;
+  }
+
+  real_type
+  nonlinearSystemRecorder::evalFk( dvec_t const & x, integer k ) const {
+    real_type res;
+    try {
+      res = pNS->evalFk( x, k );
+    } catch ( ... ) {
+      record( QUERY_EVAL_FK, true, k, x, nullptr, 0 );
+      throw;
+    }
+    record( QUERY_EVAL_FK, false, k, x, &res, 1 );
+    return res;
+  }
+
+  void
+  nonlinearSystemRecorder::evalF( dvec_t const & x, dvec_t & f ) const {
+    try {
+      pNS->evalF( x, f );
+    } catch ( ... ) {
+      record( QUERY_EVAL_F, true, 0, x, nullptr, 0 );
+      throw;
+    }
+    record( QUERY_EVAL_F, false, 0, x, f.data(), n );
+  }
+
+  void
+  nonlinearSystemRecorder::jacobian( dvec_t const & x, dvec_t & jac ) const {
+    try {
+      pNS->jacobian( x, jac );
+    } catch ( ... ) {
+      record( QUERY_JACOBIAN, true, 0, x, nullptr, 0 );
+      throw;
+    }
+    record( QUERY_JACOBIAN, false, 0, x, jac.data(), pNS->jacobianNnz() );
+  }
+
+  void
+  nonlinearSystemRecorder::fixedPointMap( dvec_t const & x, dvec_t & g ) const {
+    // the default map calls evalF of the recorder, already recorded
+    if ( !pNS->hasFixedPointForm() ) { nonlinearSystem::fixedPointMap( x, g ); return; }
+    try {
+      pNS->fixedPointMap( x, g );
+    } catch ( ... ) {
+      record( QUERY_FIXED_POINT, true, 0, x, nullptr, 0 );
+      throw;
+    }
+    record( QUERY_FIXED_POINT, false, 0, x, g.data(), n );
+  }
+
+  /*\
+   |  evaluationTrace
+  \*/
+
+  integer
+  evaluationTrace::resultSize( integer kind ) const {
+    switch ( kind ) {
+    case QUERY_EVAL_F:      return n;
+    case QUERY_EVAL_FK:     return 1;
+    case QUERY_JACOBIAN:    return nnz;
+    case QUERY_FIXED_POINT: return n;
+    }
+    return 0;
+  }
+
+  void
+  evaluationTrace::load( string const & fname ) {
+    std::ifstream file( fname.c_str(), std::ios::in | std::ios::binary );
+    UTILS_ASSERT( file.good(), "evaluationTrace::load, cannot open `{}`", fname );
+    zstream::izstream s( file );
+
+    char magic[sizeof(replay_magic)];
+    s.read( magic, sizeof(magic) );
+    UTILS_ASSERT(
+      s.gcount() == std::streamsize(sizeof(magic)) &&
+      std::memcmp( magic, replay_magic, sizeof(magic) ) == 0,
+      "evaluationTrace::load, `{}` is not an evaluation trace", fname
+    );
+    int32_t  p32, n32, nnz32;
+    uint32_t len;
+    uint8_t  res;
+    bool ok = getRaw( s, p32 ) && getRaw( s, len );
+    UTILS_ASSERT0( ok, "evaluationTrace::load, truncated header" );
+    title.resize( len );
+    if ( len > 0 ) s.read( &title[0], std::streamsize(len) );
+    ok = getRaw( s, n32 ) && getRaw( s, nnz32 ) && getRaw( s, res );
+    UTILS_ASSERT0( ok, "evaluationTrace::load, truncated header" );
+    problem = p32;
+    n       = n32;
+    nnz     = nnz32;
+    results = res != 0;
+
+    queries.clear();
+    X.clear();
+    R.clear();
+    while ( true ) {
+      uint8_t kind, thrown;
+      int32_t k;
+      if ( !getRaw( s, kind ) ) break; // end of the trace
+      ok = getRaw( s, thrown ) && getRaw( s, k ) && kind < QUERY_NUM_KINDS;
+      UTILS_ASSERT( ok, "evaluationTrace::load, bad query {}", queries.size() );
+      query q;
+      q.kind     = kind;
+      q.thrown   = thrown;
+      q.k        = k;
+      q.x_offset = X.size();
+      q.r_offset = R.size();
+      X.resize( X.size() + size_t(n) );
+      s.read( reinterpret_cast<char *>(&X[q.x_offset]), std::streamsize(n*sizeof(real_type)) );
+      ok = s.gcount() == std::streamsize(n*sizeof(real_type));
+      if ( ok && results && !thrown ) {
+        integer nr = resultSize( kind );
+        R.resize( R.size() + size_t(nr) );
+        s.read( reinterpret_cast<char *>(&R[q.r_offset]), std::streamsize(nr*sizeof(real_type)) );
+        ok = s.gcount() == std::streamsize(nr*sizeof(real_type));
+      }
+      UTILS_ASSERT( ok, "evaluationTrace::load, truncated query {}", queries.size() );
+      queries.push_back( q );
+    }
+  }
+
+  /*\
+   |  replay
+  \*/
+
+  void
+  replayTrace(
+    evaluationTrace const & T,
+    nonlinearSystem const & P,
+    integer                 repeat,
+    replayReport          & rep
+  ) {
+    typedef std::chrono::steady_clock clock_type;
+
+    UTILS_ASSERT(
+      P.numEqns() == T.n && P.jacobianNnz() == T.nnz,
+      "replayTrace, the trace has n = {}, nnz = {}, the problem n = {}, nnz = {}",
+      T.n, T.nnz, P.numEqns(), P.jacobianNnz()
+    );
+
+    rep.num_queries        = T.queries.size();
+    rep.num_compared       = 0;
+    rep.num_different      = 0;
+    rep.num_throw_mismatch = 0;
+    rep.max_abs_diff       = 0;
+    rep.first_different    = -1;
+    rep.total_ms           = real_max;
+    for ( integer k = 0; k < QUERY_NUM_KINDS; ++k ) {
+      rep.num_calls[k] = 0;
+      rep.ns[k]        = real_max;
+    }
+    for ( auto const & q : T.queries ) ++rep.num_calls[q.kind];
+
+    // one buffer per result size, `evalF` or `fixedPointMap` may assign
+    // the whole vector and resize it to `n`
+    dvec_t  x(T.n), f(T.n), jac(T.nnz);
+    integer nrep = max( repeat, 1 );
+    for ( integer r = 0; r < nrep; ++r ) {
+      real_type ns[QUERY_NUM_KINDS] = { 0, 0, 0, 0 };
+      for ( size_t iq = 0; iq < T.queries.size(); ++iq ) {
+        evaluationTrace::query const & q = T.queries[iq];
+        std::copy_n( &T.X[q.x_offset], T.n, x.data() );
+        dvec_t & out    = q.kind == QUERY_JACOBIAN ? jac : f;
+        bool     thrown = false;
+        clock_type::time_point t0 = clock_type::now();
+        try {
+          switch ( q.kind ) {
+          case QUERY_EVAL_F:      P.evalF( x, out );           break;
+          case QUERY_EVAL_FK:     out(0) = P.evalFk( x, q.k ); break;
+          case QUERY_JACOBIAN:    P.jacobian( x, out );        break;
+          case QUERY_FIXED_POINT: P.fixedPointMap( x, out );   break;
+          }
+        } catch ( ... ) {
+          thrown = true;
+        }
+        ns[q.kind] += real_type(
+          std::chrono::duration_cast<std::chrono::nanoseconds>( clock_type::now() - t0 ).count()
+        );
+        if ( r > 0 ) continue;
+
+        // compare with the recorded result
+        bool differ = thrown != ( q.thrown != 0 );
+        if ( differ ) ++rep.num_throw_mismatch;
+        if ( !differ && !thrown && T.results ) {
+          integer const     nr  = T.resultSize( q.kind );
+          real_type const * ref = &T.R[q.r_offset];
+          ++rep.num_compared;
+          if ( std::memcmp( ref, out.data(), size_t(nr)*sizeof(real_type) ) != 0 ) {
+            differ = true;
+            for ( integer i = 0; i < nr; ++i ) {
+              real_type d = std::abs( out(i) - ref[i] );
+              if ( d > rep.max_abs_diff || std::isnan(d) ) rep.max_abs_diff = d;
+            }
+          }
+        }
+        if ( differ ) {
+          ++rep.num_different;
+          if ( rep.first_different < 0 ) rep.first_different = int64_t(iq);
+        }
+      }
+      real_type tot = 0;
+      for ( integer k = 0; k < QUERY_NUM_KINDS; ++k ) {
+        rep.ns[k] = min( rep.ns[k], ns[k] );
+        tot      += ns[k];
+      }
+      rep.total_ms = min( rep.total_ms, tot*1e-6 );
+    }
+    // time per call
+    for ( integer k = 0; k < QUERY_NUM_KINDS; ++k )
+      rep.ns[k] = rep.num_calls[k] > 0 ? rep.ns[k] / real_type(rep.num_calls[k]) : 0;
+  }
+
+}
@@ -0,0 +1,235 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+#ifndef NL_REPLAY_HH
+#define NL_REPLAY_HH
+
+#include "testsNonlin.hh"
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace NLproblem {
+
+  //! evaluation routines recorded by `nonlinearSystemRecorder`
+  typedef enum {
+    QUERY_EVAL_F = 0,
+    QUERY_EVAL_FK,
+    QUERY_JACOBIAN,
+    QUERY_FIXED_POINT,
+    QUERY_NUM_KINDS
+  } queryKind;
+
+  /*\
+   |   ____                        _
+   |  |  _ \ ___  ___ ___  _ __ __| | ___ _ __
+   |  | |_) / _ \/ __/ _ \| '__/ _` |/ _ \ '__|
+   |  |  _ <  __/ (_| (_) | | | (_| |  __/ |
+   |  |_| \_\___|\___\___/|_|  \__,_|\___|_|
+  \*/
+
+  //!
+  //! Forward every call to a `nonlinearSystem` and log the points where
+  //! `evalF`, `evalFk`, `jacobian` and a native `fixedPointMap` are
+  //! called, with their results (optional) or the exception they threw,
+  //! into a compressed binary trace (zstream of Utils)
+  //!
+  //!     magic "NLEVTR" 0 1, problem index (int32), title, n, nnz (int32),
+  //!     results recorded (uint8)
+  //!     queries: kind (uint8), thrown (uint8), k (int32), x (n doubles),
+  //!              the result if recorded and not thrown (n, 1, nnz or n
+  //!              doubles)
+  //!
+  //! in native byte order. The calls are serialized by a mutex, so the
+  //! order of the trace is the order of the calls also when a solver
+  //! evaluates from many threads. The trace is complete after `close`
+  //! (or the destructor).
+  //!
+  class nonlinearSystemRecorder : public nonlinearSystem {
+
+    nonlinearSystemRecorder( nonlinearSystemRecorder const & );
+    nonlinearSystemRecorder const & operator = ( nonlinearSystemRecorder const & );
+
+    nonlinearSystem const * pNS;
+    nonlinearSystem       * pNSmutable; // nullptr if built on a const problem
+
+    std::ofstream                 m_file;
+    std::unique_ptr<std::ostream> m_stream; // compressing m_file
+    bool                          m_results;
+
+    mutable std::mutex m_mtx;
+    mutable uint64_t   m_num_queries;
+
+    void
+    record(
+      queryKind         kind,
+      bool              thrown,
+      integer           k,
+      dvec_t    const & x,
+      real_type const * res,
+      integer           nres
+    ) const;
+
+  public:
+
+    //!
+    //! Record the queries to `P` into `fname`, `problem` is the index of
+    //! `P` in `theProblems` (-1 if not from the catalogue), with
+    //! `results` the results are recorded too.
+    //!
+    nonlinearSystemRecorder(
+      nonlinearSystem const * P,
+      string          const & fname,
+      integer                 problem = -1,
+      bool                    results = true
+    );
+
+    //! as above, `setParam` is forwarded to `P`
+    nonlinearSystemRecorder(
+      nonlinearSystem       * P,
+      string          const & fname,
+      integer                 problem = -1,
+      bool                    results = true
+    );
+
+    ~nonlinearSystemRecorder();
+
+    nonlinearSystem const * problem() const { return pNS; }
+
+    uint64_t numQueries() const { return m_num_queries; }
+
+    //! complete the trace and close the file
+    void close();
+
+    real_type evalFk( dvec_t const & x, integer k ) const override;
+    void      evalF( dvec_t const & x, dvec_t & f ) const override;
+    void      jacobian( dvec_t const & x, dvec_t & jac ) const override;
+    void      fixedPointMap( dvec_t const & x, dvec_t & g ) const override;
+
+    integer jacobianNnz() const override { return pNS->jacobianNnz(); }
+
+    void
+    jacobianPattern( ivec_t & i, ivec_t & j ) const override
+    { pNS->jacobianPattern( i, j ); }
+
+    integer numExactSolution() const override { return pNS->numExactSolution(); }
+
+    void
+    getExactSolution( dvec_t & x, integer idx ) const override
+    { pNS->getExactSolution( x, idx ); }
+
+    integer numInitialPoint() const override { return pNS->numInitialPoint(); }
+
+    void
+    getInitialPoint( dvec_t & x, integer idx ) const override
+    { pNS->getInitialPoint( x, idx ); }
+
+    void
+    checkIfAdmissible( dvec_t const & x ) const override
+    { pNS->checkIfAdmissible( x ); }
+
+    void
+    boundingBox( dvec_t & L, dvec_t & U ) const override
+    { pNS->boundingBox( L, U ); }
+
+    admissibleStatus
+    isAdmissible( dvec_t const & x, integer & which ) const noexcept override
+    { return pNS->isAdmissible( x, which ); }
+
+    bool
+    projectToDomain( dvec_t & x ) const noexcept override
+    { return pNS->projectToDomain( x ); }
+
+    bool hasFixedPointForm() const override { return pNS->hasFixedPointForm(); }
+    bool isThreadSafe()      const override { return pNS->isThreadSafe(); }
+    bool isPolynomial()      const override { return pNS->isPolynomial(); }
+
+    void
+    polynomialForm( polynomialTerms & terms ) const override
+    { pNS->polynomialForm( terms ); }
+
+    //!
+    //! The parameters are not part of the trace: a trace recorded
+    //! along a continuation is replayed with the values of the
+    //! replaying instance.
+    //!
+    integer   numParams()            const override { return pNS->numParams(); }
+    string    paramName( integer k ) const override { return pNS->paramName( k ); }
+    real_type getParam( integer k )  const override { return pNS->getParam( k ); }
+
+    void setParam( integer k, real_type value ) override;
+
+    void
+    dFdp( dvec_t const & x, integer k, dvec_t & dfdp ) const override
+    { pNS->dFdp( x, k, dfdp ); }
+  };
+
+  //!
+  //! A trace of `nonlinearSystemRecorder` loaded in memory: the points
+  //! of all the queries are stored one after the other in `X`, the
+  //! results in `R`.
+  //!
+  class evaluationTrace {
+  public:
+
+    struct query {
+      uint8_t  kind;
+      uint8_t  thrown;
+      integer  k;
+      uint64_t x_offset; //!< first entry in X
+      uint64_t r_offset; //!< first entry in R (if results and not thrown)
+    };
+
+    integer           problem;
+    string            title;
+    integer           n;
+    integer           nnz;
+    bool              results;
+    vector<query>     queries;
+    vector<real_type> X;
+    vector<real_type> R;
+
+    //! size of the result of a query of kind `kind`
+    integer resultSize( integer kind ) const;
+
+    void load( string const & fname );
+  };
+
+  //! outcome of `replayTrace`
+  struct replayReport {
+    uint64_t  num_queries;
+    uint64_t  num_calls[QUERY_NUM_KINDS];
+    real_type ns[QUERY_NUM_KINDS];       //!< minimum over the repetitions
+    real_type total_ms;                  //!< minimum over the repetitions
+    uint64_t  num_compared;              //!< results compared
+    uint64_t  num_different;             //!< queries with a different result or exception
+    uint64_t  num_throw_mismatch;        //!< thrown now and not then or vice versa
+    real_type max_abs_diff;
+    int64_t   first_different;           //!< index of the query, -1 if none
+  };
+
+  //!
+  //! Rerun the queries of `T` on `P` (same number of equations and of
+  //! nonzeros) `repeat` times, time them and compare the results of the
+  //! first repetition bitwise with the recorded ones (when recorded).
+  //!
+  void
+  replayTrace(
+    evaluationTrace const & T,
+    nonlinearSystem const & P,
+    integer                 repeat,
+    replayReport          & rep
+  );
+
+}
+
+#endif
@@ -0,0 +1,242 @@
+#include "NLsolver.hh"
+#include <algorithm>
+
+namespace NLproblem {
+
+  /*\
+   |  sparseJacobian
+  \*/
+
+  void
+  sparseJacobian::setup( nonlinearSystem const & P ) {
+    integer const n = P.numEqns();
+    m_nnz = P.jacobianNnz();
+
+    ivec_t I( m_nnz ), J( m_nnz );
+    P.jacobianPattern( I, J );
+
+    // the diagonal is always stored so that shifted or identity
+    // matrices can be built on the same pattern
+    typedef Eigen::Triplet<real_type,integer> T;
+    vector<T> triplets;
+    triplets.reserve( size_t(m_nnz+n) );
+    for ( integer k = 0; k < m_nnz; ++k ) {
+      UTILS_ASSERT(
+        I(k) >= 0 && I(k) < n && J(k) >= 0 && J(k) < n,
+        "sparseJacobian::setup, bad pattern (i,j) = ({},{}) at k = {}",
+        I(k), J(k), k
+      );
+      triplets.push_back( T( I(k), J(k), 1 ) );
+    }
+    for ( integer k = 0; k < n; ++k ) triplets.push_back( T( k, k, 0 ) );
+
+    m_J.resize( n, n );
+    m_J.setFromTriplets( triplets.begin(), triplets.end() );
+    m_J.makeCompressed();
+
+    // map each nonzero to its position in the compressed storage
+    integer const * outer = m_J.outerIndexPtr();
+    integer const * inner = m_J.innerIndexPtr();
+    m_pos.resize( m_nnz );
+    for ( integer k = 0; k < m_nnz; ++k ) {
+      integer const * lo = inner + outer[J(k)];
+      integer const * hi = inner + outer[J(k)+1];
+      integer const * p  = std::lower_bound( lo, hi, I(k) );
+      m_pos(k) = integer( p - inner );
+    }
+    m_values.resize( m_nnz );
+    m_J.coeffs().setZero();
+
+    m_LU.analyzePattern( m_J );
+    m_factorized = false;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  integer
+  sparseJacobian::eval( nonlinearSystem const & P, dvec_t const & x ) {
+    P.jacobian( x, m_values );
+    real_type * V = m_J.valuePtr();
+    m_J.coeffs().setZero();
+    uint64_t bad = 0;
+    for ( integer k = 0; k < m_nnz; ++k ) {
+      V[m_pos(k)] += m_values(k);
+      bad |= nonFiniteBit( m_values(k) );
+    }
+    m_factorized = false;
+    return bad == 0 ? -1 : firstNonFinite( m_values.data(), m_nnz );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  sparseJacobian::factorize() {
+    m_LU.factorize( m_J );
+    m_factorized = m_LU.info() == Eigen::Success;
+    return m_factorized;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  sparseJacobian::solve( dvec_t const & b, dvec_t & x ) const {
+    UTILS_ASSERT0( m_factorized, "sparseJacobian::solve, matrix not factorized" );
+    x = m_LU.solve( b );
+  }
+
+  /*\
+   |  NLsolver
+  \*/
+
+  NLsolver::NLsolver( string const & name )
+  : m_name(name)
+  , m_tolerance(1e-10)
+  , m_max_iter(200)
+  , m_alpha(1e-4)
+  , m_lambda_min(1e-10)
+  , m_cancel(nullptr)
+  , m_outer_cancel(nullptr)
+  , m_max_num_F( numeric_limits<integer>::max() )
+  , m_time_budget_ms(0)
+  , m_shared_F(nullptr)
+  , m_shared_max_F(0)
+  , m_published_F(0)
+  {
+    resetStatistics();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  NLsolver::resetStatistics() {
+    m_num_iter      = 0;
+    m_num_F         = 0;
+    m_num_J         = 0;
+    m_num_factorize = 0;
+    m_norm_F        = real_max;
+    m_elapsed_ms    = 0;
+    m_converged     = false;
+    m_stopped       = false;
+    m_published_F   = 0;
+    if ( m_time_budget_ms > 0 )
+      m_deadline = std::chrono::steady_clock::now() +
+                   std::chrono::microseconds( static_cast<long long>( 1000*m_time_budget_ms ) );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  NLsolver::delegateLimits(
+    NLsolver                & S,
+    std::atomic<bool> const * cancel,
+    std::atomic<bool> const * outer,
+    std::atomic<integer>    * counter
+  ) const {
+    S.setCancelFlag( cancel );
+    S.setOuterCancelFlag( outer );
+    if ( m_time_budget_ms > 0 ) {
+      auto left = std::chrono::duration_cast<std::chrono::microseconds>(
+        m_deadline - std::chrono::steady_clock::now()
+      );
+      S.setTimeBudget( max( real_type(left.count())/1000, real_type(1e-3) ) );
+    }
+    // the evaluations left also of the budget this run shares with others
+    integer max_F = m_max_num_F;
+    if ( m_shared_F != nullptr )
+      max_F = min( max_F, m_published_F + m_shared_max_F - m_shared_F->load() );
+    if ( max_F < numeric_limits<integer>::max() )
+      S.shareEvaluations( counter, max_F );
+    else
+      S.shareEvaluations( nullptr, 0 );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  NLsolver::lineSearch(
+    nonlinearSystem const & P,
+    dvec_t          const & x,
+    real_type               normF,
+    dvec_t          const & d,
+    dvec_t                & x1,
+    dvec_t                & F1,
+    real_type             & normF1,
+    real_type             & lambda
+  ) {
+    NL_TRACE_SCOPE( "lineSearch", m_num_iter );
+    lambda = 1;
+    if ( firstNonFinite( d ) >= 0 ) return false; // every trial point would be NaN
+    while ( lambda >= m_lambda_min ) {
+      x1 = x + lambda * d;
+      if ( isAdmissible( P, x1 ) && safeEvalF( P, x1, F1 ) ) {
+        normF1 = F1.norm();
+        if ( std::isfinite(normF1) ) {
+          if ( normF1 <= (1-m_alpha*lambda) * normF ) return true;
+          // safeguarded minimum of the quadratic model of ||F||^2/2
+          real_type f0 = normF*normF;
+          real_type f1 = normF1*normF1;
+          real_type lq = lambda*lambda*f0 / ( f1 + (2*lambda-1)*f0 );
+          lambda = max( 0.1*lambda, min( 0.5*lambda, lq ) );
+          continue;
+        }
+      }
+      lambda *= 0.5;
+    }
+    return false;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  NLsolver::info( ostream_type & stream ) const {
+    fmt::print(
+      stream,
+      "{:<12} {:<4} iter = {:<5} #F = {:<6} #J = {:<5} #LU = {:<5} "
+      "||F|| = {:<12.5} [{:.3} ms]\n",
+      m_name, m_converged ? "OK" : "FAIL",
+      m_num_iter, m_num_F, m_num_J, m_num_factorize,
+      m_norm_F, m_elapsed_ms
+    );
+  }
+
+  /*\
+   |  NewtonSolver
+  \*/
+
+  bool
+  NewtonSolver::solve( nonlinearSystem const & P, dvec_t & x ) {
+    Utils::TicToc tictoc;
+    tictoc.tic();
+    resetStatistics();
+
+    integer const n = P.numEqns();
+    dvec_t F(n), F1(n), x1(n), d(n);
+
+    m_jac.setup( P );
+
+    evalF( P, x, F );
+    m_norm_F = F.norm();
+
+    for ( m_num_iter = 0; m_num_iter < m_max_iter; ++m_num_iter ) {
+      if ( F.lpNorm<Eigen::Infinity>() <= m_tolerance ) {
+        m_converged = true;
+        break;
+      }
+      if ( stopRequested() ) break;
+      if ( !evalJ( P, x, m_jac ) || !factorize( m_jac ) ) break;
+      m_jac.solve( F, d );
+      d = -d;
+      real_type lambda, normF1;
+      if ( !lineSearch( P, x, m_norm_F, d, x1, F1, normF1, lambda ) ) break;
+      x.swap(x1);
+      F.swap(F1);
+      m_norm_F = normF1;
+    }
+    if ( !m_converged ) m_converged = F.lpNorm<Eigen::Infinity>() <= m_tolerance;
+
+    tictoc.toc();
+    m_elapsed_ms = tictoc.elapsed_ms();
+    return m_converged;
+  }
+
+}
@@ -0,0 +1,368 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+#ifndef NL_SOLVER_HH
+#define NL_SOLVER_HH
+
+#include "testsNonlin.hh"
+#include "NLtrace.hh"
+
+#include <Eigen/Sparse>
+#include <Eigen/SparseLU>
+
+#include <atomic>
+#include <chrono>
+
+namespace NLproblem {
+
+  //! compressed column storage used by the sparse factorizations
+  typedef Eigen::SparseMatrix<real_type,Eigen::ColMajor,integer> spmat_t;
+
+  /*\
+   |                                     _                _     _
+   |   ___ _ __   __ _ _ __ ___  ___    | | __ _  ___ ___ | |__ (_) __ _ _ __
+   |  / __| '_ \ / _` | '__/ __|/ _ \_  | |/ _` |/ __/ _ \| '_ \| |/ _` | '_ \
+   |  \__ \ |_) | (_| | |  \__ \  __/ |_| | (_| | (_| (_) | |_) | | (_| | | | |
+   |  |___/ .__/ \__,_|_|  |___/\___|\___/ \__,_|\___\___/|_.__/|_|\__,_|_| |_|
+   |      |_|
+  \*/
+
+  //!
+  //! Sparse jacobian of a `nonlinearSystem`.
+  //!
+  //! The pattern is read once by `setup`, the symbolic analysis of the
+  //! LU factorization is done once, then `eval` and `factorize` only
+  //! touch the numerical values.
+  //!
+  class sparseJacobian {
+
+    typedef Eigen::SparseLU<spmat_t,Eigen::COLAMDOrdering<integer> > LU_t;
+
+    sparseJacobian( sparseJacobian const & );
+    sparseJacobian const & operator = ( sparseJacobian const & );
+
+    spmat_t m_J;
+    ivec_t  m_pos;    // position in m_J.valuePtr() of the k-th nonzero
+    dvec_t  m_values; // values as returned by jacobian()
+    LU_t    m_LU;
+    integer m_nnz;
+    bool    m_factorized;
+
+  public:
+
+    sparseJacobian() : m_nnz(0), m_factorized(false) {}
+
+    //! read the pattern of `P` and do the symbolic analysis
+    void setup( nonlinearSystem const & P );
+
+    //!
+    //! Evaluate the jacobian values at `x`, -1 if they are all finite,
+    //! otherwise the position in the pattern of the first inf or NaN
+    //! (checked while the values are copied in the matrix).
+    //!
+    integer eval( nonlinearSystem const & P, dvec_t const & x );
+
+    //! numerical factorization, `false` if the matrix is singular
+    bool factorize();
+
+    //! solve `J*x = b` using the last factorization
+    void solve( dvec_t const & b, dvec_t & x ) const;
+
+    //! matrix-vector product `res = J*v`
+    void mult( dvec_t const & v, dvec_t & res ) const { res = m_J * v; }
+
+    //! matrix-vector product `res = J^T*v`
+    void mult_transposed( dvec_t const & v, dvec_t & res ) const
+    { res = m_J.transpose() * v; }
+
+    bool            isFactorized() const { return m_factorized; }
+    integer         nnz()          const { return m_nnz; }
+
+    //!
+    //! position in `matrix().valuePtr()` of the `k`-th nonzero of
+    //! `jacobianPattern`, the other stored entries are the padding of
+    //! the diagonal
+    //!
+    ivec_t const & positions() const { return m_pos; }
+
+    spmat_t const & matrix()       const { return m_J; }
+    spmat_t       & matrix()             { return m_J; }
+
+  };
+
+  /*\
+   |   _   _ _     ____        _
+   |  | \ | | |   / ___|  ___ | |_   _____ _ __
+   |  |  \| | |   \___ \ / _ \| \ \ / / _ \ '__|
+   |  | |\  | |___ ___) | (_) | |\ V /  __/ |
+   |  |_| \_|_____|____/ \___/|_| \_/ \___|_|
+  \*/
+
+  //!
+  //! Base class of the nonlinear solvers.
+  //!
+  //! Keeps the common parameters (tolerance on \f$ \|F\|_\infty \f$,
+  //! maximum number of iterations), the statistics of the last run
+  //! and a backtracking line search on \f$ \|F\|_2 \f$.
+  //!
+  class NLsolver {
+
+    NLsolver( NLsolver const & );
+    NLsolver const & operator = ( NLsolver const & );
+
+  protected:
+
+    string const m_name;
+
+    // parameters
+    real_type m_tolerance;
+    integer   m_max_iter;
+    real_type m_alpha;      // sufficient decrease parameter
+    real_type m_lambda_min; // minimum line search step
+
+    // cooperative cancellation and budgets, checked once per iteration
+    std::atomic<bool> const * m_cancel;
+    std::atomic<bool> const * m_outer_cancel; // of the caller of a container solver
+    integer                   m_max_num_F;
+    real_type                 m_time_budget_ms;
+
+    std::chrono::steady_clock::time_point m_deadline;
+
+    // budget of evaluations shared with other solvers (see shareEvaluations)
+    std::atomic<integer>         * m_shared_F;
+    integer                        m_shared_max_F;
+    mutable std::atomic<integer>   m_published_F; // of this run, added to m_shared_F
+
+    // statistics of the last run
+    integer   m_num_iter;
+    integer   m_num_F;
+    integer   m_num_J;
+    integer   m_num_factorize;
+    real_type m_norm_F;
+    real_type m_elapsed_ms;
+    bool      m_converged;
+    bool      m_stopped;
+
+    void resetStatistics();
+
+    //! add the evaluations of this run up to `num_F` to the shared budget
+    void
+    publishEvaluations( integer num_F ) const {
+      if ( m_shared_F == nullptr ) return;
+      integer old = m_published_F.load();
+      while ( old < num_F ) {
+        if ( m_published_F.compare_exchange_weak( old, num_F ) ) {
+          *m_shared_F += num_F - old;
+          break;
+        }
+      }
+    }
+
+    //!
+    //! `true` if a run that used `num_F` residual evaluations must stop:
+    //! cancelled from another thread or out of the budget of residual
+    //! evaluations (also the shared one) or of wall time. Thread safe,
+    //! the workers of the parallel solvers call it with the evaluations
+    //! they counted.
+    //!
+    bool
+    mustStop( integer num_F ) const {
+      publishEvaluations( num_F );
+      return ( m_cancel != nullptr && m_cancel->load( std::memory_order_relaxed ) ) ||
+             ( m_outer_cancel != nullptr && m_outer_cancel->load( std::memory_order_relaxed ) ) ||
+             num_F >= m_max_num_F ||
+             ( m_shared_F != nullptr && m_shared_F->load( std::memory_order_relaxed ) >= m_shared_max_F ) ||
+             ( m_time_budget_ms > 0 && std::chrono::steady_clock::now() >= m_deadline );
+    }
+
+    //! `mustStop` of the sequential solvers, it sets `stopped()`
+    bool
+    stopRequested() {
+      m_stopped = mustStop( m_num_F );
+      return m_stopped;
+    }
+
+    //!
+    //! Give to the solver `S` run by this one the cancel flags `cancel`
+    //! and `outer`, the wall time left and the budget of evaluations
+    //! of this run, shared through `counter` (the evaluations of the run
+    //! so far), capped by what is left of the budget this run shares.
+    //! The budgets of `S` are kept when this one has none.
+    //!
+    void
+    delegateLimits(
+      NLsolver                & S,
+      std::atomic<bool> const * cancel,
+      std::atomic<bool> const * outer,
+      std::atomic<integer>    * counter
+    ) const;
+
+    void
+    evalF( nonlinearSystem const & P, dvec_t const & x, dvec_t & f ) {
+      NL_TRACE_SCOPE( "evalF", m_num_F );
+      ++m_num_F;
+      P.evalF( x, f );
+    }
+
+    //! as `evalF`, `false` if some entry of `f` is inf or NaN
+    bool
+    safeEvalF( nonlinearSystem const & P, dvec_t const & x, dvec_t & f ) {
+      NL_TRACE_SCOPE( "evalF", m_num_F );
+      ++m_num_F;
+      return P.safeEvalF( x, f ) < 0;
+    }
+
+    //! `false` if some value of the jacobian is inf or NaN
+    bool
+    evalJ(
+      nonlinearSystem const & P,
+      dvec_t          const & x,
+      sparseJacobian        & J
+    ) {
+      NL_TRACE_SCOPE( "jacobian", m_num_J );
+      ++m_num_J;
+      return J.eval( P, x ) < 0;
+    }
+
+    bool
+    factorize( sparseJacobian & J ) {
+      NL_TRACE_SCOPE( "factorize", m_num_factorize );
+      ++m_num_factorize;
+      return J.factorize();
+    }
+
+    //! `true` if `x` is in the domain of `P` (no exceptions thrown)
+    static
+    bool
+    isAdmissible( nonlinearSystem const & P, dvec_t const & x ) {
+      integer which;
+      return P.isAdmissible( x, which ) == POINT_ADMISSIBLE;
+    }
+
+    //!
+    //! Backtracking line search along `d` starting from `x`.
+    //!
+    //! Accept `x1 = x + lambda*d` when \f$ \|F(x_1)\| \leq (1-\alpha\lambda)\|F(x)\| \f$,
+    //! non admissible points or non finite residuals reduce the step,
+    //! a non finite direction fails at once.
+    //! On exit `x1`, `F1` and `normF1` contain the accepted point.
+    //!
+    bool
+    lineSearch(
+      nonlinearSystem const & P,
+      dvec_t          const & x,
+      real_type               normF,
+      dvec_t          const & d,
+      dvec_t                & x1,
+      dvec_t                & F1,
+      real_type             & normF1,
+      real_type             & lambda
+    );
+
+  public:
+
+    explicit NLsolver( string const & name );
+
+    virtual ~NLsolver() {}
+
+    string const & name() const { return m_name; }
+
+    void setTolerance( real_type tol ) { m_tolerance = tol; }
+    void setMaxIterations( integer mit ) { m_max_iter = mit; }
+
+    //!
+    //! Flag polled at the iteration boundary: when it is raised by
+    //! another thread `solve` stops as not converged. `nullptr` (the
+    //! default) disables the check. All the solvers poll the flag and
+    //! the budgets below, the parallel ones at their natural steps: per
+    //! path step (`HomotopySolver`), per box (`IntervalSolver`), per
+    //! Newton step (`DeflationSolver`), per batch and per local solve
+    //! (`MultiStartSolver`).
+    //!
+    void setCancelFlag( std::atomic<bool> const * flag ) { m_cancel = flag; }
+
+    //!
+    //! Second flag polled as the cancel flag, for a solver run inside
+    //! another one (see `PortfolioSolver`): the flag of the container
+    //! and the flag given to the container both stop the run.
+    //!
+    void setOuterCancelFlag( std::atomic<bool> const * flag ) { m_outer_cancel = flag; }
+
+    //! budget of residual evaluations of a run
+    void setMaxEvaluations( integer mfe ) { m_max_num_F = mfe; }
+
+    //! budget of wall time of a run, no limit if not positive
+    void setTimeBudget( real_type ms ) { m_time_budget_ms = ms; }
+
+    //!
+    //! Budget of residual evaluations shared by several solvers (see
+    //! `PortfolioSolver`): the solver adds its evaluations to `counter`
+    //! when it polls the budgets and stops when `counter` reaches
+    //! `max_F`. `nullptr` (the default) disables the check.
+    //!
+    void
+    shareEvaluations( std::atomic<integer> * counter, integer max_F )
+    { m_shared_F = counter; m_shared_max_F = max_F; }
+
+    //! add to the shared counter the evaluations of the last run not yet added
+    void flushEvaluations() const { publishEvaluations( m_num_F ); }
+
+    //!
+    //! Solve \f$ F(x) = 0 \f$ starting from `x`, on exit `x` contains
+    //! the last iterate. Return `true` if converged.
+    //!
+    virtual bool solve( nonlinearSystem const & P, dvec_t & x ) = 0;
+
+    real_type tolerance()    const { return m_tolerance; }
+    integer   maxIter()      const { return m_max_iter; }
+    integer   numIter()      const { return m_num_iter; }
+    integer   numF()         const { return m_num_F; }
+    integer   numJ()         const { return m_num_J; }
+    integer   numFactorize() const { return m_num_factorize; }
+    real_type normF()        const { return m_norm_F; }
+    real_type elapsedMs()    const { return m_elapsed_ms; }
+    bool      converged()    const { return m_converged; }
+
+    //! `true` if the last run was stopped by cancellation or by a budget
+    bool      stopped()      const { return m_stopped; }
+
+    void info( ostream_type & stream ) const;
+
+  };
+
+  /*\
+   |   _   _                _
+   |  | \ | | _____      _| |_ ___  _ __
+   |  |  \| |/ _ \ \ /\ / / __/ _ \| '_ \
+   |  | |\  |  __/\ V  V /| || (_) | | | |
+   |  |_| \_|\___| \_/\_/  \__\___/|_| |_|
+  \*/
+
+  //!
+  //! Damped Newton method with sparse LU and reused symbolic analysis.
+  //! A jacobian evaluation and a factorization for each iteration.
+  //!
+  class NewtonSolver : public NLsolver {
+
+    sparseJacobian m_jac;
+
+  public:
+
+    NewtonSolver() : NLsolver("Newton") {}
+
+    virtual ~NewtonSolver() {}
+
+    bool solve( nonlinearSystem const & P, dvec_t & x ) override;
+
+  };
+
+}
+
+#endif
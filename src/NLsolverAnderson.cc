@@ -0,0 +1,185 @@
+#include "NLsolverAnderson.hh"
+
+namespace NLproblem {
+
+  AndersonSolver::AndersonSolver( integer depth, real_type beta )
+  : NLsolver("Anderson")
+  , m_depth(depth)
+  , m_beta(beta)
+  , m_drop_tol(1e10)
+  , m_restart_ratio(1e4)
+  , m_len(0)
+  , m_num_restart(0)
+  {
+    UTILS_ASSERT(
+      depth > 0, "AndersonSolver, depth must be positive, m = {}", depth
+    );
+    UTILS_ASSERT(
+      beta > 0 && beta <= 1, "AndersonSolver, beta = {} must be in (0,1]", beta
+    );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  AndersonSolver::appendColumn( dvec_t & df, dvec_t const & dg ) {
+    // modified Gram-Schmidt against the current columns of Q
+    for ( integer j = 0; j < m_len; ++j ) {
+      real_type rj = m_Q.col(j).dot(df);
+      m_R(j,m_len) = rj;
+      df -= rj * m_Q.col(j);
+    }
+    real_type nrm = df.norm();
+    if ( nrm == 0 ) return; // linearly dependent, skip it
+    m_R(m_len,m_len) = nrm;
+    m_Q.col(m_len)   = df / nrm;
+    m_DG.col(m_len)  = dg;
+    ++m_len;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  AndersonSolver::deleteFirstColumn() {
+    // R without the first column is upper Hessenberg,
+    // Givens rotations bring it back to triangular form
+    for ( integer i = 0; i < m_len-1; ++i ) {
+      real_type a = m_R(i,i+1);
+      real_type b = m_R(i+1,i+1);
+      real_type r = std::hypot( a, b );
+      if ( r == 0 ) continue;
+      real_type c = a/r;
+      real_type s = b/r;
+      m_R(i,i+1)   = r;
+      m_R(i+1,i+1) = 0;
+      for ( integer j = i+2; j < m_len; ++j ) {
+        real_type t1 = m_R(i,j);
+        real_type t2 = m_R(i+1,j);
+        m_R(i,j)   = c*t1 + s*t2;
+        m_R(i+1,j) = c*t2 - s*t1;
+      }
+      dvec_t qi = m_Q.col(i);
+      m_Q.col(i)   = c*qi + s*m_Q.col(i+1);
+      m_Q.col(i+1) = c*m_Q.col(i+1) - s*qi;
+    }
+    for ( integer j = 0; j < m_len-1; ++j ) {
+      m_R.col(j).head(m_len-1) = m_R.col(j+1).head(m_len-1);
+      m_DG.col(j) = m_DG.col(j+1);
+    }
+    m_R.col(m_len-1).setZero();
+    m_R.row(m_len-1).setZero();
+    --m_len;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  AndersonSolver::conditionR() const {
+    Eigen::JacobiSVD<dmat_t> svd( m_R.topLeftCorner(m_len,m_len) );
+    dvec_t const & sv = svd.singularValues();
+    real_type smin = sv(m_len-1);
+    if ( smin <= 0 ) return real_max;
+    return sv(0)/smin;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  AndersonSolver::solve( nonlinearSystem const & P, dvec_t & x ) {
+    Utils::TicToc tictoc;
+    tictoc.tic();
+    resetStatistics();
+    m_num_restart = 0;
+
+    integer const n = P.numEqns();
+    dvec_t g(n), f(n), g_old(n), f_old(n), df(n), dg(n), gamma;
+
+    m_Q.resize( n, m_depth );
+    m_DG.resize( n, m_depth );
+    m_R.setZero( m_depth, m_depth );
+    m_len = 0;
+
+    bool      has_old = false;
+    bool      done    = false;
+    real_type normf   = real_max;
+    real_type best    = real_max;
+    dvec_t    x_best(n), f_best(n);
+    real_type damp    = m_beta; // step of the safeguarded Picard restart
+
+    for ( m_num_iter = 0; m_num_iter < m_max_iter; ++m_num_iter ) {
+      ++m_num_F;
+      P.fixedPointMap( x, g );
+      f     = g - x;
+      normf = f.norm();
+
+      if ( std::isfinite(normf) && f.lpNorm<Eigen::Infinity>() <= m_tolerance ) {
+        done = true;
+        break;
+      }
+      if ( stopRequested() ) break;
+
+      if ( !std::isfinite(normf) || normf > m_restart_ratio * best ) {
+        // safeguard: clear the history and restart with a shorter
+        // Picard step from the best point found so far
+        if ( best == real_max ) break;
+        m_len   = 0;
+        has_old = false;
+        damp   *= 0.5;
+        ++m_num_restart;
+        x = x_best + damp * f_best;
+        continue;
+      }
+
+      if ( normf < best ) {
+        best   = normf;
+        x_best = x;
+        f_best = f;
+      }
+
+      if ( has_old ) {
+        df = f - f_old;
+        dg = g - g_old;
+        if ( m_len == m_depth ) deleteFirstColumn();
+        appendColumn( df, dg );
+      }
+      f_old.swap(f);
+      g_old.swap(g);
+      has_old = true;
+
+      if ( m_len == 0 ) { // damped Picard step
+        x += damp * f_old;
+        continue;
+      }
+
+      while ( m_len > 1 && conditionR() > m_drop_tol ) deleteFirstColumn();
+
+      gamma = m_R.topLeftCorner(m_len,m_len).triangularView<Eigen::Upper>().solve(
+        m_Q.leftCols(m_len).transpose() * f_old
+      );
+      x = g_old - m_DG.leftCols(m_len) * gamma;
+      if ( m_beta != 1 ) {
+        x -= (1-m_beta) * (
+          f_old - m_Q.leftCols(m_len) *
+          ( m_R.topLeftCorner(m_len,m_len).triangularView<Eigen::Upper>() * gamma )
+        );
+      }
+    }
+
+    if ( !done && best < real_max ) x = x_best;
+
+    // residual of F at the last iterate, already known when G = x - F
+    if ( done && !P.hasFixedPointForm() ) {
+      m_norm_F    = normf;
+      m_converged = true;
+    } else {
+      evalF( P, x, f );
+      m_norm_F    = f.norm();
+      m_converged = f.lpNorm<Eigen::Infinity>() <= m_tolerance;
+    }
+
+    tictoc.toc();
+    m_elapsed_ms = tictoc.elapsed_ms();
+    return m_converged;
+  }
+
+}
@@ -0,0 +1,77 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+#ifndef NL_SOLVER_ANDERSON_HH
+#define NL_SOLVER_ANDERSON_HH
+
+#include "NLsolver.hh"
+
+namespace NLproblem {
+
+  /*\
+   |      _              _
+   |     / \   _ __   __| | ___ _ __ ___  ___  _ __
+   |    / _ \ | '_ \ / _` |/ _ \ '__/ __|/ _ \| '_ \
+   |   / ___ \| | | | (_| |  __/ |  \__ \ (_) | | | |
+   |  /_/   \_\_| |_|\__,_|\___|_|  |___/\___/|_| |_|
+  \*/
+
+  //!
+  //! Anderson(m) acceleration of the fixed point iteration \f$ x = G(x) \f$.
+  //!
+  //! \f$ G \f$ is `fixedPointMap`, that is \f$ x - F(x) \f$ unless the
+  //! problem provides its native fixed point form.
+  //! The least squares problem on the last `m` differences of the
+  //! fixed point residual \f$ f = G(x)-x \f$ is solved with a QR
+  //! factorization updated by Gram-Schmidt when a column is appended and
+  //! by Givens rotations when the oldest column is dropped
+  //! (Walker and Ni, SIAM J. Numer. Anal. 49, 2011).
+  //! Safeguards: columns are dropped while \f$ \mathrm{cond}(R) \f$ is
+  //! above `drop_tol`, the history is cleared when the residual grows by
+  //! more than `restart_ratio` over the best one or is not finite.
+  //! No jacobian is ever evaluated.
+  //!
+  class AndersonSolver : public NLsolver {
+
+    integer   m_depth;         // m
+    real_type m_beta;          // damping (mixing) parameter
+    real_type m_drop_tol;      // maximum condition number of R
+    real_type m_restart_ratio; // residual growth that clears the history
+
+    // QR of the differences of f, and differences of G
+    dmat_t  m_Q, m_R, m_DG;
+    integer m_len;
+    integer m_num_restart;
+
+    void appendColumn( dvec_t & df, dvec_t const & dg );
+    void deleteFirstColumn();
+    real_type conditionR() const;
+
+  public:
+
+    explicit
+    AndersonSolver( integer depth = 10, real_type beta = 1 );
+
+    virtual ~AndersonSolver() {}
+
+    void setDepth( integer m )               { m_depth = m; }
+    void setBeta( real_type beta )           { m_beta = beta; }
+    void setDropTolerance( real_type dt )    { m_drop_tol = dt; }
+    void setRestartRatio( real_type rr )     { m_restart_ratio = rr; }
+
+    integer numRestart() const { return m_num_restart; }
+
+    bool solve( nonlinearSystem const & P, dvec_t & x ) override;
+
+  };
+
+}
+
+#endif
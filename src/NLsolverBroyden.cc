@@ -0,0 +1,162 @@
+#include "NLsolverBroyden.hh"
+
+namespace NLproblem {
+
+  BroydenSolver::BroydenSolver(
+    BroydenType type,
+    BroydenInit init,
+    integer     max_len
+  )
+  : NLsolver(
+    string( type == GOOD_BROYDEN ? "Broyden" : "BadBroyden" ) +
+    string( init == INIT_JACOBIAN ? "" : "-I" )
+  )
+  , m_type(type)
+  , m_init(init)
+  , m_max_len(max_len)
+  , m_max_restart(50)
+  , m_sigma(1)
+  , m_len(0)
+  , m_num_restart(0)
+  {
+    UTILS_ASSERT(
+      max_len > 0, "BroydenSolver, memory length must be positive, m = {}", max_len
+    );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BroydenSolver::applyH0( dvec_t const & v, dvec_t & w ) const {
+    if ( m_init == INIT_JACOBIAN ) m_jac.solve( v, w );
+    else                           w = m_sigma * v;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BroydenSolver::applyH( dvec_t const & v, dvec_t & w ) const {
+    applyH0( v, w );
+    if ( m_type == GOOD_BROYDEN ) {
+      // w = (I + u_{k-1} v_{k-1}^T) ... (I + u_0 v_0^T) H0 v
+      for ( integer j = 0; j < m_len; ++j )
+        w += m_U.col(j) * m_V.col(j).dot(w);
+    } else {
+      // w = H0 v + sum_j u_j v_j^T v
+      for ( integer j = 0; j < m_len; ++j )
+        w += m_U.col(j) * m_V.col(j).dot(v);
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  BroydenSolver::update( dvec_t const & s, dvec_t const & y ) {
+    if ( m_len >= m_max_len ) return false;
+    dvec_t Hy( s.size() );
+    applyH( y, Hy );
+    real_type const eps = 1e3*numeric_limits<real_type>::epsilon();
+    if ( m_type == GOOD_BROYDEN ) {
+      real_type den = s.dot(Hy);
+      if ( std::abs(den) <= eps * s.norm() * Hy.norm() ) return false;
+      m_U.col(m_len) = (s-Hy)/den;
+      m_V.col(m_len) = s;
+    } else {
+      real_type den = y.squaredNorm();
+      if ( den <= eps * eps ) return false;
+      m_U.col(m_len) = (s-Hy)/den;
+      m_V.col(m_len) = y;
+    }
+    ++m_len;
+    return true;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  BroydenSolver::restart( nonlinearSystem const & P, dvec_t const & x ) {
+    m_len = 0;
+    if ( m_init == INIT_JACOBIAN ) {
+      return evalJ( P, x, m_jac ) && factorize( m_jac );
+    }
+    return true;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  BroydenSolver::solve( nonlinearSystem const & P, dvec_t & x ) {
+    Utils::TicToc tictoc;
+    tictoc.tic();
+    resetStatistics();
+    m_num_restart = 0;
+
+    integer const n = P.numEqns();
+    dvec_t F(n), F1(n), x1(n), d(n), s(n), y(n);
+
+    m_U.resize( n, m_max_len );
+    m_V.resize( n, m_max_len );
+    m_sigma = 1;
+
+    if ( m_init == INIT_JACOBIAN ) m_jac.setup( P );
+
+    evalF( P, x, F );
+    m_norm_F = F.norm();
+
+    bool fresh = restart( P, x ); // true if H was just reset
+    if ( !fresh ) {
+      tictoc.toc();
+      m_elapsed_ms = tictoc.elapsed_ms();
+      return false;
+    }
+
+    for ( m_num_iter = 0; m_num_iter < m_max_iter; ++m_num_iter ) {
+      if ( F.lpNorm<Eigen::Infinity>() <= m_tolerance ) {
+        m_converged = true;
+        break;
+      }
+      if ( stopRequested() ) break;
+
+      applyH( F, d );
+      d = -d;
+
+      real_type lambda, normF1;
+      if ( !lineSearch( P, x, m_norm_F, d, x1, F1, normF1, lambda ) ) {
+        // direction from a fresh H0 failed too: give up
+        if ( fresh || m_num_restart >= m_max_restart ) break;
+        ++m_num_restart;
+        fresh = restart( P, x );
+        if ( !fresh ) break;
+        continue;
+      }
+
+      s = x1 - x;
+      y = F1 - F;
+      x.swap(x1);
+      F.swap(F1);
+      m_norm_F = normF1;
+
+      // rescale identity with the last secant pair
+      if ( m_init == INIT_IDENTITY ) {
+        real_type yy = y.squaredNorm();
+        real_type sy = s.dot(y);
+        if ( yy > 0 && std::abs(sy) > 0 && m_len == 0 ) m_sigma = sy/yy;
+      }
+
+      if ( update( s, y ) ) {
+        fresh = false;
+      } else {
+        if ( m_num_restart >= m_max_restart ) break;
+        ++m_num_restart;
+        fresh = restart( P, x );
+        if ( !fresh ) break;
+      }
+    }
+    if ( !m_converged ) m_converged = F.lpNorm<Eigen::Infinity>() <= m_tolerance;
+
+    tictoc.toc();
+    m_elapsed_ms = tictoc.elapsed_ms();
+    return m_converged;
+  }
+
+}
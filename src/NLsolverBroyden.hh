@@ -0,0 +1,92 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+#ifndef NL_SOLVER_BROYDEN_HH
+#define NL_SOLVER_BROYDEN_HH
+
+#include "NLsolver.hh"
+
+namespace NLproblem {
+
+  /*\
+   |   ____                      _
+   |  | __ ) _ __ ___  _   _  __| | ___ _ __
+   |  |  _ \| '__/ _ \| | | |/ _` |/ _ \ '_ \
+   |  | |_) | | | (_) | |_| | (_| |  __/ | | |
+   |  |____/|_|  \___/ \__, |\__,_|\___|_| |_|
+   |                   |___/
+  \*/
+
+  //!
+  //! Limited memory Broyden method.
+  //!
+  //! The inverse jacobian is never formed, it is stored in recursive form
+  //! as \f$ H_0 \f$ plus at most `m` pairs of vectors (storage \f$ O(mn) \f$):
+  //!
+  //! - good Broyden: \f$ H_{k+1} = (I + u_k v_k^T) H_k \f$ with
+  //!   \f$ v_k = s_k \f$, \f$ u_k = (s_k - H_k y_k)/(s_k^T H_k y_k) \f$
+  //! - bad Broyden: \f$ H_{k+1} = H_k + u_k v_k^T \f$ with
+  //!   \f$ v_k = y_k \f$, \f$ u_k = (s_k - H_k y_k)/(y_k^T y_k) \f$
+  //!
+  //! \f$ H_0 \f$ is the inverse of the jacobian evaluated at the restart
+  //! point (one sparse LU) or a scaled identity.
+  //! The method restarts when the memory is full, when the update is
+  //! numerically singular or when the line search fails.
+  //!
+  class BroydenSolver : public NLsolver {
+  public:
+
+    typedef enum { GOOD_BROYDEN = 0, BAD_BROYDEN } BroydenType;
+    typedef enum { INIT_JACOBIAN = 0, INIT_IDENTITY } BroydenInit;
+
+  private:
+
+    BroydenType m_type;
+    BroydenInit m_init;
+    integer     m_max_len;     // memory length m
+    integer     m_max_restart; // maximum number of restarts
+    real_type   m_sigma;       // H0 = sigma * I when INIT_IDENTITY
+
+    sparseJacobian m_jac;
+
+    dmat_t  m_U, m_V; // n x m storage of the update vectors
+    integer m_len;    // number of stored updates
+    integer m_num_restart;
+
+    void applyH0( dvec_t const & v, dvec_t & w ) const;
+    void applyH( dvec_t const & v, dvec_t & w ) const;
+    bool update( dvec_t const & s, dvec_t const & y );
+    bool restart( nonlinearSystem const & P, dvec_t const & x );
+
+  public:
+
+    explicit
+    BroydenSolver(
+      BroydenType type    = GOOD_BROYDEN,
+      BroydenInit init    = INIT_JACOBIAN,
+      integer     max_len = 20
+    );
+
+    virtual ~BroydenSolver() {}
+
+    void setMemory( integer m )        { m_max_len = m; }
+    void setMaxRestart( integer mr )   { m_max_restart = mr; }
+    void setType( BroydenType t )      { m_type = t; }
+    void setInit( BroydenInit i )      { m_init = i; }
+
+    integer numRestart() const { return m_num_restart; }
+
+    bool solve( nonlinearSystem const & P, dvec_t & x ) override;
+
+  };
+
+}
+
+#endif
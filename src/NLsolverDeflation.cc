@@ -0,0 +1,262 @@
+#include "NLsolverDeflation.hh"
+#include <random>
+
+namespace NLproblem {
+
+  DeflationSolver::DeflationSolver( unsigned nthreads )
+  : NLsolver("Deflation")
+  , m_pool( max( unsigned(1), nthreads ) )
+  , m_power(2)
+  , m_shift(1)
+  , m_same_tol(1e-6)
+  , m_perturb(0.5)
+  , m_num_chains(4)
+  , m_max_roots(100)
+  , m_max_fail(3)
+  , m_seed(1)
+  , m_parallel(true)
+  , m_work( m_pool.size() )
+  , m_next_chain(0)
+  , m_num_duplicate(0)
+  , m_run_F(0)
+  , m_halted(false)
+  {}
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  DeflationSolver::halted( workspace & W ) {
+    m_run_F    += W.num_F - W.num_F_run;
+    W.num_F_run = W.num_F;
+    if ( !m_halted && mustStop( m_run_F ) ) m_halted = true;
+    return m_halted;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  DeflationSolver::deflation(
+    vector<dvec_t> const & roots,
+    dvec_t         const & x,
+    dvec_t               & eta
+  ) const {
+    real_type logM = 0;
+    eta.setZero( x.size() );
+    for ( auto const & r : roots ) {
+      real_type nr2 = (x-r).squaredNorm();
+      if ( nr2 == 0 ) return real_max;
+      real_type a  = std::pow( nr2, -m_power/2 );
+      real_type mi = a + m_shift;
+      logM += std::log( mi );
+      // grad m_i = -p |x-r|^(-p-2) (x-r)
+      eta.noalias() -= ( m_power*a/(nr2*mi) ) * (x-r);
+    }
+    return logM;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  DeflationSolver::deflatedNewton(
+    nonlinearSystem const & P,
+    workspace             & W,
+    vector<dvec_t>  const & roots
+  ) {
+    if ( !isAdmissible( P, W.x ) ) return false;
+    P.evalF( W.x, W.F ); ++W.num_F;
+    real_type normF = W.F.norm();
+    real_type logM  = deflation( roots, W.x, W.eta );
+    if ( !std::isfinite(normF) || logM >= real_max ) return false;
+    real_type logG = logM + std::log( normF );
+
+    for ( integer iter = 0; iter < m_max_iter; ++iter, ++W.num_iter ) {
+      if ( W.F.lpNorm<Eigen::Infinity>() <= m_tolerance ) return true;
+      if ( halted( W ) ) return false;
+
+      bool finite = W.jac.eval( P, W.x ) < 0; ++W.num_J;
+      if ( !finite ) return false;
+      ++W.num_factorize;
+      if ( !W.jac.factorize() ) return false;
+      W.jac.solve( W.F, W.d );
+      W.d = -W.d;
+      // step of the deflated system by Sherman-Morrison
+      real_type den = 1 - W.eta.dot( W.d );
+      if ( std::abs(den) > 1e-8 ) W.d /= den;
+      if ( firstNonFinite( W.d ) >= 0 ) return false;
+
+      // backtracking on log ||G||
+      real_type lambda = 1;
+      bool      ok     = false;
+      while ( !ok && lambda >= m_lambda_min ) {
+        W.x1 = W.x + lambda * W.d;
+        if ( isAdmissible( P, W.x1 ) ) {
+          finite = P.safeEvalF( W.x1, W.F1 ) < 0; ++W.num_F;
+          real_type normF1 = finite ? W.F1.norm() : real_inf;
+          if ( std::isfinite(normF1) ) {
+            real_type logM1 = deflation( roots, W.x1, W.eta );
+            real_type logG1 = logM1 + std::log( normF1 );
+            ok = logM1 < real_max && logG1 <= logG + std::log1p( -m_alpha*lambda );
+            if ( ok ) logG = logG1;
+          }
+        }
+        lambda *= 0.5;
+      }
+      if ( !ok ) return false;
+      W.x.swap( W.x1 );
+      W.F.swap( W.F1 );
+    }
+    return W.F.lpNorm<Eigen::Infinity>() <= m_tolerance;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  DeflationSolver::addRoot( dvec_t const & x, integer chain, integer iter ) {
+    std::lock_guard<std::mutex> lock( m_roots_mtx );
+    real_type nx = x.norm();
+    for ( auto const & r : m_roots )
+      if ( (r-x).norm() <= m_same_tol * ( 1 + nx ) ) return false;
+    if ( integer(m_roots.size()) >= m_max_roots ) return false;
+    m_roots.push_back( x );
+    m_root_chain.push_back( chain );
+    m_root_iter.push_back( iter );
+    return true;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  DeflationSolver::runChain( nonlinearSystem const & P, unsigned iw, integer chain ) {
+    workspace & W = m_work[iw];
+    integer const n  = P.numEqns();
+    integer const ns = integer(m_starts.size());
+
+    std::mt19937 gen( static_cast<unsigned>( m_seed + chain ) );
+    std::uniform_real_distribution<real_type> U( -1, 1 );
+    dvec_t L(n), H(n);
+    P.boundingBox( L, H );
+
+    // the first chains start from the given points, the others perturb them
+    dvec_t x0 = m_starts[size_t(chain % ns)];
+    auto perturb = [&]( dvec_t & x ) -> void {
+      for ( integer j = 0; j < n; ++j )
+        x(j) += m_perturb * ( 1 + std::abs(x(j)) ) * U(gen);
+      x = x.cwiseMax( L ).cwiseMin( H );
+    };
+    if ( chain >= ns ) perturb( x0 );
+
+    vector<dvec_t> roots;
+    integer        fail = 0;
+    while ( fail < m_max_fail && !halted( W ) ) {
+      {
+        std::lock_guard<std::mutex> lock( m_roots_mtx );
+        if ( integer(m_roots.size()) >= m_max_roots ) break;
+        roots = m_roots;
+      }
+      W.x = x0;
+      if ( fail > 0 ) perturb( W.x );
+      integer iter0 = W.num_iter;
+      if ( deflatedNewton( P, W, roots ) ) {
+        if ( addRoot( W.x, chain, W.num_iter-iter0 ) ) {
+          fail = 0;
+          continue;
+        }
+        ++m_num_duplicate;
+      }
+      ++fail;
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  DeflationSolver::run( nonlinearSystem const & P ) {
+    Utils::TicToc tictoc;
+    tictoc.tic();
+    resetStatistics();
+    m_roots.clear();
+    m_root_chain.clear();
+    m_root_iter.clear();
+    m_next_chain    = 0;
+    m_num_duplicate = 0;
+    m_run_F         = 0;
+    m_halted        = false;
+
+    unsigned nw = m_parallel && P.isThreadSafe() ? m_pool.size() : 1;
+    if ( unsigned(m_num_chains) < nw ) nw = unsigned(max( m_num_chains, integer(1) ));
+
+    integer const n = P.numEqns();
+    for ( unsigned iw = 0; iw < nw; ++iw ) {
+      workspace & W = m_work[iw];
+      W.jac.setup( P );
+      W.F.resize( n );
+      W.F1.resize( n );
+      W.num_iter = W.num_F = W.num_J = W.num_factorize = W.num_F_run = 0;
+    }
+
+    auto worker = [this,&P]( unsigned iw ) -> void {
+      integer chain;
+      while ( !m_halted && (chain = m_next_chain++) < m_num_chains ) runChain( P, iw, chain );
+    };
+
+    if ( nw == 1 ) {
+      worker( 0 );
+    } else {
+      for ( unsigned iw = 0; iw < nw; ++iw ) m_pool.run( iw, worker, iw );
+      m_pool.wait_all();
+    }
+
+    for ( unsigned iw = 0; iw < nw; ++iw ) {
+      workspace const & W = m_work[iw];
+      m_num_iter      += W.num_iter;
+      m_num_F         += W.num_F;
+      m_num_J         += W.num_J;
+      m_num_factorize += W.num_factorize;
+    }
+    m_converged = !m_roots.empty();
+    m_stopped   = m_halted;
+
+    tictoc.toc();
+    m_elapsed_ms = tictoc.elapsed_ms();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  DeflationSolver::solveAll( nonlinearSystem const & P ) {
+    integer const n = P.numEqns();
+    m_starts.resize( size_t(max( P.numInitialPoint(), integer(1) )) );
+    for ( integer i = 0; i < integer(m_starts.size()); ++i ) {
+      m_starts[size_t(i)].resize( n );
+      P.getInitialPoint( m_starts[size_t(i)], i );
+    }
+    run( P );
+    if ( m_converged ) {
+      dvec_t f( n );
+      P.evalF( m_roots.front(), f );
+      m_norm_F = f.norm();
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  DeflationSolver::solve( nonlinearSystem const & P, dvec_t & x ) {
+    m_starts.assign( 1, x );
+    run( P );
+    real_type best = real_max;
+    integer   ibest = -1;
+    for ( integer i = 0; i < numRoots(); ++i ) {
+      real_type d = (m_roots[size_t(i)]-x).norm();
+      if ( d < best ) { best = d; ibest = i; }
+    }
+    if ( ibest >= 0 ) {
+      x = m_roots[size_t(ibest)];
+      dvec_t f( x.size() );
+      P.evalF( x, f );
+      m_norm_F = f.norm();
+    }
+    return m_converged;
+  }
+
+}
@@ -0,0 +1,160 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+#ifndef NL_SOLVER_DEFLATION_HH
+#define NL_SOLVER_DEFLATION_HH
+
+#include "NLsolver.hh"
+
+#include <atomic>
+#include <mutex>
+
+namespace NLproblem {
+
+  /*\
+   |   ____        __ _       _   _
+   |  |  _ \  ___ / _| | __ _| |_(_) ___  _ __
+   |  | | | |/ _ \ |_| |/ _` | __| |/ _ \| '_ \
+   |  | |_| |  __/  _| | (_| | |_| | (_) | | | |
+   |  |____/ \___|_| |_|\__,_|\__|_|\___/|_| |_|
+  \*/
+
+  //!
+  //! Deflated Newton for several distinct roots of a `nonlinearSystem`.
+  //!
+  //! With the roots \f$ r_1,\ldots,r_k \f$ already found, Newton is run
+  //! on the deflated residual \f$ G(x) = M(x) F(x) \f$ with the shifted
+  //! deflation operator of Farrell, Birkisson and Funke
+  //! \f[
+  //!   M(x) = \prod_{i=1}^k \left( \|x-r_i\|^{-p} + \sigma \right)
+  //! \f]
+  //! so that \f$ r_i \f$ are no more roots and \f$ G \f$ behaves as
+  //! \f$ F \f$ far from them. The deflated jacobian
+  //! \f$ M J + F \nabla M^T \f$ is a rank one update of \f$ J \f$, it
+  //! is never formed: with \f$ \eta = \nabla M / M \f$ and the Newton
+  //! step \f$ d \f$ of \f$ F \f$ (sparse LU of \f$ J \f$) the step of
+  //! \f$ G \f$ is \f$ d / (1 - \eta^T d) \f$.
+  //! The line search is on \f$ \log \|G\| \f$ to avoid the overflow
+  //! of \f$ M \f$ near the known roots.
+  //!
+  //! Each chain starts from an initial point of the problem (perturbed
+  //! when there are more chains than initial points) and restarts
+  //! from it after each new root. The chains run on the threads of a
+  //! pool (serially if the problem is not `isThreadSafe`) and share the
+  //! list of the roots: a chain deflates all the roots known when it
+  //! restarts. The cancel flags and the budgets are checked before each
+  //! Newton step, when the run must stop all the chains end.
+  //!
+  class DeflationSolver : public NLsolver {
+
+    //! workspace of a chain
+    struct workspace {
+      sparseJacobian jac;
+      dvec_t x, x1, F, F1, d, eta;
+      integer num_iter;
+      integer num_F;
+      integer num_J;
+      integer num_factorize;
+      integer num_F_run;     // part of num_F already added to m_run_F
+    };
+
+    Utils::ThreadPool m_pool;
+
+    // parameters
+    real_type m_power;       // p
+    real_type m_shift;       // sigma
+    real_type m_same_tol;    // distance of two equal roots (relative)
+    real_type m_perturb;     // relative perturbation of the initial points
+    integer   m_num_chains;
+    integer   m_max_roots;
+    integer   m_max_fail;    // consecutive failures that stop a chain
+    integer   m_seed;
+    bool      m_parallel;
+
+    vector<workspace> m_work;
+    vector<dvec_t>    m_starts;
+
+    std::mutex      m_roots_mtx;
+    vector<dvec_t>  m_roots;
+    vector<integer> m_root_chain;   // chain that found the root
+    vector<integer> m_root_iter;    // newton iterations used
+
+    std::atomic<integer> m_next_chain;
+    std::atomic<integer> m_num_duplicate;
+    std::atomic<integer> m_run_F;    // evaluations of all the chains
+    std::atomic<bool>    m_halted;   // cancelled or out of budget
+
+    //! \f$ \log M(x) \f$ and \f$ \eta = \nabla M / M \f$
+    real_type
+    deflation(
+      vector<dvec_t> const & roots,
+      dvec_t         const & x,
+      dvec_t               & eta
+    ) const;
+
+    //! add the evaluations of `W` to the run, `true` if the run must stop
+    bool halted( workspace & W );
+
+    //! deflated Newton from `W.x`, `true` if converged to a new root
+    bool
+    deflatedNewton(
+      nonlinearSystem const & P,
+      workspace             & W,
+      vector<dvec_t>  const & roots
+    );
+
+    //! add `x` to the roots if not already there
+    bool addRoot( dvec_t const & x, integer chain, integer iter );
+
+    void runChain( nonlinearSystem const & P, unsigned iw, integer chain );
+    void run( nonlinearSystem const & P );
+
+  public:
+
+    explicit
+    DeflationSolver( unsigned nthreads = max( unsigned(1), unsigned(std::thread::hardware_concurrency()) ) );
+
+    virtual ~DeflationSolver() {}
+
+    void setPower( real_type p )         { m_power = p; }
+    void setShift( real_type s )         { m_shift = s; }
+    void setSameTolerance( real_type t ) { m_same_tol = t; }
+    void setPerturbation( real_type r )  { m_perturb = r; }
+    void setNumChains( integer nc )      { m_num_chains = nc; }
+    void setMaxRoots( integer mr )       { m_max_roots = mr; }
+    void setMaxFail( integer mf )        { m_max_fail = mf; }
+    void setSeed( integer seed )         { m_seed = seed; }
+    void setParallel( bool yes )         { m_parallel = yes; }
+
+    //!
+    //! Run the deflation chains from the initial points of `P` until
+    //! they fail or `max_roots` distinct roots are found.
+    //!
+    void solveAll( nonlinearSystem const & P );
+
+    //!
+    //! As `solveAll` with the chains started from `x`, then `x` is set
+    //! to the root found closest to it. Return `true` if there is one.
+    //!
+    bool solve( nonlinearSystem const & P, dvec_t & x ) override;
+
+    integer  numRoots()     const { return integer(m_roots.size()); }
+    integer  numDuplicate() const { return m_num_duplicate.load(); }
+    unsigned numThreads()   const { return m_pool.size(); }
+
+    dvec_t const & root( integer i )      const { return m_roots[size_t(i)]; }
+    integer        rootChain( integer i ) const { return m_root_chain[size_t(i)]; }
+    integer        rootIter( integer i )  const { return m_root_iter[size_t(i)]; }
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,511 @@
+#include "NLsolverHomotopy.hh"
+#include <algorithm>
+#include <random>
+
+namespace NLproblem {
+
+  HomotopySolver::HomotopySolver( unsigned nthreads )
+  : NLsolver("Homotopy")
+  , m_pool( max( unsigned(1), nthreads ) )
+  , m_max_step(0.05)
+  , m_min_step(1e-14)
+  , m_corr_tol(1e-11)
+  , m_s_end(0.1)
+  , m_end_tol(1e-9)
+  , m_infinity(1e8)
+  , m_inf_tol(1e-7)
+  , m_root_tol(1e-8)
+  , m_same_tol(1e-6)
+  , m_real_tol(1e-8)
+  , m_max_corr(3)
+  , m_max_steps(20000)
+  , m_max_paths(1000000)
+  , m_num_samples(16)
+  , m_max_winding(16)
+  , m_max_rounds(20)
+  , m_seed(1)
+  , m_parallel(true)
+  , m_n(0)
+  , m_work( m_pool.size() )
+  , m_queues( m_pool.size() )
+  , m_num_steal(0)
+  , m_paths_F(0)
+  {}
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  HomotopySolver::setupSystem( nonlinearSystem const & P ) {
+    UTILS_ASSERT(
+      P.isPolynomial(),
+      "HomotopySolver, `{}` is not polynomial\n", P.title()
+    );
+    m_n = P.numEqns();
+
+    P.polynomialDegrees( m_deg );
+    int64_t np = 1;
+    for ( integer i = 0; i < m_n; ++i ) {
+      UTILS_ASSERT(
+        m_deg(i) > 0,
+        "HomotopySolver, `{}` equation {} is constant", P.title(), i
+      );
+      np *= m_deg(i);
+      UTILS_ASSERT(
+        np <= m_max_paths,
+        "HomotopySolver, `{}` has more than {} paths", P.title(), m_max_paths
+      );
+    }
+    m_ends.resize( size_t(np) );
+
+    // homogenize: y_0 completes each monomial to the degree of its equation
+    polynomialTerms T;
+    P.polynomialForm( T );
+    m_terms.clear();
+    m_terms.reserve( T.size() );
+    size_t max_len = 0;
+    for ( auto const & t : T ) {
+      if ( t.coeff == 0 ) continue;
+      monomial m;
+      m.eq    = t.eq;
+      m.coeff = t.coeff;
+      m.var.assign( size_t(m_deg(t.eq))-t.var.size(), 0 );
+      for ( integer v : t.var ) {
+        UTILS_ASSERT(
+          v >= 0 && v < m_n,
+          "HomotopySolver, `{}` bad variable index {}", P.title(), v
+        );
+        m.var.push_back( v+1 );
+      }
+      std::sort( m.var.begin(), m.var.end() );
+      max_len = max( max_len, m.var.size() );
+      m_terms.push_back( m );
+    }
+
+    std::mt19937 gen( static_cast<unsigned>(m_seed) );
+    std::uniform_real_distribution<real_type> angle( 0, m_2pi );
+    m_gamma = std::polar( real_type(1), angle( gen ) );
+    m_patch.resize( m_n+1 );
+    for ( integer i = 0; i <= m_n; ++i )
+      m_patch(i) = std::polar( real_type(1), angle( gen ) );
+
+    for ( auto & W : m_work ) {
+      W.F.resize( m_n );
+      W.H.resize( m_n+1 );
+      W.Hs.resize( m_n+1 );
+      W.JF.resize( m_n, m_n+1 );
+      W.JH.resize( m_n+1, m_n+1 );
+      W.pre.resize( max_len+1 );
+      W.suf.resize( max_len+1 );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  HomotopySolver::evalF( workspace & W, cvec_t const & x, bool jac ) const {
+    W.F.setZero();
+    if ( jac ) W.JF.setZero();
+    for ( auto const & t : m_terms ) {
+      size_t const L = t.var.size();
+      if ( jac ) {
+        // d/dx of the product by prefix and suffix products
+        W.pre[0] = W.suf[L] = 1;
+        for ( size_t m = 0; m < L; ++m ) W.pre[m+1] = W.pre[m] * x(t.var[m]);
+        for ( size_t m = L; m > 0; --m ) W.suf[m-1] = W.suf[m] * x(t.var[m-1]);
+        W.F(t.eq) += t.coeff * W.pre[L];
+        for ( size_t m = 0; m < L; ++m )
+          W.JF(t.eq,t.var[m]) += t.coeff * W.pre[m] * W.suf[m+1];
+      } else {
+        complex_type p = t.coeff;
+        for ( integer v : t.var ) p *= x(v);
+        W.F(t.eq) += p;
+      }
+    }
+    ++W.num_F;
+    if ( jac ) ++W.num_J;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  HomotopySolver::evalH( workspace & W, cvec_t const & y, complex_type s ) const {
+    evalF( W, y, true );
+    complex_type const sg = s * m_gamma;
+    complex_type const s1 = complex_type(1) - s;
+    W.H.head( m_n )         = s1 * W.F;
+    W.JH.topRows( m_n )     = s1 * W.JF;
+    for ( integer i = 0; i < m_n; ++i ) {
+      // G_i = y_{i+1}^d - y_0^d
+      complex_type yd = 1, y0d = 1;
+      for ( integer k = 1; k < m_deg(i); ++k ) { yd *= y(i+1); y0d *= y(0); }
+      complex_type g = yd * y(i+1) - y0d * y(0);
+      real_type    d = real_type( m_deg(i) );
+      W.H(i)      += sg * g;
+      W.JH(i,i+1) += sg * d * yd;
+      W.JH(i,0)   -= sg * d * y0d;
+      W.Hs(i)      = m_gamma * g - W.F(i);
+    }
+    // affine patch
+    W.H(m_n)         = m_patch.cwiseProduct( y ).sum() - real_type(1);
+    W.JH.row( m_n )  = m_patch.transpose();
+    W.Hs(m_n)        = 0;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  HomotopySolver::tangent(
+    workspace        & W,
+    cvec_t     const & x,
+    complex_type       s,
+    complex_type       ds,
+    cvec_t           & v
+  ) const {
+    evalH( W, x, s );
+    W.LU.compute( W.JH );
+    if ( !( W.LU.rcond() > 1e-15 ) ) return false;
+    v = W.LU.solve( W.Hs );
+    v *= -ds;
+    return v.allFinite();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  HomotopySolver::correct( workspace & W, cvec_t & x, complex_type s ) const {
+    real_type nrm_old = real_max;
+    for ( integer it = 0; it < m_max_corr; ++it ) {
+      evalH( W, x, s );
+      W.LU.compute( W.JH );
+      W.dx = W.LU.solve( W.H );
+      x -= W.dx;
+      real_type nrm = W.dx.norm();
+      if ( !std::isfinite(nrm) || nrm > 0.5*nrm_old ) return false;
+      if ( nrm <= m_corr_tol * ( 1 + x.norm() ) ) return true;
+      nrm_old = nrm;
+    }
+    return false;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  HomotopySolver::pathStatus
+  HomotopySolver::trackSegment(
+    workspace    & W,
+    complex_type   s_a,
+    complex_type   s_b,
+    cvec_t       & x
+  ) const {
+    complex_type const ds  = s_b - s_a;
+    real_type    const len = std::abs( ds );
+    real_type t  = 0;
+    real_type h  = min( real_type(1), min( W.ds, m_max_step ) / len );
+    integer   ok = 0;
+    while ( t < 1 ) {
+      if ( W.num_steps >= m_max_steps ) return PATH_FAILED;
+      if ( mustStop( m_paths_F + W.num_F - W.num_F_run ) ) return PATH_FAILED;
+      ++W.num_steps;
+      h = min( h, 1-t );
+      complex_type s  = s_a + t * ds;
+      complex_type s2 = s_a + (t+h/2) * ds;
+      complex_type s1 = t+h < 1 ? s_a + (t+h) * ds : s_b;
+      // RK4 predictor in t
+      bool good = tangent( W, x, s, ds, W.k1 );
+      if ( good ) {
+        W.x1 = x + (h/2) * W.k1;
+        good = tangent( W, W.x1, s2, ds, W.k2 );
+      }
+      if ( good ) {
+        W.x1 = x + (h/2) * W.k2;
+        good = tangent( W, W.x1, s2, ds, W.k3 );
+      }
+      if ( good ) {
+        W.x1 = x + h * W.k3;
+        good = tangent( W, W.x1, s1, ds, W.k4 );
+      }
+      if ( good ) {
+        W.xs = x + (h/6) * ( W.k1 + 2*(W.k2+W.k3) + W.k4 );
+        good = correct( W, W.xs, s1 );
+      }
+      if ( good ) {
+        x.swap( W.xs );
+        t += h;
+        if ( ++ok >= 3 ) { h = min( 2*h, m_max_step/len ); ok = 0; }
+        if ( x.norm() > m_infinity ) return PATH_FAILED;
+      } else {
+        h *= 0.5;
+        ok = 0;
+        if ( h*len < m_min_step ) return PATH_FAILED;
+      }
+    }
+    W.ds = h*len;
+    return PATH_FINITE;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  //
+  // On the circle |s| = r the path comes back to the starting point
+  // after c loops, c the winding number; in s = r t^c the path is
+  // analytic and the mean of the samples is its value at s = 0.
+  // The estimates at radii r, r/4, ... must agree and be a root of the
+  // homogenized system.
+  //
+  HomotopySolver::pathStatus
+  HomotopySolver::endgame( workspace & W, cvec_t & x, integer & winding ) const {
+    integer const M = m_num_samples;
+    real_type r = m_s_end;
+    cvec_t    x0, sum, est, est_old;
+    bool      have_est = false;
+    for ( integer round = 0; round < m_max_rounds; ++round ) {
+      x0 = x;
+      sum.setZero( m_n+1 );
+      integer c      = 0;
+      bool    closed = false;
+      while ( !closed && c < m_max_winding ) {
+        for ( integer k = 0; k < M; ++k ) {
+          complex_type s_a = std::polar( r, m_2pi*k/M );
+          complex_type s_b = std::polar( r, m_2pi*(k+1)/M );
+          sum += x;
+          pathStatus st = trackSegment( W, s_a, s_b, x );
+          if ( st != PATH_FINITE ) return st;
+        }
+        ++c;
+        closed = (x-x0).norm() <= 1e-6 * ( 1 + x0.norm() );
+      }
+      x = x0; // back to the first branch
+      if ( closed ) {
+        est = sum / complex_type( real_type(c*M) );
+        if ( have_est && (est-est_old).norm() <= m_end_tol * ( 1 + est.norm() ) ) {
+          // a branch point inside the circle also gives stable estimates
+          evalF( W, est, false );
+          if ( W.F.lpNorm<Eigen::Infinity>() <= m_root_tol ) {
+            x       = est;
+            winding = c;
+            return PATH_FINITE;
+          }
+        }
+        est_old  = est;
+        winding  = c;
+        have_est = true;
+      } else {
+        // too many branch points inside the circle
+        have_est = false;
+      }
+
+      pathStatus st = trackSegment( W, r, r/4, x );
+      if ( st != PATH_FINITE ) return st;
+      r /= 4;
+    }
+    return PATH_FAILED;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  HomotopySolver::startPoint( integer ipath, cvec_t & y ) const {
+    // mixed radix digits of ipath select the roots of x_i^d_i = 1
+    y.resize( m_n+1 );
+    y(0) = 1;
+    for ( integer i = 0; i < m_n; ++i ) {
+      integer d = m_deg(i);
+      y(i+1) = std::polar( real_type(1), m_2pi * (ipath % d) / d );
+      ipath /= d;
+    }
+    y /= m_patch.cwiseProduct( y ).sum();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  HomotopySolver::trackPath( workspace & W, integer ipath ) {
+    pathEnd & E = m_ends[size_t(ipath)];
+    W.ds        = m_max_step;
+    W.num_steps = 0;
+    E.winding   = 0;
+
+    cvec_t & y = E.x;
+    startPoint( ipath, y );
+    pathStatus st = trackSegment( W, 1, m_s_end, y );
+    if ( st == PATH_FINITE ) st = endgame( W, y, E.winding );
+    if ( st == PATH_FINITE && std::abs(y(0)) <= m_inf_tol * y.norm() )
+      st = PATH_AT_INFINITY;
+
+    E.residual = real_max;
+    E.cond     = real_max;
+    if ( st == PATH_FINITE ) {
+      // back to affine coordinates, y = (1,x)
+      y /= y(0);
+      evalF( W, y, true );
+      real_type res = W.F.lpNorm<Eigen::Infinity>();
+      // Newton polish, a root with winding > 1 is singular
+      for ( integer it = 0; E.winding == 1 && it < 3 && res > 0; ++it ) {
+        W.LUa.compute( W.JF.rightCols( m_n ) );
+        W.x1 = y;
+        W.x1.tail( m_n ) -= W.LUa.solve( W.F );
+        evalF( W, W.x1, true );
+        real_type res1 = W.F.lpNorm<Eigen::Infinity>();
+        if ( !( res1 < res ) ) { evalF( W, y, true ); break; }
+        y.swap( W.x1 );
+        res = res1;
+      }
+      W.LUa.compute( W.JF.rightCols( m_n ) );
+      real_type rc = W.LUa.rcond();
+      E.residual = res;
+      E.cond     = rc > 0 ? 1/rc : real_max;
+      cvec_t x = y.tail( m_n );
+      y.swap( x );
+    }
+    E.status    = st;
+    E.num_steps = W.num_steps;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  HomotopySolver::popPath( unsigned iw, integer & ipath ) {
+    {
+      pathQueue & Q = m_queues[iw];
+      std::lock_guard<std::mutex> lock( Q.mtx );
+      if ( !Q.paths.empty() ) {
+        ipath = Q.paths.back();
+        Q.paths.pop_back();
+        return true;
+      }
+    }
+    // steal from the front of the other queues
+    unsigned nq = unsigned(m_queues.size());
+    for ( unsigned k = 1; k < nq; ++k ) {
+      pathQueue & Q = m_queues[(iw+k)%nq];
+      std::lock_guard<std::mutex> lock( Q.mtx );
+      if ( !Q.paths.empty() ) {
+        ipath = Q.paths.front();
+        Q.paths.pop_front();
+        ++m_num_steal;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  HomotopySolver::collectRoots() {
+    m_roots.clear();
+    m_mult.clear();
+    m_real_idx.clear();
+    for ( auto const & E : m_ends ) {
+      if ( E.status != PATH_FINITE ) continue;
+      real_type nx = E.x.norm();
+      size_t k = 0;
+      while ( k < m_roots.size() &&
+              (m_roots[k]-E.x).norm() > m_same_tol * ( 1 + nx ) ) ++k;
+      if ( k < m_roots.size() ) {
+        ++m_mult[k];
+      } else {
+        m_roots.push_back( E.x );
+        m_mult.push_back( 1 );
+      }
+    }
+    for ( size_t k = 0; k < m_roots.size(); ++k ) {
+      cvec_t const & x = m_roots[k];
+      if ( x.imag().norm() <= m_real_tol * ( 1 + x.norm() ) )
+        m_real_idx.push_back( integer(k) );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  HomotopySolver::solveAll( nonlinearSystem const & P ) {
+    Utils::TicToc tictoc;
+    tictoc.tic();
+    resetStatistics();
+    m_num_steal = 0;
+
+    setupSystem( P );
+    integer const np = numPaths();
+
+    // contiguous blocks of paths to each worker
+    unsigned nw = m_parallel ? m_pool.size() : 1;
+    if ( unsigned(np) < nw ) nw = unsigned(np);
+    for ( auto & Q : m_queues ) Q.paths.clear();
+    for ( unsigned iw = 0; iw < nw; ++iw )
+      for ( integer i = integer(iw*np/nw); i < integer((iw+1)*np/nw); ++i )
+        m_queues[iw].paths.push_back( i );
+    for ( auto & W : m_work ) W.num_F = W.num_J = W.num_steps = W.num_F_run = 0;
+    for ( auto & E : m_ends ) {
+      E.status    = PATH_FAILED;
+      E.residual  = E.cond = real_max;
+      E.winding   = E.num_steps = 0;
+    }
+    m_paths_F = 0;
+
+    auto worker = [this]( unsigned iw ) -> void {
+      workspace & W = m_work[iw];
+      integer steps = 0, ipath;
+      while ( !mustStop( m_paths_F ) && popPath( iw, ipath ) ) {
+        trackPath( W, ipath );
+        steps      += W.num_steps;
+        m_paths_F  += W.num_F - W.num_F_run;
+        W.num_F_run = W.num_F;
+      }
+      W.num_steps = steps;
+    };
+
+    if ( nw == 1 ) {
+      worker( 0 );
+    } else {
+      for ( unsigned iw = 0; iw < nw; ++iw ) m_pool.run( iw, worker, iw );
+      m_pool.wait_all();
+    }
+
+    for ( auto const & W : m_work ) {
+      m_num_F    += W.num_F;
+      m_num_J    += W.num_J;
+      m_num_iter += W.num_steps;
+    }
+    m_stopped = mustStop( m_paths_F );
+    for ( auto const & Q : m_queues ) if ( !Q.paths.empty() ) m_stopped = true;
+    collectRoots();
+
+    tictoc.toc();
+    m_elapsed_ms = tictoc.elapsed_ms();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  HomotopySolver::solve( nonlinearSystem const & P, dvec_t & x ) {
+    solveAll( P );
+    m_converged = false;
+    m_norm_F    = real_max;
+    dvec_t    r( m_n ), f( m_n );
+    real_type best = real_max;
+    for ( integer i = 0; i < numRealRoots(); ++i ) {
+      realRoot( i, r );
+      P.evalF( r, f );
+      real_type res = f.lpNorm<Eigen::Infinity>();
+      if ( res > m_tolerance ) continue;
+      real_type d = (r-x).norm();
+      if ( d < best ) {
+        best        = d;
+        m_norm_F    = f.norm();
+        m_converged = true;
+        x           = r;
+      }
+    }
+    return m_converged;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  integer
+  HomotopySolver::numPaths( pathStatus s ) const {
+    integer count = 0;
+    for ( auto const & E : m_ends ) if ( E.status == s ) ++count;
+    return count;
+  }
+
+}
@@ -0,0 +1,222 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+#ifndef NL_SOLVER_HOMOTOPY_HH
+#define NL_SOLVER_HOMOTOPY_HH
+
+#include "NLsolver.hh"
+
+#include <atomic>
+#include <complex>
+#include <deque>
+#include <mutex>
+
+namespace NLproblem {
+
+  /*\
+   |   _   _                       _
+   |  | | | | ___  _ __ ___   ___ | |_ ___  _ __  _   _
+   |  | |_| |/ _ \| '_ ` _ \ / _ \| __/ _ \| '_ \| | | |
+   |  |  _  | (_) | | | | | | (_) | || (_) | |_) | |_| |
+   |  |_| |_|\___/|_| |_| |_|\___/ \__\___/| .__/ \__, |
+   |                                       |_|    |___/
+  \*/
+
+  //!
+  //! Total degree homotopy for the problems with `isPolynomial()`.
+  //!
+  //! With \f$ d_i \f$ the degree of \f$ F_i \f$ the start system is
+  //! \f$ G_i(x) = x_i^{d_i}-1 \f$, whose \f$ \prod_i d_i \f$ roots are
+  //! known, and the paths of
+  //! \f[
+  //!   H(x,s) = s\,\gamma\, G(x) + (1-s)\, F(x)
+  //! \f]
+  //! are tracked in complex arithmetic from \f$ s=1 \f$ to \f$ s=0 \f$
+  //! (random \f$ \gamma \f$ on the unit circle, so that the paths do not
+  //! meet for \f$ s \in (0,1] \f$).
+  //! The system is homogenized, \f$ x = (y_1,\ldots,y_n)/y_0 \f$, and
+  //! \f$ y \f$ lives on a random affine patch \f$ a^T y = 1 \f$: the
+  //! paths that diverge in \f$ x \f$ stay bounded and end with
+  //! \f$ y_0 = 0 \f$, that is at solutions at infinity.
+  //! Each step is a RK4 predictor on \f$ dy/ds = -H_y^{-1} H_s \f$ and a
+  //! Newton corrector, the step is halved when the corrector fails and
+  //! doubled after a few successes.
+  //! At \f$ |s| = \f$ `s_end` the Cauchy endgame loops around the origin:
+  //! the number of loops needed to come back is the winding number of
+  //! the endpoint and the mean of the samples its estimate, also when
+  //! the endpoint is singular.
+  //!
+  //! The paths are independent: they are split among the workers of a
+  //! thread pool, each one pops from the back of its own queue and when
+  //! empty steals from the front of the others. The cancel flags and
+  //! the budgets are checked before each path and each step, the paths
+  //! not completed are left `PATH_FAILED`.
+  //! `F` is evaluated from `polynomialForm`, so the tracking is thread
+  //! safe also when the problem is not.
+  //!
+  class HomotopySolver : public NLsolver {
+  public:
+
+    typedef std::complex<real_type>                                 complex_type;
+    typedef Eigen::Matrix<complex_type,Eigen::Dynamic,1>              cvec_t;
+    typedef Eigen::Matrix<complex_type,Eigen::Dynamic,Eigen::Dynamic> cmat_t;
+
+    enum pathStatus { PATH_FINITE, PATH_AT_INFINITY, PATH_FAILED };
+
+    //! end point of a path
+    struct pathEnd {
+      cvec_t     x;         // the root if PATH_FINITE
+      pathStatus status;
+      real_type  residual;  // max norm of F(x)
+      real_type  cond;      // condition number of the jacobian at x
+      integer    winding;   // loops of the endgame
+      integer    num_steps;
+    };
+
+  private:
+
+    //! monomial with the indices of the variables sorted
+    struct monomial {
+      integer         eq;
+      real_type       coeff;
+      vector<integer> var;
+    };
+
+    //! workspace of a worker
+    struct workspace {
+      cvec_t  F, H, Hs, dx, k1, k2, k3, k4, x1, xs;
+      cmat_t  JF, JH;
+      Eigen::PartialPivLU<cmat_t> LU, LUa;
+      vector<complex_type> pre, suf;
+      real_type ds;     // last step size
+      integer   num_F;
+      integer   num_J;
+      integer   num_steps;
+      integer   num_F_run;  // part of num_F already added to m_paths_F
+    };
+
+    struct pathQueue {
+      std::mutex          mtx;
+      std::deque<integer> paths;
+    };
+
+    Utils::ThreadPool m_pool;
+
+    // parameters
+    real_type m_max_step;     // maximum |ds|
+    real_type m_min_step;     // minimum |ds|, the path fails below
+    real_type m_corr_tol;     // corrector tolerance (relative)
+    real_type m_s_end;        // radius of the endgame
+    real_type m_end_tol;      // agreement of two endgame estimates
+    real_type m_infinity;     // the path is lost when |y| grows over it
+    real_type m_inf_tol;      // |y_0|/|y| of a solution at infinity
+    real_type m_root_tol;     // max norm of homogenized F at an endpoint
+    real_type m_same_tol;     // distance of the paths ending at the same root
+    real_type m_real_tol;     // imaginary part of a real root (relative)
+    integer   m_max_corr;     // corrector iterations
+    integer   m_max_steps;    // steps of a path
+    integer   m_max_paths;
+    integer   m_num_samples;  // samples per loop in the endgame
+    integer   m_max_winding;
+    integer   m_max_rounds;   // radii of the endgame
+    integer   m_seed;
+    bool      m_parallel;
+
+    // system
+    integer          m_n;
+    ivec_t           m_deg;
+    vector<monomial> m_terms;
+    complex_type     m_gamma;
+    cvec_t           m_patch;
+
+    vector<pathEnd>    m_ends;
+    vector<workspace>  m_work;
+    vector<pathQueue>  m_queues;
+
+    // distinct roots and their multiplicities
+    vector<cvec_t>  m_roots;
+    vector<integer> m_mult;
+    vector<integer> m_real_idx;
+
+    std::atomic<integer> m_num_steal;
+    std::atomic<integer> m_paths_F; // evaluations of the paths tracked so far
+
+    void setupSystem( nonlinearSystem const & P );
+
+    //! homogenized \f$ F \f$ at \f$ y = (y_0,y_1,\ldots,y_n) \f$
+    void evalF( workspace & W, cvec_t const & y, bool jac ) const;
+    void evalH( workspace & W, cvec_t const & y, complex_type s ) const;
+
+    //! `dx/dt` on the segment \f$ s = s_a + t (s_b - s_a) \f$
+    bool tangent( workspace & W, cvec_t const & x, complex_type s, complex_type ds, cvec_t & v ) const;
+    bool correct( workspace & W, cvec_t & x, complex_type s ) const;
+
+    //! track `x` on the segment from `s_a` to `s_b`
+    pathStatus trackSegment( workspace & W, complex_type s_a, complex_type s_b, cvec_t & x ) const;
+
+    void startPoint( integer ipath, cvec_t & x ) const;
+    void trackPath( workspace & W, integer ipath );
+
+    //! Cauchy endgame from \f$ s = \f$ `m_s_end`
+    pathStatus endgame( workspace & W, cvec_t & x, integer & winding ) const;
+
+    bool popPath( unsigned iw, integer & ipath );
+    void collectRoots();
+
+  public:
+
+    explicit
+    HomotopySolver( unsigned nthreads = max( unsigned(1), unsigned(std::thread::hardware_concurrency()) ) );
+
+    virtual ~HomotopySolver() {}
+
+    void setMaxStep( real_type ds )           { m_max_step = ds; }
+    void setCorrectorTolerance( real_type t ) { m_corr_tol = t; }
+    void setEndgameRadius( real_type r )      { m_s_end = r; }
+    void setEndgameTolerance( real_type t )   { m_end_tol = t; }
+    void setRootTolerance( real_type t )      { m_root_tol = t; }
+    void setMaxSteps( integer ms )            { m_max_steps = ms; }
+    void setMaxPaths( integer mp )            { m_max_paths = mp; }
+    void setSeed( integer seed )              { m_seed = seed; }
+    void setParallel( bool yes )              { m_parallel = yes; }
+
+    //!
+    //! Track all the paths of the total degree homotopy of `P`, the
+    //! distinct finite roots are collected with their multiplicity.
+    //!
+    void solveAll( nonlinearSystem const & P );
+
+    //!
+    //! `solveAll` then `x` is set to the real root closest to `x`.
+    //! Return `true` if a real root with \f$ \|F\|_\infty \f$ below
+    //! `tolerance` is found.
+    //!
+    bool solve( nonlinearSystem const & P, dvec_t & x ) override;
+
+    integer numPaths() const { return integer(m_ends.size()); }
+    integer numPaths( pathStatus s ) const;
+    integer numSteal() const { return m_num_steal.load(); }
+    unsigned numThreads() const { return m_pool.size(); }
+
+    pathEnd const & path( integer i ) const { return m_ends[size_t(i)]; }
+
+    integer        numRoots()           const { return integer(m_roots.size()); }
+    cvec_t const & root( integer i )    const { return m_roots[size_t(i)]; }
+    integer        multiplicity( integer i ) const { return m_mult[size_t(i)]; }
+
+    integer numRealRoots() const { return integer(m_real_idx.size()); }
+    void    realRoot( integer i, dvec_t & x ) const
+    { x = m_roots[size_t(m_real_idx[size_t(i)])].real(); }
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,286 @@
+#include "NLsolverHookeJeeves.hh"
+
+namespace NLproblem {
+
+  HookeJeevesSolver::HookeJeevesSolver( unsigned nthreads )
+  : NLsolver("HookeJeeves")
+  , m_pool( max( unsigned(1), nthreads ) )
+  , m_h_init(0.5)
+  , m_mesh_tol(1e-12)
+  , m_max_fun_eval(1000000)
+  , m_max_cache(1<<24)
+  , m_opportunistic(true)
+  , m_parallel(true)
+  , m_level(0)
+  , m_num_cache_hit(0)
+  , m_num_batch(0)
+  {
+    m_max_iter = 100000;
+    m_work_x.resize( m_pool.size() );
+    m_work_F.resize( m_pool.size() );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  HookeJeevesSolver::meshPoint( key_t const & k, dvec_t & x ) const {
+    real_type scale = std::ldexp( real_type(1), -m_level );
+    for ( integer j = 0; j < m_x0.size(); ++j )
+      x(j) = m_x0(j) + scale * m_h0(j) * real_type(k[size_t(j)]);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  //
+  // The same point has coordinates 2^l k at level l: the key is
+  // reduced to the coarsest level where the coordinates are integer,
+  // the level is the last entry.
+  //
+  void
+  HookeJeevesSolver::canonical( key_t const & k, key_t & key ) const {
+    key = k;
+    int64_t level = m_level;
+    while ( level > 0 ) {
+      bool even = true;
+      for ( int64_t v : key ) if ( (v & 1) != 0 ) { even = false; break; }
+      if ( !even ) break;
+      for ( int64_t & v : key ) v /= 2;
+      --level;
+    }
+    key.push_back( level );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  HookeJeevesSolver::value_t
+  HookeJeevesSolver::evalPoint(
+    nonlinearSystem const & P,
+    key_t           const & k,
+    dvec_t                & x,
+    dvec_t                & F,
+    bool                  & in_box
+  ) const {
+    value_t const bad( real_max, real_max );
+    meshPoint( k, x );
+    in_box = false;
+    for ( integer j = 0; j < x.size(); ++j )
+      if ( x(j) < m_L(j) || x(j) > m_U(j) ) return bad;
+    in_box = true;
+    if ( !isAdmissible( P, x ) ) return bad;
+    try {
+      P.evalF( x, F );
+    }
+    catch ( ... ) {
+      return bad;
+    }
+    real_type f2 = F.squaredNorm();
+    if ( !std::isfinite(f2) ) return bad;
+    return value_t( f2, F.lpNorm<Eigen::Infinity>() );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  HookeJeevesSolver::evalBatch( nonlinearSystem const & P, real_type f_ref ) {
+    integer const nb = integer(m_moves.size());
+    m_batch_val.assign( size_t(nb), value_t( real_max, real_max ) );
+    m_batch_key.resize( size_t(nb) );
+    m_batch_new.assign( size_t(nb), 0 );
+    ++m_num_batch;
+
+    integer const budget = m_max_fun_eval - m_num_F;
+    std::atomic<integer> next(0), num_eval(0), num_hit(0);
+    std::atomic<bool>    found(false);
+
+    auto worker = [&]( unsigned iw ) -> void {
+      key_t  & k = m_work_k[iw];
+      dvec_t & x = m_work_x[iw];
+      dvec_t & F = m_work_F[iw];
+      k = m_base;
+      while ( true ) {
+        if ( m_opportunistic && found.load() ) break;
+        integer i = next++;
+        if ( i >= nb ) break;
+        integer j = m_moves[size_t(i)].first;
+        int64_t s = m_moves[size_t(i)].second;
+        if ( j >= 0 ) k[size_t(j)] += s;
+        key_t & key = m_batch_key[size_t(i)];
+        canonical( k, key );
+        auto it = m_cache.find( key );
+        if ( it != m_cache.end() ) {
+          m_batch_val[size_t(i)] = it->second;
+          ++num_hit;
+        } else if ( num_eval < budget ) {
+          bool in_box;
+          m_batch_val[size_t(i)] = evalPoint( P, k, x, F, in_box );
+          m_batch_new[size_t(i)] = 1;
+          if ( in_box ) ++num_eval;
+        }
+        if ( j >= 0 ) k[size_t(j)] -= s;
+        if ( m_batch_val[size_t(i)].first < f_ref ) found = true;
+      }
+    };
+
+    unsigned nw = m_pool.size();
+    if ( !m_parallel || !P.isThreadSafe() || nb == 1 || nw == 1 ) {
+      worker( 0 );
+    } else {
+      if ( unsigned(nb) < nw ) nw = unsigned(nb);
+      for ( unsigned iw = 0; iw < nw; ++iw ) m_pool.run( iw, worker, iw );
+      m_pool.wait_all();
+    }
+    m_num_F         += num_eval;
+    m_num_cache_hit += num_hit;
+
+    for ( integer i = 0; i < nb; ++i )
+      if ( m_batch_new[size_t(i)] != 0 )
+        m_cache[m_batch_key[size_t(i)]] = m_batch_val[size_t(i)];
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  HookeJeevesSolver::value_t
+  HookeJeevesSolver::evalOne( nonlinearSystem const & P, key_t const & k ) {
+    m_base = k;
+    m_moves.assign( 1, pair<integer,int64_t>( -1, 0 ) );
+    evalBatch( P, -real_max );
+    return m_batch_val[0];
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  HookeJeevesSolver::explore(
+    nonlinearSystem const & P,
+    key_t           const & c,
+    value_t         const & fc,
+    key_t                 & k_best,
+    value_t               & f_best
+  ) {
+    integer const n = integer(c.size());
+
+    // poll, for each coordinate the last improving sign first
+    m_base = c;
+    m_moves.clear();
+    for ( integer j = 0; j < n; ++j ) {
+      m_moves.push_back( pair<integer,int64_t>( j, m_sign(j) ) );
+      m_moves.push_back( pair<integer,int64_t>( j, -m_sign(j) ) );
+    }
+    evalBatch( P, fc.first );
+
+    k_best = c;
+    f_best = fc;
+
+    // best poll point and composite move on the improving coordinates
+    key_t   comp( c );
+    integer num_improve = 0;
+    for ( integer j = 0; j < n; ++j ) {
+      value_t const & vp = m_batch_val[size_t(2*j)];
+      value_t const & vm = m_batch_val[size_t(2*j+1)];
+      bool    first = vp.first <= vm.first;
+      value_t const & v = first ? vp : vm;
+      if ( v.first < fc.first ) {
+        int64_t s = first ? m_sign(j) : -m_sign(j);
+        comp[size_t(j)] += s;
+        m_sign(j) = integer(s);
+        ++num_improve;
+        if ( v.first < f_best.first ) {
+          f_best = v;
+          k_best = c;
+          k_best[size_t(j)] += s;
+        }
+      }
+    }
+    if ( num_improve > 1 && m_num_F < m_max_fun_eval ) {
+      value_t v = evalOne( P, comp );
+      if ( v.first < f_best.first ) {
+        f_best = v;
+        k_best = comp;
+      }
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  HookeJeevesSolver::solve( nonlinearSystem const & P, dvec_t & x ) {
+    Utils::TicToc tictoc;
+    tictoc.tic();
+    resetStatistics();
+    m_num_cache_hit = 0;
+    m_num_batch     = 0;
+    m_cache.clear();
+
+    integer const n = P.numEqns();
+    m_L.resize( n );
+    m_U.resize( n );
+    P.boundingBox( m_L, m_U );
+    for ( auto & w : m_work_x ) w.resize( n );
+    for ( auto & w : m_work_F ) w.resize( n );
+    m_work_k.resize( m_pool.size() );
+
+    // starting point projected on the box, initial mesh at most 1/4 of the box
+    m_x0 = x.cwiseMax( m_L ).cwiseMin( m_U );
+    m_h0.resize( n );
+    for ( integer j = 0; j < n; ++j ) {
+      real_type h = m_h_init * max( real_type(1), std::abs( m_x0(j) ) );
+      real_type w = m_U(j) - m_L(j);
+      if ( std::isfinite(w) && w > 0 ) h = min( h, w/4 );
+      m_h0(j) = h;
+    }
+    m_level = 0;
+    m_sign.setOnes( n );
+
+    key_t   k_base( size_t(n), 0 ), k_new, k_try;
+    value_t f_base, f_new, f_try;
+    f_base = evalOne( P, k_base );
+
+    real_type h_max = m_h0.maxCoeff();
+    for ( m_num_iter = 0; m_num_iter < m_max_iter; ++m_num_iter ) {
+      if ( f_base.second <= m_tolerance ) break;
+      if ( m_num_F >= m_max_fun_eval || stopRequested() ) break;
+
+      explore( P, k_base, f_base, k_new, f_new );
+      if ( f_new.first < f_base.first ) {
+        // pattern moves while they improve
+        while ( m_num_F < m_max_fun_eval && f_new.second > m_tolerance ) {
+          key_t k_pat( k_new );
+          for ( integer j = 0; j < n; ++j )
+            k_pat[size_t(j)] += k_new[size_t(j)] - k_base[size_t(j)];
+          k_base = k_new;
+          f_base = f_new;
+          explore( P, k_pat, evalOne( P, k_pat ), k_try, f_try );
+          if ( f_try.first >= f_base.first ) break;
+          k_new = k_try;
+          f_new = f_try;
+        }
+        if ( f_new.first < f_base.first ) {
+          k_base = k_new;
+          f_base = f_new;
+        }
+      } else {
+        // refine the mesh
+        h_max *= 0.5;
+        if ( h_max < m_mesh_tol ) break;
+        ++m_level;
+        for ( auto & v : k_base ) {
+          UTILS_ASSERT0(
+            std::abs(v) < (int64_t(1)<<60),
+            "HookeJeevesSolver::solve, mesh coordinates overflow"
+          );
+          v *= 2;
+        }
+      }
+      if ( int64_t(m_cache.size())*(n+1) > m_max_cache ) m_cache.clear();
+    }
+
+    meshPoint( k_base, x );
+    m_norm_F    = std::sqrt( f_base.first );
+    m_converged = f_base.second <= m_tolerance;
+
+    tictoc.toc();
+    m_elapsed_ms = tictoc.elapsed_ms();
+    return m_converged;
+  }
+
+}
@@ -0,0 +1,151 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+#ifndef NL_SOLVER_HOOKE_JEEVES_HH
+#define NL_SOLVER_HOOKE_JEEVES_HH
+
+#include "NLsolver.hh"
+
+#include <unordered_map>
+
+namespace NLproblem {
+
+  /*\
+   |   _   _             _              _
+   |  | | | | ___   ___ | | _____      | | ___  _____   _____  ___
+   |  | |_| |/ _ \ / _ \| |/ / _ \  _  | |/ _ \/ _ \ \ / / _ \/ __|
+   |  |  _  | (_) | (_) |   <  __/ | |_| |  __/  __/\ V /  __/\__ \
+   |  |_| |_|\___/ \___/|_|\_\___|  \___/ \___|\___| \_/ \___||___/
+  \*/
+
+  //!
+  //! Hooke-Jeeves pattern search for \f$ \min \|F(x)\|^2 \f$ on `boundingBox`.
+  //!
+  //! The points live on the mesh \f$ x_0 + 2^{-\ell}\, h_0 \odot k \f$ with
+  //! \f$ k \f$ integer, so that every visited point has an exact key and
+  //! the values are kept in a cache: pattern moves and polls that come
+  //! back to a known point cost nothing.
+  //! The \f$ 2n \f$ poll points of an exploratory move are evaluated as
+  //! one batch by a thread pool (serially if the problem is not
+  //! `isThreadSafe`), then the improving coordinates are combined in a
+  //! single composite point as in the sequential exploratory move.
+  //! With opportunistic polling the batch stops as soon as a point
+  //! better than the center is found; the sign that improved last is
+  //! polled first. Points outside the box or not admissible are
+  //! discarded without evaluation. No derivative is used.
+  //!
+  class HookeJeevesSolver : public NLsolver {
+
+    typedef vector<int64_t> key_t;
+
+    struct key_hash {
+      size_t
+      operator () ( key_t const & k ) const {
+        uint64_t h = 1469598103934665603ULL; // FNV-1a
+        for ( int64_t v : k ) { h ^= uint64_t(v); h *= 1099511628211ULL; }
+        return size_t(h);
+      }
+    };
+
+    //! value of a mesh point: \f$ \|F\|^2 \f$ and \f$ \|F\|_\infty \f$
+    typedef pair<real_type,real_type> value_t;
+
+    Utils::ThreadPool m_pool;
+
+    // parameters
+    real_type m_h_init;        // h0_j = h_init * max(1,|x0_j|)
+    real_type m_mesh_tol;      // stop when max_j h_j < mesh_tol
+    integer   m_max_fun_eval;
+    integer   m_max_cache;     // maximum number of stored integers
+    bool      m_opportunistic;
+    bool      m_parallel;
+
+    // mesh
+    dvec_t  m_x0, m_h0, m_L, m_U;
+    integer m_level;
+    ivec_t  m_sign; // sign of the last improving poll for each coordinate
+
+    std::unordered_map<key_t,value_t,key_hash> m_cache;
+
+    // batch: the points m_base + s*e_j for the moves (j,s), j < 0 is m_base
+    key_t                         m_base;
+    vector<pair<integer,int64_t> > m_moves;
+    vector<value_t>               m_batch_val;
+    vector<key_t>                 m_batch_key;  // keys of the new points
+    vector<char>                  m_batch_new;  // 1 if evaluated
+    vector<key_t>                 m_work_k;
+    vector<dvec_t>                m_work_x, m_work_F;
+
+    // statistics
+    integer m_num_cache_hit;
+    integer m_num_batch;
+
+    void meshPoint( key_t const & k, dvec_t & x ) const;
+    void canonical( key_t const & k, key_t & key ) const;
+
+    //! value at the mesh point `k`, `in_box` is `false` if `P` was not called
+    value_t
+    evalPoint(
+      nonlinearSystem const & P,
+      key_t           const & k,
+      dvec_t                & x,
+      dvec_t                & F,
+      bool                  & in_box
+    ) const;
+
+    //!
+    //! Evaluate the batch, cache lookup and evaluation are done by the
+    //! workers, the cache is written only after all of them are done.
+    //! With opportunistic polling the points not yet started are skipped
+    //! when a value below `f_ref` is found.
+    //!
+    void evalBatch( nonlinearSystem const & P, real_type f_ref );
+
+    value_t evalOne( nonlinearSystem const & P, key_t const & k );
+
+    void
+    explore(
+      nonlinearSystem const & P,
+      key_t           const & c,
+      value_t         const & fc,
+      key_t                 & k_best,
+      value_t               & f_best
+    );
+
+  public:
+
+    explicit
+    HookeJeevesSolver( unsigned nthreads = max( unsigned(1), unsigned(std::thread::hardware_concurrency()) ) );
+
+    virtual ~HookeJeevesSolver() {}
+
+    void setInitialMesh( real_type h )      { m_h_init = h; }
+    void setMeshTolerance( real_type tol )  { m_mesh_tol = tol; }
+    void setMaxFunEvaluation( integer mfe ) { m_max_fun_eval = mfe; }
+    void setMaxCache( integer mc )          { m_max_cache = mc; }
+    void setOpportunistic( bool yes )       { m_opportunistic = yes; }
+    void setParallel( bool yes )            { m_parallel = yes; }
+
+    integer numCacheHit() const { return m_num_cache_hit; }
+    integer numBatch()    const { return m_num_batch; }
+    unsigned numThreads() const { return m_pool.size(); }
+
+    //!
+    //! Minimize \f$ \|F(x)\|^2 \f$ on the bounding box starting from `x`
+    //! (projected on the box). Return `true` if \f$ \|F\|_\infty \f$ falls
+    //! below `tolerance`.
+    //!
+    bool solve( nonlinearSystem const & P, dvec_t & x ) override;
+
+  };
+
+}
+
+#endif
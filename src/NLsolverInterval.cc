@@ -0,0 +1,629 @@
+#include "NLsolverInterval.hh"
+#include <algorithm>
+
+namespace NLproblem {
+
+  static real_type const r_inf  = numeric_limits<real_type>::infinity();
+  static real_type const r_u    = numeric_limits<real_type>::epsilon()/2;
+  static real_type const r_tiny = numeric_limits<real_type>::min();
+
+  static inline real_type down( real_type x ) { return std::nextafter( x, -r_inf ); }
+  static inline real_type up( real_type x )   { return std::nextafter( x,  r_inf ); }
+
+  // |x|^p rounded toward zero and away from zero
+  static inline
+  void
+  powMag( real_type x, integer p, real_type & lo, real_type & hi ) {
+    lo = hi = std::abs(x);
+    for ( integer k = 1; k < p; ++k ) {
+      lo = std::nextafter( lo * std::abs(x), real_type(0) );
+      hi = up( hi * std::abs(x) );
+    }
+  }
+
+  // [a,b]^p
+  static inline
+  void
+  ipow( real_type a, real_type b, integer p, real_type & lo, real_type & hi ) {
+    if ( p == 1 ) { lo = a; hi = b; return; }
+    real_type la, ha, lb, hb;
+    powMag( a, p, la, ha );
+    powMag( b, p, lb, hb );
+    if ( (p & 1) != 0 ) {
+      lo = a >= 0 ? la : -ha;
+      hi = b >= 0 ? hb : -lb;
+    } else if ( a >= 0 ) {
+      lo = la; hi = hb;
+    } else if ( b <= 0 ) {
+      lo = lb; hi = ha;
+    } else {
+      lo = 0; hi = max( ha, hb );
+    }
+  }
+
+  // [a,b] *= [c,d]
+  static inline
+  void
+  imul( real_type & a, real_type & b, real_type c, real_type d ) {
+    real_type p1 = a*c, p2 = a*d, p3 = b*c, p4 = b*d;
+    a = down( min( min(p1,p2), min(p3,p4) ) );
+    b = up( max( max(p1,p2), max(p3,p4) ) );
+  }
+
+  // [a,b] /= [c,d], 0 not in [c,d]
+  static inline
+  void
+  idiv( real_type & a, real_type & b, real_type c, real_type d ) {
+    real_type p1 = a/c, p2 = a/d, p3 = b/c, p4 = b/d;
+    a = down( min( min(p1,p2), min(p3,p4) ) );
+    b = up( max( max(p1,p2), max(p3,p4) ) );
+  }
+
+  // enclosure of |q|^(1/p), pow is not correctly rounded
+  static inline
+  void
+  iroot( real_type q, integer p, real_type & lo, real_type & hi ) {
+    q = std::abs(q);
+    if ( p == 2 ) {
+      lo = down( std::sqrt(q) );
+      hi = up( std::sqrt(q) );
+    } else {
+      real_type r   = std::pow( q, real_type(1)/p );
+      real_type eps = (8+std::abs(std::log(q)))*2*r_u;
+      lo = r*(1-eps);
+      hi = r*(1+eps) + r_tiny;
+    }
+  }
+
+  // outward midpoint-radius form of [lo,hi]
+  template <typename T>
+  static inline
+  void
+  midRad( T const & lo, T const & hi, T & m, T & r ) {
+    m = 0.5*(lo+hi);
+    r = ( (hi-m).cwiseMax(m-lo) * (1+4*r_u) ).array() + r_tiny;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  IntervalSolver::IntervalSolver( unsigned nthreads )
+  : NLsolver("Interval")
+  , m_pool( max( unsigned(1), nthreads ) )
+  , m_min_width(1e-9)
+  , m_tol_width(1e-12)
+  , m_min_reduce(0.25)
+  , m_max_boxes(10000000)
+  , m_parallel(true)
+  , m_n(0)
+  , m_box_set(false)
+  , m_work( m_pool.size() )
+  , m_queues( m_pool.size() )
+  , m_pending(0)
+  , m_num_boxes(0)
+  , m_num_steal(0)
+  , m_complete(true)
+  , m_halted(false)
+  , m_boxes_F(0)
+  {}
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  IntervalSolver::setBox( dvec_t const & L, dvec_t const & U ) {
+    UTILS_ASSERT0(
+      L.size() == U.size() && (U-L).minCoeff() >= 0,
+      "IntervalSolver::setBox, bad box\n"
+    );
+    m_L       = L;
+    m_U       = U;
+    m_box_set = true;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  IntervalSolver::setupSystem( nonlinearSystem const & P ) {
+    UTILS_ASSERT(
+      P.isPolynomial(),
+      "IntervalSolver, `{}` is not polynomial\n", P.title()
+    );
+    m_n = P.numEqns();
+
+    if ( m_box_set ) {
+      UTILS_ASSERT(
+        m_L.size() == m_n,
+        "IntervalSolver, box of size {} for `{}` with {} equations\n",
+        m_L.size(), P.title(), m_n
+      );
+    } else {
+      m_L.resize( m_n );
+      m_U.resize( m_n );
+      P.boundingBox( m_L, m_U );
+    }
+    UTILS_ASSERT(
+      m_L.allFinite() && m_U.allFinite() &&
+      m_L.maxCoeff() < real_max && m_U.minCoeff() > -real_max,
+      "IntervalSolver, the box of `{}` is not finite, use setBox\n", P.title()
+    );
+
+    // F: repeated variables become powers
+    polynomialTerms T;
+    P.polynomialForm( T );
+    m_F_terms.clear();
+    m_F_terms.reserve( T.size() );
+    for ( auto const & t : T ) {
+      if ( t.coeff == 0 ) continue;
+      vector<integer> var( t.var );
+      std::sort( var.begin(), var.end() );
+      monomial m;
+      m.eq    = t.eq;
+      m.col   = -1;
+      m.coeff = t.coeff;
+      for ( integer v : var ) {
+        UTILS_ASSERT(
+          v >= 0 && v < m_n,
+          "IntervalSolver, `{}` bad variable index {}", P.title(), v
+        );
+        if ( !m.pow.empty() && m.pow.back().first == v ) ++m.pow.back().second;
+        else m.pow.push_back( pair<integer,integer>( v, 1 ) );
+      }
+      m_F_terms.push_back( m );
+    }
+
+    // J: derivative of each monomial for each of its variables
+    m_J_terms.clear();
+    for ( auto const & m : m_F_terms ) {
+      for ( size_t k = 0; k < m.pow.size(); ++k ) {
+        monomial d;
+        d.eq    = m.eq;
+        d.col   = m.pow[k].first;
+        d.coeff = m.coeff * m.pow[k].second;
+        d.pow   = m.pow;
+        if ( --d.pow[k].second == 0 ) d.pow.erase( d.pow.begin()+k );
+        m_J_terms.push_back( d );
+      }
+    }
+
+    for ( auto & W : m_work ) {
+      W.FL.resize( m_n ); W.FH.resize( m_n );
+      W.TL.resize( m_F_terms.size() ); W.TH.resize( m_F_terms.size() );
+      W.JL.resize( m_n, m_n ); W.JH.resize( m_n, m_n );
+      W.found.clear();
+      W.num_F = W.num_J = 0;
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  IntervalSolver::evalTerms(
+    vector<monomial> const & terms,
+    dvec_t           const & XL,
+    dvec_t           const & XH,
+    real_type              * lo,
+    real_type              * hi,
+    integer                  ld
+  ) const {
+    for ( auto const & t : terms ) {
+      real_type a = t.coeff, b = t.coeff;
+      for ( auto const & vp : t.pow ) {
+        real_type c, d;
+        ipow( XL(vp.first), XH(vp.first), vp.second, c, d );
+        imul( a, b, c, d );
+      }
+      integer k = t.eq + max( t.col, integer(0) ) * ld;
+      lo[k] = down( lo[k] + a );
+      hi[k] = up( hi[k] + b );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  IntervalSolver::project( workspace & W ) const {
+    integer const nt = integer(m_F_terms.size());
+    W.FL.setZero(); W.FH.setZero();
+    for ( integer k = 0; k < nt; ++k ) {
+      monomial const & t = m_F_terms[size_t(k)];
+      real_type a = t.coeff, b = t.coeff;
+      for ( auto const & vp : t.pow ) {
+        real_type c, d;
+        ipow( W.XL(vp.first), W.XH(vp.first), vp.second, c, d );
+        imul( a, b, c, d );
+      }
+      W.TL[size_t(k)] = a;
+      W.TH[size_t(k)] = b;
+      W.FL(t.eq) = down( W.FL(t.eq) + a );
+      W.FH(t.eq) = up( W.FH(t.eq) + b );
+    }
+    ++W.num_F;
+    for ( integer i = 0; i < m_n; ++i )
+      if ( W.FL(i) > 0 || W.FH(i) < 0 ) return false;
+    if ( !W.FL.allFinite() || !W.FH.allFinite() ) return true;
+
+    for ( integer k = 0; k < nt; ++k ) {
+      monomial const & t = m_F_terms[size_t(k)];
+      // the term is in minus the sum of the others
+      real_type tl = -up( W.FH(t.eq) - W.TH[size_t(k)] );
+      real_type th = -down( W.FL(t.eq) - W.TL[size_t(k)] );
+      for ( size_t f = 0; f < t.pow.size(); ++f ) {
+        integer v = t.pow[f].first;
+        integer p = t.pow[f].second;
+        real_type a = t.coeff, b = t.coeff;
+        for ( size_t g = 0; g < t.pow.size(); ++g ) {
+          if ( g == f ) continue;
+          real_type c, d;
+          ipow( W.XL(t.pow[g].first), W.XH(t.pow[g].first), t.pow[g].second, c, d );
+          imul( a, b, c, d );
+        }
+        if ( a <= 0 && b >= 0 ) continue;
+        real_type ql = tl, qh = th;
+        idiv( ql, qh, a, b );
+        if ( !std::isfinite(ql) || !std::isfinite(qh) ) continue;
+
+        // x_v^p in [ql,qh]
+        real_type xl, xh, rl, rh;
+        if ( p == 1 ) {
+          xl = ql; xh = qh;
+        } else if ( (p & 1) != 0 ) {
+          iroot( ql, p, rl, rh ); xl = ql >= 0 ? rl : -rh;
+          iroot( qh, p, rl, rh ); xh = qh >= 0 ? rh : -rl;
+        } else {
+          if ( qh < 0 ) return false;
+          real_type sl, sh;
+          iroot( qh, p, rl, rh );
+          iroot( max( ql, real_type(0) ), p, sl, sh );
+          // |x_v| in [sl,rh], keep the side of the box if only one is possible
+          if      ( W.XL(v) > -sl ) { xl = sl;  xh = rh; }
+          else if ( W.XH(v) <  sl ) { xl = -rh; xh = -sl; }
+          else                      { xl = -rh; xh = rh; }
+        }
+        W.XL(v) = max( W.XL(v), xl );
+        W.XH(v) = min( W.XH(v), xh );
+        if ( W.XL(v) > W.XH(v) ) return false;
+      }
+    }
+    return true;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  IntervalSolver::krawczyk( workspace & W ) const {
+    integer const n = m_n;
+    real_type const g = (n+3)*r_u/(1-(n+3)*r_u);
+
+    // F(m) and F'(X)
+    W.m = 0.5*(W.XL+W.XH);
+    W.FL.setZero(); W.FH.setZero();
+    evalTerms( m_F_terms, W.m, W.m, W.FL.data(), W.FH.data(), n );
+    W.JL.setZero(); W.JH.setZero();
+    evalTerms( m_J_terms, W.XL, W.XH, W.JL.data(), W.JH.data(), n );
+    ++W.num_F;
+    ++W.num_J;
+    if ( !W.FL.allFinite() || !W.FH.allFinite() ||
+         !W.JL.allFinite() || !W.JH.allFinite() ) return false;
+    midRad( W.FL, W.FH, W.Fm, W.Fr );
+    midRad( W.JL, W.JH, W.Jm, W.Jr );
+
+    W.LU.compute( W.Jm );
+    if ( !(W.LU.rcond() > 1e-14) ) return false;
+    W.Y = W.LU.inverse();
+
+    // C = I - Y F'(X)
+    dmat_t const aY = W.Y.cwiseAbs();
+    W.C.noalias() = -W.Y * W.Jm;
+    W.C.diagonal().array() += 1;
+    W.Cr.noalias() = aY * W.Jr;
+    W.Cr *= 1+g;
+    W.Cr.noalias() += g * ( aY * W.Jm.cwiseAbs() );
+    W.Cr.diagonal().array() += g;
+    W.Cr.array() += r_tiny;
+
+    // X - m
+    W.t  = W.XL - W.m;
+    W.kr = W.XH - W.m;
+    W.dm = 0.5*(W.t+W.kr);
+    W.dr = ( ( (W.kr-W.dm).cwiseMax(W.dm-W.t) +
+               r_u*(W.t.cwiseAbs()+W.kr.cwiseAbs()) ) * (1+4*r_u) ).array() + r_tiny;
+
+    // K = m - Y F(m) + C (X - m)
+    W.t.noalias() = W.Y * W.Fm;
+    W.km.noalias() = W.C * W.dm;
+    W.kr.noalias() = aY * W.Fr;
+    W.kr.noalias() += g * ( aY * W.Fm.cwiseAbs() );
+    W.kr.noalias() += W.C.cwiseAbs() * W.dr;
+    W.kr.noalias() += W.Cr * ( W.dm.cwiseAbs() + W.dr );
+    W.kr.noalias() += g * ( W.C.cwiseAbs() * W.dm.cwiseAbs() );
+    W.kr *= 1+g;
+    W.kr.noalias() += g * ( W.m.cwiseAbs() + W.t.cwiseAbs() + W.km.cwiseAbs() );
+    W.km += W.m - W.t;
+    W.kr.array() += r_tiny;
+    W.kr *= 1+4*r_u;
+    return W.km.allFinite() && W.kr.allFinite();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  static
+  real_type
+  boxWidth( dvec_t const & L, dvec_t const & H, integer & imax ) {
+    real_type w = 0;
+    imax = 0;
+    for ( integer i = 0; i < L.size(); ++i ) {
+      real_type wi = (H(i)-L(i))/max( real_type(1), max( std::abs(L(i)), std::abs(H(i)) ) );
+      if ( wi > w ) { w = wi; imax = i; }
+    }
+    return w;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  integer
+  IntervalSolver::prune( workspace & W ) const {
+    integer const n = m_n;
+    integer   imax;
+    real_type w = boxWidth( W.XL, W.XH, imax );
+    bool      proved = false;
+    for ( integer iter = 0; iter < 50; ++iter ) {
+      if ( !project( W ) ) return -1;
+      if ( !krawczyk( W ) ) {
+        // progress of the projection alone
+        real_type w1 = boxWidth( W.XL, W.XH, imax );
+        if ( w1 > (1-m_min_reduce)*w ) break;
+        w = w1;
+        continue;
+      }
+      bool inner = true;
+      for ( integer i = 0; i < n; ++i ) {
+        real_type kl = down( W.km(i) - W.kr(i) );
+        real_type kh = up( W.km(i) + W.kr(i) );
+        inner = inner && kl > W.XL(i) && kh < W.XH(i);
+        W.XL(i) = max( W.XL(i), kl );
+        W.XH(i) = min( W.XH(i), kh );
+        if ( W.XL(i) > W.XH(i) ) return -1;
+      }
+      proved = proved || inner;
+
+      real_type w1 = boxWidth( W.XL, W.XH, imax );
+      if ( proved && w1 <= m_tol_width ) break;
+      if ( w1 > (1-m_min_reduce)*w ) break;
+      w = w1;
+    }
+    return proved ? 1 : 0;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  IntervalSolver::pushBox( unsigned iw, box_t & B ) {
+    ++m_pending;
+    boxQueue & Q = m_queues[iw];
+    std::lock_guard<std::mutex> lock( Q.mtx );
+    Q.boxes.push_back( box_t() );
+    Q.boxes.back().swap( B );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  IntervalSolver::popBox( unsigned iw, box_t & B ) {
+    {
+      boxQueue & Q = m_queues[iw];
+      std::lock_guard<std::mutex> lock( Q.mtx );
+      if ( !Q.boxes.empty() ) {
+        B.swap( Q.boxes.back() );
+        Q.boxes.pop_back();
+        return true;
+      }
+    }
+    // steal the oldest (largest) box of the other queues
+    unsigned nq = unsigned(m_queues.size());
+    for ( unsigned k = 1; k < nq; ++k ) {
+      boxQueue & Q = m_queues[(iw+k)%nq];
+      std::lock_guard<std::mutex> lock( Q.mtx );
+      if ( !Q.boxes.empty() ) {
+        B.swap( Q.boxes.front() );
+        Q.boxes.pop_front();
+        ++m_num_steal;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  IntervalSolver::processBox( unsigned iw, box_t & B ) {
+    workspace & W = m_work[iw];
+    integer const n = m_n;
+    W.XL = Eigen::Map<dvec_t>( B.data(), n );
+    W.XH = Eigen::Map<dvec_t>( B.data()+n, n );
+
+    // cancelled or out of budget, the box is left as it is
+    if ( m_halted || mustStop( m_boxes_F ) ) {
+      m_halted   = true;
+      m_complete = false;
+      solutionBox S;
+      S.lo     = W.XL;
+      S.hi     = W.XH;
+      S.status = BOX_UNDECIDED;
+      W.found.push_back( S );
+      return;
+    }
+    ++m_num_boxes;
+
+    integer status = prune( W );
+    if ( status < 0 ) return;
+
+    integer   imax;
+    real_type w = boxWidth( W.XL, W.XH, imax );
+    if ( status > 0 || w <= m_min_width || m_num_boxes >= m_max_boxes ) {
+      if ( status == 0 && w > m_min_width ) m_complete = false;
+      solutionBox S;
+      S.lo     = W.XL;
+      S.hi     = W.XH;
+      S.status = status > 0 ? BOX_UNIQUE : BOX_UNDECIDED;
+      W.found.push_back( S );
+      return;
+    }
+
+    // bisect the side of maximum smear max_i |J_ij| w_j
+    W.JL.setZero(); W.JH.setZero();
+    evalTerms( m_J_terms, W.XL, W.XH, W.JL.data(), W.JH.data(), n );
+    ++W.num_J;
+    real_type smax = 0;
+    for ( integer j = 0; j < n; ++j ) {
+      real_type sj = (W.XH(j)-W.XL(j)) *
+                     max( W.JL.col(j).cwiseAbs().maxCoeff(), W.JH.col(j).cwiseAbs().maxCoeff() );
+      if ( sj > smax && std::isfinite(sj) ) { smax = sj; imax = j; }
+    }
+
+    // bisect a bit off center, a root on the cut can not be proved
+    real_type c = W.XL(imax) + 0.4921875*(W.XH(imax)-W.XL(imax));
+    box_t B1( size_t(2*n) );
+    Eigen::Map<dvec_t>( B.data(), n )     = W.XL;
+    Eigen::Map<dvec_t>( B.data()+n, n )   = W.XH;
+    std::copy( B.begin(), B.end(), B1.begin() );
+    B[size_t(n+imax)] = c;
+    B1[size_t(imax)]  = c;
+    pushBox( iw, B1 );
+    pushBox( iw, B );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  IntervalSolver::mergeUndecided() {
+    // hull of the clusters of touching undecided boxes
+    vector<solutionBox> U;
+    size_t ns = 0;
+    for ( auto & S : m_solutions ) {
+      if ( S.status == BOX_UNDECIDED ) U.push_back( S );
+      else m_solutions[ns++] = S;
+    }
+    m_solutions.resize( ns );
+    bool merged = true;
+    while ( merged ) {
+      merged = false;
+      for ( size_t i = 0; i < U.size() && !merged; ++i ) {
+        for ( size_t j = i+1; j < U.size() && !merged; ++j ) {
+          bool touch = (U[i].lo.array() <= U[j].hi.array()).all() &&
+                       (U[j].lo.array() <= U[i].hi.array()).all();
+          if ( touch ) {
+            U[i].lo = U[i].lo.cwiseMin( U[j].lo );
+            U[i].hi = U[i].hi.cwiseMax( U[j].hi );
+            U.erase( U.begin()+j );
+            merged = true;
+          }
+        }
+      }
+    }
+    m_solutions.insert( m_solutions.end(), U.begin(), U.end() );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  IntervalSolver::solveAll( nonlinearSystem const & P ) {
+    Utils::TicToc tictoc;
+    tictoc.tic();
+    resetStatistics();
+    m_num_boxes = 0;
+    m_num_steal = 0;
+    m_pending   = 0;
+    m_complete  = true;
+    m_halted    = false;
+    m_boxes_F   = 0;
+
+    setupSystem( P );
+
+    for ( auto & Q : m_queues ) Q.boxes.clear();
+    box_t B0( size_t(2*m_n) );
+    Eigen::Map<dvec_t>( B0.data(), m_n )      = m_L;
+    Eigen::Map<dvec_t>( B0.data()+m_n, m_n )  = m_U;
+    pushBox( 0, B0 );
+
+    auto worker = [this]( unsigned iw ) -> void {
+      box_t B;
+      while ( true ) {
+        if ( popBox( iw, B ) ) {
+          integer F0 = m_work[iw].num_F;
+          processBox( iw, B );
+          m_boxes_F += m_work[iw].num_F - F0;
+          --m_pending; // after the children are queued
+        } else if ( m_pending.load() == 0 ) {
+          break;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    };
+
+    unsigned nw = m_parallel ? m_pool.size() : 1;
+    if ( nw == 1 ) {
+      worker( 0 );
+    } else {
+      for ( unsigned iw = 0; iw < nw; ++iw ) m_pool.run( iw, worker, iw );
+      m_pool.wait_all();
+    }
+
+    m_solutions.clear();
+    for ( auto & W : m_work ) {
+      m_solutions.insert( m_solutions.end(), W.found.begin(), W.found.end() );
+      m_num_F += W.num_F;
+      m_num_J += W.num_J;
+    }
+    m_stopped = m_halted;
+    mergeUndecided();
+    std::sort(
+      m_solutions.begin(), m_solutions.end(),
+      []( solutionBox const & a, solutionBox const & b ) -> bool {
+        if ( a.status != b.status ) return a.status < b.status;
+        return std::lexicographical_compare(
+          a.lo.data(), a.lo.data()+a.lo.size(),
+          b.lo.data(), b.lo.data()+b.lo.size()
+        );
+      }
+    );
+    m_num_iter = m_num_boxes;
+
+    tictoc.toc();
+    m_elapsed_ms = tictoc.elapsed_ms();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  IntervalSolver::solve( nonlinearSystem const & P, dvec_t & x ) {
+    solveAll( P );
+    m_converged = false;
+    m_norm_F    = real_max;
+    dvec_t    r( m_n ), f( m_n );
+    real_type best = real_max;
+    for ( auto const & S : m_solutions ) {
+      if ( S.status != BOX_UNIQUE ) continue;
+      r = 0.5*(S.lo+S.hi);
+      real_type d = (r-x).norm();
+      if ( d < best ) {
+        best = d;
+        P.evalF( r, f );
+        m_norm_F    = f.norm();
+        m_converged = true;
+        x           = r;
+      }
+    }
+    return m_converged;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  integer
+  IntervalSolver::numSolutions( boxStatus s ) const {
+    integer count = 0;
+    for ( auto const & S : m_solutions ) if ( S.status == s ) ++count;
+    return count;
+  }
+
+}
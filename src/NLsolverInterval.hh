@@ -0,0 +1,208 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+#ifndef NL_SOLVER_INTERVAL_HH
+#define NL_SOLVER_INTERVAL_HH
+
+#include "NLsolver.hh"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+namespace NLproblem {
+
+  /*\
+   |   ___       _                       _
+   |  |_ _|_ __ | |_ ___ _ ____   ____ _| |
+   |   | || '_ \| __/ _ \ '__\ \ / / _` | |
+   |   | || | | | ||  __/ |   \ V / (_| | |
+   |  |___|_| |_|\__\___|_|    \_/ \__,_|_|
+  \*/
+
+  //!
+  //! Interval branch and prune for the problems with `isPolynomial()`.
+  //!
+  //! The interval extensions of \f$ F \f$ and of its jacobian are built
+  //! from `polynomialForm` (repeated variables are powers, so that
+  //! \f$ x^2 \geq 0 \f$ also on boxes containing zero) and every
+  //! operation is rounded outward.
+  //! A box \f$ X \f$ is discarded when \f$ 0 \notin F_i(X) \f$ for some
+  //! \f$ i \f$, otherwise it is contracted projecting each equation on
+  //! the variables of its terms and then with the Krawczyk operator
+  //! \f[
+  //!   K(X) = m - Y F(m) + (I - Y F'(X))(X-m),
+  //!   \qquad m = \mathrm{mid}(X),\; Y \approx \mathrm{mid}(F'(X))^{-1}
+  //! \f]
+  //! which contains all the roots in \f$ X \f$: \f$ X \cap K(X) = \emptyset \f$
+  //! proves that there are none and \f$ K(X) \subset \mathrm{int}(X) \f$
+  //! that there is exactly one, then the box is shrunk around it.
+  //! When the contraction stalls the box is bisected along the side of
+  //! maximum smear \f$ \max_i |F'_{ij}(X)|\, w_j \f$, the boxes smaller
+  //! than `min_width` that are not proved are returned as undecided
+  //! (singular roots, clusters).
+  //!
+  //! The linear algebra of \f$ K(X) \f$ is done in midpoint-radius form
+  //! with dense Eigen products, the rounding errors are added to the
+  //! radii with the usual \f$ \gamma_n \f$ bounds.
+  //! Each worker of the thread pool processes its own stack of boxes
+  //! (depth first) and when empty steals the largest boxes from the
+  //! front of the stacks of the others.
+  //! The cancel flags and the budgets are checked before each box: when
+  //! the run must stop the boxes left are returned as undecided, so the
+  //! result still encloses all the roots (and it is not `complete()`).
+  //!
+  class IntervalSolver : public NLsolver {
+  public:
+
+    enum boxStatus { BOX_UNIQUE, BOX_UNDECIDED };
+
+    //! a box \f$ [lo,hi] \f$ with a root
+    struct solutionBox {
+      dvec_t    lo, hi;
+      boxStatus status;
+    };
+
+  private:
+
+    //! lower bounds in `[0,n)`, upper bounds in `[n,2n)`
+    typedef vector<real_type> box_t;
+
+    //! \f$ c \prod_k x_{v_k}^{p_k} \f$ added to `F(eq)` or to `J(eq,col)`
+    struct monomial {
+      integer                        eq;
+      integer                        col;   // -1 for F
+      real_type                      coeff;
+      vector<pair<integer,integer> > pow;   // (variable,power)
+    };
+
+    //! workspace of a worker
+    struct workspace {
+      dvec_t FL, FH, XL, XH, m, Fm, Fr, dm, dr, km, kr, t;
+      vector<real_type> TL, TH; // enclosures of the terms of F
+      dmat_t JL, JH, Jm, Jr, Y, C, Cr;
+      Eigen::PartialPivLU<dmat_t> LU;
+      vector<solutionBox> found;
+      integer num_F;
+      integer num_J;
+    };
+
+    struct boxQueue {
+      std::mutex        mtx;
+      std::deque<box_t> boxes;
+    };
+
+    Utils::ThreadPool m_pool;
+
+    // parameters
+    real_type m_min_width;  // undecided below this width (relative)
+    real_type m_tol_width;  // width of a proved box (relative)
+    real_type m_min_reduce; // bisect when the width is reduced less than this
+    integer   m_max_boxes;
+    bool      m_parallel;
+
+    // system
+    integer          m_n;
+    vector<monomial> m_F_terms, m_J_terms;
+    dvec_t           m_L, m_U;
+    bool             m_box_set;
+
+    vector<workspace> m_work;
+    vector<boxQueue>  m_queues;
+
+    vector<solutionBox> m_solutions;
+
+    std::atomic<integer> m_pending;   // boxes queued or in process
+    std::atomic<integer> m_num_boxes;
+    std::atomic<integer> m_num_steal;
+    std::atomic<bool>    m_complete;
+    std::atomic<bool>    m_halted;    // cancelled or out of budget
+    std::atomic<integer> m_boxes_F;   // evaluations of the boxes processed so far
+
+    void setupSystem( nonlinearSystem const & P );
+
+    //! enclosure of the terms on the box `XL`,`XH`
+    void
+    evalTerms(
+      vector<monomial> const & terms,
+      dvec_t           const & XL,
+      dvec_t           const & XH,
+      real_type              * lo,
+      real_type              * hi,
+      integer                  ld
+    ) const;
+
+    //!
+    //! Contract `W.XL`,`W.XH` projecting each equation on the variables
+    //! of each term: \f$ c\, x_v^p R \in -\sum_{j\neq k} T_j \f$ gives an
+    //! enclosure of \f$ x_v \f$ when \f$ 0 \notin R \f$.
+    //! Return `false` if the box has no root.
+    //!
+    bool project( workspace & W ) const;
+
+    //! \f$ K(X) \f$ in midpoint-radius form (`km`,`kr`), `false` if
+    //! \f$ \mathrm{mid}(F'(X)) \f$ is singular
+    bool krawczyk( workspace & W ) const;
+
+    //! contract the box in `W.XL`,`W.XH`: -1 empty, 1 proved, 0 undecided
+    integer prune( workspace & W ) const;
+
+    void processBox( unsigned iw, box_t & B );
+    void pushBox( unsigned iw, box_t & B );
+    bool popBox( unsigned iw, box_t & B );
+    void mergeUndecided();
+
+  public:
+
+    explicit
+    IntervalSolver( unsigned nthreads = max( unsigned(1), unsigned(std::thread::hardware_concurrency()) ) );
+
+    virtual ~IntervalSolver() {}
+
+    void setMinWidth( real_type w )      { m_min_width = w; }
+    void setTolWidth( real_type w )      { m_tol_width = w; }
+    void setMinReduction( real_type r )  { m_min_reduce = r; }
+    void setMaxBoxes( integer mb )       { m_max_boxes = mb; }
+    void setParallel( bool yes )         { m_parallel = yes; }
+
+    //!
+    //! The initial box, used in place of `boundingBox` of the problem.
+    //! Without it the bounding box must be finite.
+    //!
+    void setBox( dvec_t const & L, dvec_t const & U );
+    void clearBox() { m_box_set = false; }
+
+    //!
+    //! Enclose all the roots of `P` in the initial box. The search is
+    //! exhaustive when `complete()` is `true`: every root is in one of
+    //! the returned boxes and each `BOX_UNIQUE` box has exactly one.
+    //!
+    void solveAll( nonlinearSystem const & P );
+
+    //!
+    //! `solveAll` then `x` is set to the midpoint of the proved box
+    //! closest to `x`. Return `true` if there is one.
+    //!
+    bool solve( nonlinearSystem const & P, dvec_t & x ) override;
+
+    bool     complete()   const { return m_complete.load(); }
+    integer  numBoxes()   const { return m_num_boxes.load(); }
+    integer  numSteal()   const { return m_num_steal.load(); }
+    unsigned numThreads() const { return m_pool.size(); }
+
+    integer numSolutions() const { return integer(m_solutions.size()); }
+    integer numSolutions( boxStatus s ) const;
+    solutionBox const & solution( integer i ) const { return m_solutions[size_t(i)]; }
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,281 @@
+#include "NLsolverLevenbergMarquardt.hh"
+#include <algorithm>
+
+namespace NLproblem {
+
+  LevenbergMarquardtSolver::LevenbergMarquardtSolver(
+    bool geodesic,
+    bool second_order
+  )
+  : NLsolver(
+    string( "LM" ) +
+    string( geodesic ? "-geo" : "" ) +
+    string( second_order ? "-2nd" : "" )
+  )
+  , m_geodesic(geodesic)
+  , m_second_order(second_order)
+  , m_grad_tol(1e-12)
+  , m_step_tol(1e-15)
+  , m_tau(1e-3)
+  , m_geo_h(0.1)
+  , m_geo_ratio(0.75)
+  , m_mu(0)
+  , m_norm_F_inf(real_max)
+  , m_num_reject(0)
+  {}
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  LevenbergMarquardtSolver::setup( nonlinearLeastSquares const & LS ) {
+    integer const nF   = LS.dimF();
+    integer const nX   = LS.dimX();
+    integer const nnzJ = LS.jacobianNnz();
+
+    typedef Eigen::Triplet<real_type,integer> T;
+    vector<T> triplets;
+
+    // jacobian n x m
+    ivec_t I( nnzJ ), J( nnzJ );
+    LS.jacobianPattern( I, J );
+    triplets.reserve( size_t(nnzJ) );
+    for ( integer k = 0; k < nnzJ; ++k ) {
+      UTILS_ASSERT(
+        I(k) >= 0 && I(k) < nF && J(k) >= 0 && J(k) < nX,
+        "LevenbergMarquardtSolver::setup, bad pattern (i,j) = ({},{}) at k = {}",
+        I(k), J(k), k
+      );
+      triplets.push_back( T( I(k), J(k), 1 ) );
+    }
+    m_J.resize( nF, nX );
+    m_J.setFromTriplets( triplets.begin(), triplets.end() );
+    m_J.makeCompressed();
+
+    m_posJ.resize( nnzJ );
+    {
+      integer const * outer = m_J.outerIndexPtr();
+      integer const * inner = m_J.innerIndexPtr();
+      for ( integer k = 0; k < nnzJ; ++k ) {
+        integer const * lo = inner + outer[J(k)];
+        integer const * hi = inner + outer[J(k)+1];
+        m_posJ(k) = integer( std::lower_bound( lo, hi, I(k) ) - inner );
+      }
+    }
+    m_valJ.resize( nnzJ );
+
+    // lower part of J^T J (all ones: no cancellation in the pattern),
+    // the diagonal and the tensor
+    spmat_t JtJ = spmat_t( m_J.transpose() ) * m_J;
+    triplets.clear();
+    triplets.reserve( size_t(JtJ.nonZeros()/2+nX) );
+    for ( integer j = 0; j < nX; ++j ) {
+      triplets.push_back( T( j, j, 0 ) );
+      for ( spmat_t::InnerIterator it(JtJ,j); it; ++it )
+        if ( it.row() > j ) triplets.push_back( T( it.row(), j, 0 ) );
+    }
+    ivec_t TI, TJ;
+    if ( m_second_order ) {
+      integer const nnzT = LS.tensorNnz();
+      TI.resize( nnzT );
+      TJ.resize( nnzT );
+      LS.tensorPattern( TI, TJ );
+      for ( integer k = 0; k < nnzT; ++k ) {
+        UTILS_ASSERT(
+          TI(k) >= TJ(k) && TJ(k) >= 0 && TI(k) < nX,
+          "LevenbergMarquardtSolver::setup, bad tensor pattern (i,j) = ({},{})",
+          TI(k), TJ(k)
+        );
+        triplets.push_back( T( TI(k), TJ(k), 0 ) );
+      }
+    }
+    m_A.resize( nX, nX );
+    m_A.setFromTriplets( triplets.begin(), triplets.end() );
+    m_A.makeCompressed();
+
+    integer const * outer = m_A.outerIndexPtr();
+    integer const * inner = m_A.innerIndexPtr();
+    m_diag.resize( nX );
+    for ( integer j = 0; j < nX; ++j ) m_diag(j) = outer[j]; // rows sorted, i >= j
+    m_posT.resize( TI.size() );
+    for ( integer k = 0; k < TI.size(); ++k ) {
+      integer const * lo = inner + outer[TJ(k)];
+      integer const * hi = inner + outer[TJ(k)+1];
+      m_posT(k) = integer( std::lower_bound( lo, hi, TI(k) ) - inner );
+    }
+    m_valT.resize( TI.size() );
+
+    m_M = m_A;
+    m_LDLT.analyzePattern( m_M );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  LevenbergMarquardtSolver::evalJacobian(
+    nonlinearLeastSquares const & LS,
+    dvec_t                const & x,
+    dvec_t                const & F
+  ) {
+    ++m_num_J;
+    LS.jacobian( x, m_valJ );
+    real_type * VJ = m_J.valuePtr();
+    m_J.coeffs().setZero();
+    uint64_t bad = 0;
+    for ( integer k = 0; k < m_valJ.size(); ++k ) {
+      VJ[m_posJ(k)] += m_valJ(k);
+      bad |= nonFiniteBit( m_valJ(k) );
+    }
+    if ( bad != 0 ) return false;
+
+    // A(i,j) = J(:,i)^T J(:,j) on the lower pattern
+    real_type * VA = m_A.valuePtr();
+    for ( integer j = 0; j < m_A.cols(); ++j )
+      for ( spmat_t::InnerIterator it(m_A,j); it; ++it )
+        it.valueRef() = m_J.col(it.row()).dot( m_J.col(j) );
+
+    if ( m_second_order && m_valT.size() > 0 ) {
+      LS.tensor( x, F, m_valT );
+      for ( integer k = 0; k < m_valT.size(); ++k ) {
+        VA[m_posT(k)] += m_valT(k);
+        bad |= nonFiniteBit( m_valT(k) );
+      }
+    }
+    return bad == 0;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  LevenbergMarquardtSolver::factorizeShifted( dvec_t const & D ) {
+    NL_TRACE_SCOPE( "factorize", m_num_factorize );
+    ++m_num_factorize;
+    m_M.coeffs() = m_A.coeffs();
+    real_type * V = m_M.valuePtr();
+    for ( integer j = 0; j < D.size(); ++j ) V[m_diag(j)] += m_mu * D(j);
+    m_LDLT.factorize( m_M );
+    // the second order model may be indefinite: ask for a larger mu
+    return m_LDLT.info() == Eigen::Success && m_LDLT.vectorD().minCoeff() > 0;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  LevenbergMarquardtSolver::solve( nonlinearLeastSquares const & LS, dvec_t & x ) {
+    Utils::TicToc tictoc;
+    tictoc.tic();
+    resetStatistics();
+    m_num_reject = 0;
+
+    integer const nF = LS.dimF();
+    integer const nX = LS.dimX();
+    dvec_t F(nF), F1(nF), Fh(nF), Jv(nF);
+    dvec_t g(nX), v(nX), a(nX), s(nX), x1(nX), D(nX), As(nX);
+
+    setup( LS );
+
+    ++m_num_F;
+    LS.evalF( x, F );
+    m_norm_F = F.norm();
+
+    real_type g_inf = real_max;
+    if ( std::isfinite(m_norm_F) && evalJacobian( LS, x, F ) ) {
+      g = m_J.transpose() * F;
+      g_inf = g.lpNorm<Eigen::Infinity>();
+
+      // Moré scaling: running maximum of diag(A), zero columns are not scaled
+      real_type const * VA = m_A.valuePtr();
+      for ( integer j = 0; j < nX; ++j ) {
+        real_type d = VA[m_diag(j)];
+        D(j) = d > 0 ? d : 1;
+      }
+      m_mu = m_tau * D.maxCoeff();
+      real_type nu = 2;
+
+      for ( m_num_iter = 0; m_num_iter < m_max_iter; ++m_num_iter ) {
+        if ( F.lpNorm<Eigen::Infinity>() <= m_tolerance || g_inf <= m_grad_tol ) break;
+        if ( m_mu > 1e30 || stopRequested() ) break;
+
+        bool ok = factorizeShifted( D );
+        if ( ok ) {
+          v = m_LDLT.solve( -g );
+          s = v;
+          if ( m_geodesic ) {
+            // F''(x)[v,v] ~ 2/h ( (F(x+h*v)-F(x))/h - J*v )
+            x1 = x + m_geo_h * v;
+            if ( isAdmissible( LS, x1 ) ) {
+              ++m_num_F;
+              if ( LS.safeEvalF( x1, Fh ) < 0 ) {
+                Jv = m_J * v;
+                Fh = (2/m_geo_h) * ( (Fh-F)/m_geo_h - Jv );
+                if ( firstNonFinite( Fh ) < 0 ) {
+                  a = m_LDLT.solve( -( m_J.transpose() * Fh ) );
+                  if ( 2*a.norm() <= m_geo_ratio * v.norm() ) s += 0.5 * a;
+                }
+              }
+            }
+          }
+        }
+
+        if ( ok ) {
+          if ( s.norm() <= m_step_tol * ( x.norm() + m_step_tol ) ) break;
+          x1 = x + s;
+          ok = isAdmissible( LS, x1 );
+        }
+
+        real_type rho = -1;
+        if ( ok ) {
+          ++m_num_F;
+          real_type normF1 = real_max;
+          if ( LS.safeEvalF( x1, F1 ) < 0 ) { // otherwise reject at once
+            normF1 = F1.norm();
+            As = m_A.selfadjointView<Eigen::Lower>() * s;
+            real_type pred = -( g.dot(s) + 0.5 * s.dot(As) );
+            if ( std::isfinite(normF1) && pred > 0 )
+              rho = 0.5 * ( m_norm_F - normF1 ) * ( m_norm_F + normF1 ) / pred;
+          }
+          if ( rho > 0 ) {
+            x.swap(x1);
+            F.swap(F1);
+            m_norm_F = normF1;
+            if ( !evalJacobian( LS, x, F ) ) { g_inf = real_max; break; }
+            g     = m_J.transpose() * F;
+            g_inf = g.lpNorm<Eigen::Infinity>();
+            real_type const * VA = m_A.valuePtr();
+            for ( integer j = 0; j < nX; ++j ) D(j) = max( D(j), VA[m_diag(j)] );
+            real_type t = 2*rho-1;
+            m_mu *= max( real_type(1)/3, 1-t*t*t );
+            nu    = 2;
+          }
+        }
+
+        if ( rho <= 0 ) {
+          ++m_num_reject;
+          m_mu *= nu;
+          nu   *= 2;
+        }
+      }
+    }
+
+    m_norm_F_inf = F.lpNorm<Eigen::Infinity>();
+    m_converged  = m_norm_F_inf <= m_tolerance || g_inf <= m_grad_tol;
+
+    tictoc.toc();
+    m_elapsed_ms = tictoc.elapsed_ms();
+    return m_converged;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  LevenbergMarquardtSolver::solve( nonlinearSystem const & P, dvec_t & x ) {
+    nonlinearLeastSquaresFromSystem LS( &P );
+    // small J^T F is not a reason to stop when looking for a root
+    real_type grad_tol = m_grad_tol;
+    m_grad_tol = 0;
+    solve( LS, x );
+    m_grad_tol  = grad_tol;
+    m_converged = m_norm_F_inf <= m_tolerance;
+    return m_converged;
+  }
+
+}
@@ -0,0 +1,130 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+#ifndef NL_SOLVER_LEVENBERG_MARQUARDT_HH
+#define NL_SOLVER_LEVENBERG_MARQUARDT_HH
+
+#include "NLsolver.hh"
+
+#include <Eigen/SparseCholesky>
+
+namespace NLproblem {
+
+  /*\
+   |   _     __  __
+   |  | |   |  \/  |
+   |  | |   | |\/| |
+   |  | |___| |  | |
+   |  |_____|_|  |_|
+  \*/
+
+  //!
+  //! Sparse Levenberg-Marquardt method for \f$ \min \frac{1}{2}\|F(x)\|^2 \f$
+  //! with \f$ F:\mathbb{R}^m\to\mathbb{R}^n \f$, \f$ n \geq m \f$.
+  //!
+  //! The step solves the damped normal equations
+  //!
+  //! \f[
+  //!   ( A + \mu D ) v = -J^T F, \qquad A = J^T J
+  //! \f]
+  //!
+  //! where \f$ D \f$ is the running maximum of \f$ \mathrm{diag}(A) \f$
+  //! (Moré scaling). The pattern of \f$ A \f$ is computed once and the
+  //! symbolic analysis of the sparse \f$ LDL^T \f$ factorization is reused
+  //! for all the iterations. \f$ \mu \f$ is updated with the gain ratio
+  //! (Nielsen rule).
+  //!
+  //! Options:
+  //!
+  //! - geodesic acceleration (Transtrum and Sethna 2012): the second
+  //!   directional derivative \f$ F''(x)[v,v] \f$ is approximated with
+  //!   one more residual evaluation and the correction \f$ a \f$ solves
+  //!   the same factorized system; the step is \f$ v+a/2 \f$, or \f$ v \f$
+  //!   when \f$ 2\|a\|/\|v\| \f$ exceeds `geo_ratio`;
+  //! - second order model: \f$ A = J^T J + \sum_k F_k \nabla^2 F_k \f$
+  //!   built with `tensor()`, useful for large residual problems.
+  //!
+  //! A square system is solved through `nonlinearLeastSquaresFromSystem`.
+  //!
+  class LevenbergMarquardtSolver : public NLsolver {
+
+    typedef Eigen::SimplicialLDLT<spmat_t,Eigen::Lower,Eigen::AMDOrdering<integer> > LDLT_t;
+
+    bool      m_geodesic;
+    bool      m_second_order;
+    real_type m_grad_tol;  // tolerance on ||J^T F||_inf
+    real_type m_step_tol;  // relative tolerance on the step
+    real_type m_tau;       // initial mu = tau * max(diag(A))
+    real_type m_geo_h;     // finite difference step of F''(x)[v,v]
+    real_type m_geo_ratio; // maximum 2||a||/||v||
+
+    // jacobian (n x m) and its pattern
+    spmat_t m_J;
+    ivec_t  m_posJ;
+    dvec_t  m_valJ;
+
+    // lower part of A and A + mu D on the same pattern
+    spmat_t m_A, m_M;
+    ivec_t  m_diag;  // position of the diagonal entries in the values
+    ivec_t  m_posT;  // position of the tensor entries in the values
+    dvec_t  m_valT;
+    LDLT_t  m_LDLT;
+
+    real_type m_mu;
+    real_type m_norm_F_inf;
+    integer   m_num_reject;
+
+    void setup( nonlinearLeastSquares const & LS );
+    //! `false` if some value of the jacobian (or of the tensor) is inf or NaN
+    bool evalJacobian( nonlinearLeastSquares const & LS, dvec_t const & x, dvec_t const & F );
+    bool factorizeShifted( dvec_t const & D );
+
+    static
+    bool
+    isAdmissible( nonlinearLeastSquares const & LS, dvec_t const & x ) {
+      integer which;
+      return LS.isAdmissible( x, which ) == POINT_ADMISSIBLE;
+    }
+
+  public:
+
+    explicit
+    LevenbergMarquardtSolver( bool geodesic = false, bool second_order = false );
+
+    virtual ~LevenbergMarquardtSolver() {}
+
+    void setGeodesic( bool yes )               { m_geodesic = yes; }
+    void setSecondOrder( bool yes )            { m_second_order = yes; }
+    void setGradientTolerance( real_type tol ) { m_grad_tol = tol; }
+    void setStepTolerance( real_type tol )     { m_step_tol = tol; }
+    void setGeodesicRatio( real_type r )       { m_geo_ratio = r; }
+
+    integer   numReject() const { return m_num_reject; }
+    real_type mu()        const { return m_mu; }
+
+    //!
+    //! Minimize \f$ \|F(x)\| \f$ starting from `x`. Return `true` if
+    //! \f$ \|F\|_\infty \f$ is below `tolerance` or \f$ \|J^T F\|_\infty \f$
+    //! is below the gradient tolerance.
+    //!
+    bool solve( nonlinearLeastSquares const & LS, dvec_t & x );
+
+    //!
+    //! Solve the square system \f$ F(x) = 0 \f$ as a least squares
+    //! problem. Return `true` only if \f$ \|F\|_\infty \f$ is below
+    //! `tolerance`: a stationary point of \f$ \|F\| \f$ is not a root.
+    //!
+    bool solve( nonlinearSystem const & P, dvec_t & x ) override;
+
+  };
+
+}
+
+#endif
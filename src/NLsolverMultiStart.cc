@@ -0,0 +1,337 @@
+#include "NLsolverMultiStart.hh"
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace NLproblem {
+
+  MultiStartSolver::MultiStartSolver( unsigned nthreads )
+  : NLsolver("MultiStart")
+  , m_pool( max( unsigned(1), nthreads ) )
+  , m_num_samples(200)
+  , m_num_batches(5)
+  , m_reduce(0.1)
+  , m_sigma(4)
+  , m_radius(10)
+  , m_same_tol(1e-6)
+  , m_seed(1)
+  , m_parallel(true)
+  , m_num_sample_F(0)
+  , m_local_F(0)
+  , m_local_J(0)
+  , m_local_LU(0)
+  , m_run_F(0)
+  {
+    setLocalSolver( []() -> NLsolver * { return new NewtonSolver(); } );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  MultiStartSolver::setLocalSolver( factory_t const & f ) {
+    m_factory = f;
+    m_local.clear();
+    for ( unsigned iw = 0; iw < m_pool.size(); ++iw )
+      m_local.push_back( std::unique_ptr<NLsolver>( m_factory() ) );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  unsigned
+  MultiStartSolver::numWorkers( nonlinearSystem const & P ) const {
+    return m_parallel && P.isThreadSafe() ? m_pool.size() : 1;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  MultiStartSolver::setupBox( nonlinearSystem const & P, dvec_t const & c ) {
+    integer const n = P.numEqns();
+    m_L.resize( n );
+    m_U.resize( n );
+    P.boundingBox( m_L, m_U );
+    for ( integer j = 0; j < n; ++j ) {
+      real_type r = m_radius * ( 1 + std::abs(c(j)) );
+      if ( !(m_L(j) > -real_max) ) m_L(j) = min( c(j), m_U(j) ) - r;
+      if ( !(m_U(j) <  real_max) ) m_U(j) = max( c(j), m_L(j) ) + r;
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  MultiStartSolver::sampleBatch( nonlinearSystem const & P, integer batch ) {
+    integer const n  = P.numEqns();
+    integer const N  = m_num_samples;
+    size_t  const i0 = m_u.size();
+
+    // Latin hypercube: one sample for each of the N strata of each side
+    std::mt19937 gen( static_cast<unsigned>( m_seed + batch ) );
+    std::uniform_real_distribution<real_type> U01( 0, 1 );
+    vector<integer> perm( static_cast<size_t>(N) );
+    m_u.resize( i0 + size_t(N), dvec_t(n) );
+    m_f.resize( i0 + size_t(N) );
+    m_used.resize( i0 + size_t(N), 0 );
+    for ( integer j = 0; j < n; ++j ) {
+      std::iota( perm.begin(), perm.end(), 0 );
+      std::shuffle( perm.begin(), perm.end(), gen );
+      for ( integer i = 0; i < N; ++i )
+        m_u[i0+size_t(i)](j) = ( perm[size_t(i)] + U01(gen) ) / N;
+    }
+
+    // screening
+    std::atomic<integer> next(0);
+    auto worker = [&]( unsigned ) -> void {
+      dvec_t x(n), F(n);
+      integer i;
+      while ( (i = next++) < N ) {
+        size_t k = i0 + size_t(i);
+        x = m_L + m_u[k].cwiseProduct( m_U - m_L );
+        real_type f = real_max;
+        if ( isAdmissible( P, x ) ) {
+          try {
+            P.evalF( x, F );
+            f = F.norm();
+            if ( !std::isfinite(f) ) f = real_max;
+          }
+          catch ( ... ) {
+            f = real_max;
+          }
+        }
+        m_f[k] = f;
+      }
+    };
+    unsigned nw = numWorkers( P );
+    if ( nw == 1 ) {
+      worker( 0 );
+    } else {
+      for ( unsigned iw = 0; iw < nw; ++iw ) m_pool.run( iw, worker, iw );
+      m_pool.wait_all();
+    }
+    m_num_sample_F += N;
+    m_run_F        += N;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  MultiStartSolver::selectStarts( vector<integer> & sel ) const {
+    sel.clear();
+    size_t const NT = m_u.size();
+    if ( NT == 0 ) return;
+    real_type const n = real_type( m_u.front().size() );
+
+    // reduced sample: the admissible points with smallest residual
+    vector<integer> idx;
+    for ( size_t i = 0; i < NT; ++i ) if ( m_f[i] < real_max ) idx.push_back( integer(i) );
+    std::sort(
+      idx.begin(), idx.end(),
+      [this]( integer a, integer b ) -> bool { return m_f[size_t(a)] < m_f[size_t(b)]; }
+    );
+    size_t nk = size_t( std::ceil( m_reduce * NT ) );
+    if ( idx.size() > nk ) idx.resize( nk );
+
+    real_type rk = std::pow(
+      std::tgamma( 1 + n/2 ) * m_sigma * std::log( real_type(NT) ) / NT, 1/n
+    ) / std::sqrt( m_pi );
+
+    // roots in the unit box
+    dvec_t W = m_U - m_L;
+    for ( integer j = 0; j < W.size(); ++j ) if ( W(j) <= 0 ) W(j) = 1;
+    vector<dvec_t> R;
+    for ( auto const & r : m_roots ) R.push_back( (r-m_L).cwiseQuotient(W) );
+
+    for ( size_t a = 0; a < idx.size(); ++a ) {
+      size_t i = size_t(idx[a]);
+      if ( m_used[i] != 0 ) continue;
+      bool ok = true;
+      for ( size_t b = 0; ok && b < a; ++b )
+        ok = (m_u[size_t(idx[b])]-m_u[i]).norm() > rk;
+      for ( size_t b = 0; ok && b < R.size(); ++b )
+        ok = (R[b]-m_u[i]).norm() > rk;
+      if ( ok ) sel.push_back( integer(i) );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  MultiStartSolver::solveStarts( nonlinearSystem const & P, size_t i0 ) {
+    integer const ns = integer( m_starts.size() - i0 );
+    if ( ns <= 0 ) return;
+    vector<dvec_t> xs( static_cast<size_t>(ns) );
+    for ( integer i = 0; i < ns; ++i ) {
+      m_starts[i0+size_t(i)].converged = false;
+      m_starts[i0+size_t(i)].num_iter  = 0;
+    }
+
+    std::atomic<integer> next(0), done(0);
+    auto worker = [&]( unsigned iw ) -> void {
+      NLsolver & S = *m_local[iw];
+      integer i;
+      while ( !mustStop( m_run_F ) && (i = next++) < ns ) {
+        startInfo & st = m_starts[i0+size_t(i)];
+        dvec_t    & x  = xs[size_t(i)];
+        x = st.x0;
+        delegateLimits( S, m_cancel, m_outer_cancel, &m_run_F );
+        try {
+          st.converged = S.solve( P, x );
+        }
+        catch ( ... ) {
+          st.converged = false;
+        }
+        S.flushEvaluations();
+        ++done;
+        st.num_iter = S.numIter();
+        m_local_F  += S.numF();
+        m_local_J  += S.numJ();
+        m_local_LU += S.numFactorize();
+      }
+    };
+    unsigned nw = numWorkers( P );
+    if ( unsigned(ns) < nw ) nw = unsigned(ns);
+    if ( nw == 1 ) {
+      worker( 0 );
+    } else {
+      for ( unsigned iw = 0; iw < nw; ++iw ) m_pool.run( iw, worker, iw );
+      m_pool.wait_all();
+    }
+    if ( done < ns ) m_stopped = true;
+
+    // merge in the order of the starts
+    for ( integer i = 0; i < ns; ++i ) {
+      startInfo    & st = m_starts[i0+size_t(i)];
+      dvec_t const & x  = xs[size_t(i)];
+      st.root = -1;
+      if ( !st.converged ) continue;
+      real_type nx = x.norm();
+      size_t k = 0;
+      while ( k < m_roots.size() && (m_roots[k]-x).norm() > m_same_tol*(1+nx) ) ++k;
+      if ( k == m_roots.size() ) {
+        m_roots.push_back( x );
+        m_root_count.push_back( 0 );
+      }
+      ++m_root_count[k];
+      st.root = integer(k);
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  MultiStartSolver::run( nonlinearSystem const & P, vector<dvec_t> const & x0 ) {
+    Utils::TicToc tictoc;
+    tictoc.tic();
+    resetStatistics();
+    m_u.clear();
+    m_f.clear();
+    m_used.clear();
+    m_starts.clear();
+    m_roots.clear();
+    m_root_count.clear();
+    m_num_sample_F = 0;
+    m_local_F      = 0;
+    m_local_J      = 0;
+    m_local_LU     = 0;
+    m_run_F        = 0;
+
+    integer const n = P.numEqns();
+    setupBox( P, x0.front() );
+
+    // the given points first
+    dvec_t F(n);
+    for ( auto const & x : x0 ) {
+      startInfo st;
+      st.x0 = x;
+      st.f0 = real_max;
+      try {
+        P.evalF( x, F );
+        ++m_num_sample_F;
+        ++m_run_F;
+        st.f0 = F.norm();
+      }
+      catch ( ... ) {
+      }
+      m_starts.push_back( st );
+    }
+    solveStarts( P, 0 );
+
+    vector<integer> sel;
+    for ( integer b = 0; b < m_num_batches && !m_stopped; ++b ) {
+      if ( mustStop( m_run_F ) ) { m_stopped = true; break; }
+      sampleBatch( P, b );
+      selectStarts( sel );
+      size_t i0 = m_starts.size();
+      for ( integer i : sel ) {
+        m_used[size_t(i)] = 1;
+        startInfo st;
+        st.x0 = m_L + m_u[size_t(i)].cwiseProduct( m_U - m_L );
+        st.f0 = m_f[size_t(i)];
+        m_starts.push_back( st );
+      }
+      solveStarts( P, i0 );
+    }
+
+    for ( auto const & st : m_starts ) m_num_iter += st.num_iter;
+    m_num_F         = m_num_sample_F + m_local_F;
+    m_num_J         = m_local_J;
+    m_num_factorize = m_local_LU;
+    m_converged     = !m_roots.empty();
+
+    tictoc.toc();
+    m_elapsed_ms = tictoc.elapsed_ms();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  MultiStartSolver::solveAll( nonlinearSystem const & P ) {
+    integer const n = P.numEqns();
+    vector<dvec_t> x0( size_t(max( P.numInitialPoint(), integer(1) )), dvec_t(n) );
+    for ( integer i = 0; i < P.numInitialPoint(); ++i ) P.getInitialPoint( x0[size_t(i)], i );
+    if ( P.numInitialPoint() == 0 ) x0.front().setZero();
+    run( P, x0 );
+    if ( m_converged ) {
+      dvec_t f( n );
+      P.evalF( m_roots.front(), f );
+      m_norm_F = f.norm();
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  MultiStartSolver::solve( nonlinearSystem const & P, dvec_t & x ) {
+    run( P, vector<dvec_t>( 1, x ) );
+    real_type best  = real_max;
+    integer   ibest = -1;
+    for ( integer i = 0; i < numRoots(); ++i ) {
+      real_type d = (m_roots[size_t(i)]-x).norm();
+      if ( d < best ) { best = d; ibest = i; }
+    }
+    if ( ibest >= 0 ) {
+      x = m_roots[size_t(ibest)];
+      dvec_t f( x.size() );
+      P.evalF( x, f );
+      m_norm_F = f.norm();
+    }
+    return m_converged;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  integer
+  MultiStartSolver::numSuccess() const {
+    integer count = 0;
+    for ( auto const & st : m_starts ) if ( st.converged ) ++count;
+    return count;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  MultiStartSolver::successRate() const {
+    return m_starts.empty() ? 0 : real_type( numSuccess() ) / m_starts.size();
+  }
+
+}
@@ -0,0 +1,161 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+#ifndef NL_SOLVER_MULTI_START_HH
+#define NL_SOLVER_MULTI_START_HH
+
+#include "NLsolver.hh"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace NLproblem {
+
+  /*\
+   |   __  __       _ _   _     _             _
+   |  |  \/  |_   _| | |_(_)___| |_ __ _ _ __| |_
+   |  | |\/| | | | | | __| / __| __/ _` | '__| __|
+   |  | |  | | |_| | | |_| \__ \ || (_| | |  | |_
+   |  |_|  |_|\__,_|_|\__|_|___/\__\__,_|_|   \__|
+  \*/
+
+  //!
+  //! Multi-level single linkage (Rinnooy Kan and Timmer) on top of a
+  //! local solver.
+  //!
+  //! The samples are Latin hypercube points of `boundingBox`, the
+  //! unbounded sides are clipped to `radius*(1+|c_j|)` around the
+  //! first initial point \f$ c \f$. Each batch of samples is screened
+  //! by \f$ \|F\| \f$ (evaluated by the thread pool), the fraction
+  //! `reduce` with the smallest residual is kept and a local solve is
+  //! started from a kept sample only if no kept sample with smaller
+  //! residual and no root already found is within the critical distance
+  //! \f[
+  //!   r_k = \frac{1}{\sqrt{\pi}} \left( \Gamma\left(1+\frac{n}{2}\right)
+  //!         \frac{\sigma \log (kN)}{kN} \right)^{1/n}
+  //! \f]
+  //! (in coordinates scaled to the unit box, \f$ kN \f$ samples so far):
+  //! ideally one local solve per basin of attraction.
+  //! The initial points of the problem are always used as starts.
+  //! The local solves of a batch run on the thread pool, each worker
+  //! with its own local solver (serially if the problem is not
+  //! `isThreadSafe`); the roots are merged in the order of the starts,
+  //! so the result does not depend on the number of threads.
+  //! The cancel flags and the budgets are checked before each batch
+  //! and each local solve, and passed to the local solvers: the
+  //! evaluations of the samples and of the local solves count on the
+  //! same budget.
+  //!
+  class MultiStartSolver : public NLsolver {
+  public:
+
+    typedef std::function<NLsolver*()> factory_t;
+
+    //! a local solve
+    struct startInfo {
+      dvec_t    x0;
+      real_type f0;         // ||F(x0)||
+      integer   root;       // index of the root, -1 if not converged
+      integer   num_iter;
+      bool      converged;
+    };
+
+  private:
+
+    Utils::ThreadPool m_pool;
+
+    factory_t                         m_factory;
+    vector<std::unique_ptr<NLsolver> > m_local;
+
+    // parameters
+    integer   m_num_samples;  // samples per batch
+    integer   m_num_batches;
+    real_type m_reduce;       // fraction of the samples kept
+    real_type m_sigma;
+    real_type m_radius;       // clip of the unbounded sides
+    real_type m_same_tol;
+    integer   m_seed;
+    bool      m_parallel;
+
+    // box
+    dvec_t m_L, m_U;
+
+    // samples in the unit box and their residual
+    vector<dvec_t>    m_u;
+    vector<real_type> m_f;
+    vector<char>      m_used;
+
+    vector<startInfo> m_starts;
+    vector<dvec_t>    m_roots;
+    vector<integer>   m_root_count;
+
+    integer              m_num_sample_F;
+    std::atomic<integer> m_local_F;
+    std::atomic<integer> m_local_J;
+    std::atomic<integer> m_local_LU;
+    std::atomic<integer> m_run_F; // samples and local solves, shared with the local solvers
+
+    unsigned numWorkers( nonlinearSystem const & P ) const;
+
+    void setupBox( nonlinearSystem const & P, dvec_t const & c );
+    void sampleBatch( nonlinearSystem const & P, integer batch );
+    void selectStarts( vector<integer> & sel ) const;
+
+    //! local solves from `m_starts[i0:]`, then merge the roots
+    void solveStarts( nonlinearSystem const & P, size_t i0 );
+
+    void run( nonlinearSystem const & P, vector<dvec_t> const & x0 );
+
+  public:
+
+    explicit
+    MultiStartSolver( unsigned nthreads = max( unsigned(1), unsigned(std::thread::hardware_concurrency()) ) );
+
+    virtual ~MultiStartSolver() {}
+
+    //! factory of the local solver, the default is `NewtonSolver`
+    void setLocalSolver( factory_t const & f );
+
+    void setNumSamples( integer ns )     { m_num_samples = ns; }
+    void setNumBatches( integer nb )     { m_num_batches = nb; }
+    void setReduction( real_type r )     { m_reduce = r; }
+    void setSigma( real_type s )         { m_sigma = s; }
+    void setRadius( real_type r )        { m_radius = r; }
+    void setSameTolerance( real_type t ) { m_same_tol = t; }
+    void setSeed( integer seed )         { m_seed = seed; }
+    void setParallel( bool yes )         { m_parallel = yes; }
+
+    //! all the batches starting with the initial points of `P`
+    void solveAll( nonlinearSystem const & P );
+
+    //!
+    //! As `solveAll` with `x` as the only initial point, then `x` is set
+    //! to the root closest to it. Return `true` if there is one.
+    //!
+    bool solve( nonlinearSystem const & P, dvec_t & x ) override;
+
+    integer   numSamples()  const { return integer(m_u.size()); }
+    integer   numStarts()   const { return integer(m_starts.size()); }
+    integer   numSuccess()  const;
+    real_type successRate() const;
+    unsigned  numThreads()  const { return m_pool.size(); }
+
+    startInfo const & start( integer i ) const { return m_starts[size_t(i)]; }
+
+    integer        numRoots()             const { return integer(m_roots.size()); }
+    dvec_t const & root( integer i )      const { return m_roots[size_t(i)]; }
+    integer        rootCount( integer i ) const { return m_root_count[size_t(i)]; }
+
+  };
+
+}
+
+#endif
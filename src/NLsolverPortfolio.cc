@@ -0,0 +1,207 @@
+#include "NLsolverPortfolio.hh"
+#include <algorithm>
+
+namespace NLproblem {
+
+  PortfolioSolver::PortfolioSolver( unsigned nthreads )
+  : NLsolver("Portfolio")
+  , m_pool( max( unsigned(1), nthreads ) )
+  , m_parallel(true)
+  , m_stop(false)
+  , m_winner(-1)
+  , m_next(0)
+  , m_used_F(0)
+  {}
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  PortfolioSolver::outerStop() const {
+    return ( m_cancel != nullptr && m_cancel->load( std::memory_order_relaxed ) ) ||
+           m_used_F >= m_max_num_F ||
+           ( m_time_budget_ms > 0 && std::chrono::steady_clock::now() >= m_deadline );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  PortfolioSolver::addSolver( NLsolver * S, string const & label ) {
+    UTILS_ASSERT0( S != nullptr, "PortfolioSolver::addSolver, null solver" );
+    entry e;
+    e.solver.reset( S );
+    e.label     = label.empty() ? S->name() : label;
+    e.started   = false;
+    e.converged = false;
+    for ( auto const & E : m_entries )
+      UTILS_ASSERT(
+        E.label != e.label,
+        "PortfolioSolver::addSolver, label `{}` already used", e.label
+      );
+    S->setCancelFlag( &m_stop );
+    m_entries.push_back( std::move(e) );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  PortfolioSolver::setupOrder( nonlinearSystem const & P ) {
+    integer const ns = numSolvers();
+    m_order.resize( size_t(ns) );
+    for ( integer k = 0; k < ns; ++k ) m_order[size_t(k)] = k;
+    auto it = m_history.find( P.title() );
+    if ( it == m_history.end() ) return;
+    std::map<string,integer> const & wins = it->second;
+    vector<integer> w( size_t(ns), 0 );
+    for ( integer k = 0; k < ns; ++k ) {
+      auto iw = wins.find( m_entries[size_t(k)].label );
+      if ( iw != wins.end() ) w[size_t(k)] = iw->second;
+    }
+    std::stable_sort(
+      m_order.begin(), m_order.end(),
+      [&w]( integer a, integer b ) -> bool { return w[size_t(a)] > w[size_t(b)]; }
+    );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  PortfolioSolver::runEntry(
+    nonlinearSystem const & P,
+    integer                 k,
+    dvec_t          const & x0
+  ) {
+    entry & e = m_entries[size_t(k)];
+
+    // the wall time left and the evaluations shared by all the solvers
+    delegateLimits( *e.solver, &m_stop, m_cancel, &m_used_F );
+
+    e.started = true;
+    e.x       = x0;
+    try {
+      e.converged = e.solver->solve( P, e.x );
+    }
+    catch ( ... ) {
+      e.converged = false;
+    }
+    e.solver->flushEvaluations();
+    if ( e.converged ) {
+      integer none = -1;
+      if ( m_winner.compare_exchange_strong( none, k ) ) m_stop = true;
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  PortfolioSolver::solve( nonlinearSystem const & P, dvec_t & x ) {
+    UTILS_ASSERT0( !m_entries.empty(), "PortfolioSolver::solve, no solvers" );
+    Utils::TicToc tictoc;
+    tictoc.tic();
+    resetStatistics();
+
+    integer const ns = numSolvers();
+    for ( auto & e : m_entries ) {
+      e.started   = false;
+      e.converged = false;
+    }
+    m_stop   = false;
+    m_winner = -1;
+    m_next   = 0;
+    m_used_F = 0;
+    setupOrder( P );
+
+    auto worker = [this,&P,&x,ns]( unsigned ) -> void {
+      integer i;
+      while ( !m_stop && !outerStop() && (i = m_next++) < ns )
+        runEntry( P, m_order[size_t(i)], x );
+    };
+
+    unsigned nw = m_parallel && P.isThreadSafe() ? m_pool.size() : 1;
+    if ( unsigned(ns) < nw ) nw = unsigned(ns);
+    if ( nw == 1 ) {
+      worker( 0 );
+    } else {
+      for ( unsigned iw = 0; iw < nw; ++iw ) m_pool.run( iw, worker, iw );
+      m_pool.wait_all();
+    }
+
+    for ( auto const & e : m_entries ) {
+      if ( !e.started ) continue;
+      m_num_iter      += e.solver->numIter();
+      m_num_F         += e.solver->numF();
+      m_num_J         += e.solver->numJ();
+      m_num_factorize += e.solver->numFactorize();
+    }
+
+    integer const w = m_winner;
+    m_converged = w >= 0;
+    m_stopped   = !m_converged && outerStop();
+    for ( auto const & e : m_entries )
+      if ( !m_converged && e.started && e.solver->stopped() ) m_stopped = true;
+    if ( m_converged ) {
+      entry const & e = m_entries[size_t(w)];
+      x        = e.x;
+      m_norm_F = e.solver->normF();
+      ++m_history[P.title()][e.label];
+    }
+
+    tictoc.toc();
+    m_elapsed_ms = tictoc.elapsed_ms();
+    return m_converged;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  string
+  PortfolioSolver::winnerLabel() const {
+    integer const w = m_winner;
+    return w >= 0 ? m_entries[size_t(w)].label : string("");
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  integer
+  PortfolioSolver::numStarted() const {
+    integer count = 0;
+    for ( auto const & e : m_entries ) if ( e.started ) ++count;
+    return count;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  integer
+  PortfolioSolver::numWins( string const & title, string const & label ) const {
+    auto it = m_history.find( title );
+    if ( it == m_history.end() ) return 0;
+    auto iw = it->second.find( label );
+    return iw == it->second.end() ? 0 : iw->second;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  PortfolioSolver::saveHistory( ostream_type & stream ) const {
+    for ( auto const & p : m_history )
+      for ( auto const & w : p.second )
+        fmt::print( stream, "{}\t{}\t{}\n", w.second, w.first, p.first );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  PortfolioSolver::loadHistory( std::istream & stream ) {
+    string line;
+    while ( std::getline( stream, line ) ) {
+      if ( line.empty() ) continue;
+      size_t t1 = line.find('\t');
+      size_t t2 = t1 == string::npos ? t1 : line.find( '\t', t1+1 );
+      UTILS_ASSERT(
+        t2 != string::npos,
+        "PortfolioSolver::loadHistory, bad line `{}`", line
+      );
+      integer wins = integer( std::stol( line.substr( 0, t1 ) ) );
+      m_history[line.substr(t2+1)][line.substr(t1+1,t2-t1-1)] += wins;
+    }
+  }
+
+}
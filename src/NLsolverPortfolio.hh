@@ -0,0 +1,138 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+#ifndef NL_SOLVER_PORTFOLIO_HH
+#define NL_SOLVER_PORTFOLIO_HH
+
+#include "NLsolver.hh"
+
+#include <atomic>
+#include <memory>
+
+namespace NLproblem {
+
+  /*\
+   |   ____            _    __       _ _
+   |  |  _ \ ___  _ __| |_ / _| ___ | (_) ___
+   |  | |_) / _ \| '__| __| |_ / _ \| | |/ _ \
+   |  |  __/ (_) | |  | |_|  _| (_) | | | (_) |
+   |  |_|   \___/|_|   \__|_|  \___/|_|_|\___/
+  \*/
+
+  //!
+  //! Race of several solvers on the same problem and initial point.
+  //!
+  //! The solvers of the portfolio run concurrently on the threads of a
+  //! pool, each on its own copy of the initial point, the problem is
+  //! shared read only. The first one that converges is the winner and
+  //! raises the cancel flag (see `NLsolver::setCancelFlag`): the others
+  //! stop at their next iteration and the solvers not yet started are
+  //! skipped. With fewer threads than solvers, or serially when the
+  //! problem is not `isThreadSafe`, the solvers start in order of their
+  //! wins on the same problem (by title) in the previous runs, so the
+  //! historically best solver is tried first. The history can be saved
+  //! and loaded to carry it to later runs.
+  //!
+  //! The cancel flag and the budgets given to the portfolio apply to
+  //! the race: the flag is polled also by the racing solvers and, when
+  //! the portfolio has budgets, each solver starts with the wall time
+  //! left and all the solvers count their residual evaluations on the
+  //! same counter (see `NLsolver::shareEvaluations`), so the race stops
+  //! at the budget of the portfolio (plus the last iteration of each
+  //! running solver).
+  //!
+  class PortfolioSolver : public NLsolver {
+  public:
+
+    //! a solver of the portfolio and the outcome of its last run
+    struct entry {
+      std::unique_ptr<NLsolver> solver;
+      string                    label;
+      dvec_t                    x;
+      bool                      started;
+      bool                      converged;
+    };
+
+    //! wins of each label for each problem title
+    typedef std::map<string,std::map<string,integer> > history_t;
+
+  private:
+
+    Utils::ThreadPool m_pool;
+    vector<entry>     m_entries;
+    vector<integer>   m_order;
+    history_t         m_history;
+    bool              m_parallel;
+
+    std::atomic<bool>    m_stop;
+    std::atomic<integer> m_winner;
+    std::atomic<integer> m_next;
+    std::atomic<integer> m_used_F; // residual evaluations of all the solvers
+
+    //! `true` if the caller cancelled the race or its budgets are over
+    bool outerStop() const;
+
+    void setupOrder( nonlinearSystem const & P );
+    void runEntry( nonlinearSystem const & P, integer k, dvec_t const & x0 );
+
+  public:
+
+    explicit
+    PortfolioSolver( unsigned nthreads = max( unsigned(1), unsigned(std::thread::hardware_concurrency()) ) );
+
+    virtual ~PortfolioSolver() {}
+
+    //!
+    //! Add a solver to the portfolio, the portfolio takes the ownership.
+    //! `label` (the name of the solver if empty) identifies the solver
+    //! in the history, it must be unique.
+    //!
+    void addSolver( NLsolver * S, string const & label = "" );
+
+    void setParallel( bool yes ) { m_parallel = yes; }
+
+    //!
+    //! Race the solvers from `x`, on exit `x` is the point found by the
+    //! winner (unchanged if none converges). Return `true` if there is
+    //! a winner.
+    //!
+    bool solve( nonlinearSystem const & P, dvec_t & x ) override;
+
+    integer numSolvers() const { return integer(m_entries.size()); }
+    unsigned numThreads() const { return m_pool.size(); }
+
+    entry const & solver( integer k ) const { return m_entries[size_t(k)]; }
+
+    //! index of the winner of the last run, -1 if none
+    integer winner() const { return m_winner; }
+
+    //! label of the winner of the last run, empty if none
+    string winnerLabel() const;
+
+    //! number of solvers started in the last run
+    integer numStarted() const;
+
+    //! wins of `label` on the problem `title`
+    integer numWins( string const & title, string const & label ) const;
+
+    history_t const & history() const { return m_history; }
+    void clearHistory() { m_history.clear(); }
+
+    //! one line `wins<TAB>label<TAB>title` for each record
+    void saveHistory( ostream_type & stream ) const;
+
+    //! add the records written by `saveHistory` to the history
+    void loadHistory( std::istream & stream );
+
+  };
+
+}
+
+#endif
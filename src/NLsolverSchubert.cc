@@ -0,0 +1,146 @@
+#include "NLsolverSchubert.hh"
+#include <algorithm>
+
+namespace NLproblem {
+
+  void
+  SchubertSolver::buildCSR() {
+    spmat_t const & J   = m_jac.matrix();
+    integer const   n   = integer(J.rows());
+    integer const * outer = J.outerIndexPtr();
+    integer const * inner = J.innerIndexPtr();
+
+    // only the entries of jacobianPattern, not the zero diagonal added
+    // by sparseJacobian, or the update would fill outside the pattern
+    // (repeated entries of the pattern share a position)
+    vector<bool> in_pattern( size_t(J.nonZeros()), false );
+    ivec_t const & P = m_jac.positions();
+    for ( integer k = 0; k < P.size(); ++k ) in_pattern[size_t(P(k))] = true;
+    integer const nnz = integer( std::count( in_pattern.begin(), in_pattern.end(), true ) );
+
+    m_R.resize( n+1 );
+    m_C.resize( nnz );
+    m_pos.resize( nnz );
+
+    // count entries per row, then scatter column by column so that
+    // the column indices of each row come out sorted
+    m_R.setZero();
+    for ( integer k = 0; k < J.nonZeros(); ++k )
+      if ( in_pattern[size_t(k)] ) ++m_R(inner[k]+1);
+    for ( integer i = 0; i < n; ++i ) m_R(i+1) += m_R(i);
+
+    ivec_t next( m_R.head(n) );
+    for ( integer j = 0; j < n; ++j ) {
+      for ( integer k = outer[j]; k < outer[j+1]; ++k ) {
+        if ( !in_pattern[size_t(k)] ) continue;
+        integer & kk = next(inner[k]);
+        m_C(kk)   = j;
+        m_pos(kk) = k;
+        ++kk;
+      }
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SchubertSolver::update( dvec_t const & s, dvec_t const & y ) {
+    real_type * V = m_jac.matrix().valuePtr();
+    integer const n = integer(s.size());
+    for ( integer i = 0; i < n; ++i ) {
+      real_type Bs = 0, ss = 0;
+      for ( integer kk = m_R(i); kk < m_R(i+1); ++kk ) {
+        real_type sj = s(m_C(kk));
+        Bs += V[m_pos(kk)] * sj;
+        ss += sj * sj;
+      }
+      if ( ss <= 0 ) continue;
+      real_type c = ( y(i) - Bs ) / ss;
+      for ( integer kk = m_R(i); kk < m_R(i+1); ++kk )
+        V[m_pos(kk)] += c * s(m_C(kk));
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  SchubertSolver::restart( nonlinearSystem const & P, dvec_t const & x ) {
+    return evalJ( P, x, m_jac ) && factorize( m_jac );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  SchubertSolver::solve( nonlinearSystem const & P, dvec_t & x ) {
+    Utils::TicToc tictoc;
+    tictoc.tic();
+    resetStatistics();
+    m_num_restart = 0;
+
+    integer const n = P.numEqns();
+    dvec_t F(n), F1(n), x1(n), d(n), s(n), y(n);
+
+    m_jac.setup( P );
+    buildCSR();
+
+    evalF( P, x, F );
+    m_norm_F = F.norm();
+
+    bool    fresh = restart( P, x ); // true if B is the true jacobian
+    integer age   = 0;               // iterations since last restart
+    if ( fresh ) {
+      for ( m_num_iter = 0; m_num_iter < m_max_iter; ++m_num_iter ) {
+        if ( F.lpNorm<Eigen::Infinity>() <= m_tolerance ) {
+          m_converged = true;
+          break;
+        }
+        if ( stopRequested() ) break;
+
+        m_jac.solve( F, d );
+        d = -d;
+
+        real_type lambda, normF1;
+        if ( !lineSearch( P, x, m_norm_F, d, x1, F1, normF1, lambda ) ) {
+          if ( fresh || m_num_restart >= m_max_restart ) break;
+          ++m_num_restart;
+          fresh = restart( P, x );
+          age   = 0;
+          if ( !fresh ) break;
+          continue;
+        }
+
+        s = x1 - x;
+        y = F1 - F;
+        x.swap(x1);
+        F.swap(F1);
+        m_norm_F = normF1;
+
+        ++age;
+        if ( m_restart_every > 0 && age >= m_restart_every ) {
+          if ( m_num_restart >= m_max_restart ) break;
+          ++m_num_restart;
+          fresh = restart( P, x );
+          age   = 0;
+          if ( !fresh ) break;
+          continue;
+        }
+
+        update( s, y );
+        fresh = false;
+        if ( !factorize( m_jac ) ) {
+          if ( m_num_restart >= m_max_restart ) break;
+          ++m_num_restart;
+          fresh = restart( P, x );
+          age   = 0;
+          if ( !fresh ) break;
+        }
+      }
+    }
+    if ( !m_converged ) m_converged = F.lpNorm<Eigen::Infinity>() <= m_tolerance;
+
+    tictoc.toc();
+    m_elapsed_ms = tictoc.elapsed_ms();
+    return m_converged;
+  }
+
+}
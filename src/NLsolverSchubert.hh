@@ -0,0 +1,83 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+#ifndef NL_SOLVER_SCHUBERT_HH
+#define NL_SOLVER_SCHUBERT_HH
+
+#include "NLsolver.hh"
+
+namespace NLproblem {
+
+  /*\
+   |   ____       _           _               _
+   |  / ___|  ___| |__  _   _| |__   ___ _ __| |_
+   |  \___ \ / __| '_ \| | | | '_ \ / _ \ '__| __|
+   |   ___) | (__| | | | |_| | |_) |  __/ |  | |_
+   |  |____/ \___|_| |_|\__,_|_.__/ \___|_|   \__|
+  \*/
+
+  //!
+  //! Sparse Broyden method (Schubert, Bogle-Toint update).
+  //!
+  //! The approximate jacobian \f$ B \f$ keeps the pattern of `jacobianPattern`.
+  //! Each row is updated only on its nonzeros:
+  //!
+  //! \f[
+  //!   B_i \leftarrow B_i + \frac{y_i - B_i s}{\|P_i s\|^2} (P_i s)^T
+  //! \f]
+  //!
+  //! where \f$ P_i \f$ projects on the nonzeros of row \f$ i \f$.
+  //! The rows are walked in CSR order, the values live in the compressed
+  //! column storage of `sparseJacobian` so that the symbolic analysis of
+  //! the LU factorization is done once: each iteration costs one numerical
+  //! factorization and no jacobian evaluation.
+  //! The true jacobian is evaluated only at restart (line search failure,
+  //! singular update or every `restart_every` iterations if positive).
+  //!
+  class SchubertSolver : public NLsolver {
+
+    sparseJacobian m_jac;
+
+    // CSR view of jacobianPattern inside m_jac
+    ivec_t m_R;   // row pointers
+    ivec_t m_C;   // column indices
+    ivec_t m_pos; // position of the CSR entry in m_jac.matrix().valuePtr()
+
+    integer m_restart_every;
+    integer m_max_restart;
+    integer m_num_restart;
+
+    void buildCSR();
+    void update( dvec_t const & s, dvec_t const & y );
+    bool restart( nonlinearSystem const & P, dvec_t const & x );
+
+  public:
+
+    SchubertSolver()
+    : NLsolver("Schubert")
+    , m_restart_every(0)
+    , m_max_restart(50)
+    , m_num_restart(0)
+    {}
+
+    virtual ~SchubertSolver() {}
+
+    void setRestartEvery( integer re ) { m_restart_every = re; }
+    void setMaxRestart( integer mr )   { m_max_restart = mr; }
+
+    integer numRestart() const { return m_num_restart; }
+
+    bool solve( nonlinearSystem const & P, dvec_t & x ) override;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,86 @@
+#include "NLsolverTensor.hh"
+
+namespace NLproblem {
+
+  bool
+  TensorNewtonSolver::solve( nonlinearSystem const & P, dvec_t & x ) {
+    Utils::TicToc tictoc;
+    tictoc.tic();
+    resetStatistics();
+    m_rank               = 0;
+    m_num_tensor         = 0;
+    m_num_rank_deficient = 0;
+
+    integer const n = P.numEqns();
+    dvec_t F(n), F1(n), x1(n), d(n), u(n), v(n), a(n), s(n), Js(n);
+    dvec_t x_old(n), F_old(n);
+    bool   has_old = false;
+
+    m_jac.setup( P );
+    m_QR.analyzePattern( m_jac.matrix() );
+    if ( m_rank_tol >= 0 ) m_QR.setPivotThreshold( m_rank_tol );
+
+    evalF( P, x, F );
+    m_norm_F = F.norm();
+
+    for ( m_num_iter = 0; m_num_iter < m_max_iter; ++m_num_iter ) {
+      if ( F.lpNorm<Eigen::Infinity>() <= m_tolerance ) {
+        m_converged = true;
+        break;
+      }
+      if ( stopRequested() ) break;
+      if ( !evalJ( P, x, m_jac ) ) break;
+      ++m_num_factorize;
+      m_QR.factorize( m_jac.matrix() );
+      if ( m_QR.info() != Eigen::Success ) break;
+      m_rank = integer( m_QR.rank() );
+      if ( m_rank < n ) ++m_num_rank_deficient;
+      u = m_QR.solve( F );
+
+      real_type lambda, normF1;
+      bool      ok = false;
+      if ( has_old ) {
+        // second order term interpolating the previous iterate
+        s = x_old - x;
+        real_type ss = s.squaredNorm();
+        m_jac.mult( s, Js );
+        a = ( 2/(ss*ss) ) * ( F_old - F - Js );
+        v = m_QR.solve( a );
+
+        // (tau/2) beta^2 + beta + sigma = 0
+        real_type sigma = s.dot(u);
+        real_type tau   = s.dot(v);
+        real_type disc  = 1 - 2*tau*sigma;
+        real_type beta;
+        if      ( disc >= 0 ) beta = -2*sigma/( 1 + std::sqrt(disc) );
+        else                  beta = -1/tau;
+        d = -u - (beta*beta/2) * v;
+
+        // the full tensor step if it gives sufficient decrease
+        x1 = x + d;
+        if ( firstNonFinite( d ) < 0 && isAdmissible( P, x1 ) && safeEvalF( P, x1, F1 ) ) {
+          normF1 = F1.norm();
+          ok = normF1 <= (1-m_alpha) * m_norm_F;
+          if ( ok ) ++m_num_tensor;
+        }
+      }
+      if ( !ok ) {
+        d  = -u;
+        ok = lineSearch( P, x, m_norm_F, d, x1, F1, normF1, lambda );
+        if ( !ok ) break;
+      }
+      x_old   = x;
+      F_old   = F;
+      has_old = true;
+      x.swap(x1);
+      F.swap(F1);
+      m_norm_F = normF1;
+    }
+    if ( !m_converged ) m_converged = F.lpNorm<Eigen::Infinity>() <= m_tolerance;
+
+    tictoc.toc();
+    m_elapsed_ms = tictoc.elapsed_ms();
+    return m_converged;
+  }
+
+}
@@ -0,0 +1,87 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+#ifndef NL_SOLVER_TENSOR_HH
+#define NL_SOLVER_TENSOR_HH
+
+#include "NLsolver.hh"
+
+#include <Eigen/SparseQR>
+
+namespace NLproblem {
+
+  /*\
+   |   _____
+   |  |_   _|__ _ __  ___  ___  _ __
+   |    | |/ _ \ '_ \/ __|/ _ \| '__|
+   |    | |  __/ | | \__ \ (_) | |
+   |    |_|\___|_| |_|___/\___/|_|
+  \*/
+
+  //!
+  //! Tensor Newton method of Schnabel and Frank for problems with a
+  //! singular jacobian at the root.
+  //!
+  //! The linear model is completed by a rank one second order term
+  //! that interpolates \f$ F \f$ at the previous iterate
+  //! \f$ x_{-1} = x + s \f$:
+  //! \f[
+  //!   M(d) = F + J d + \frac{1}{2} a\, (s^T d)^2, \qquad
+  //!   a = 2\,\frac{F(x_{-1}) - F - J s}{(s^T s)^2}.
+  //! \f]
+  //! With \f$ J u = F \f$, \f$ J v = a \f$ and \f$ \beta = s^T d \f$ the
+  //! root of the model is \f$ d = -u - \frac{\beta^2}{2} v \f$ where
+  //! \f$ \frac{1}{2}(s^T v)\beta^2 + \beta + s^T u = 0 \f$ (the root of
+  //! smaller modulus, the minimizer of the quadratic if there are no
+  //! real roots): two solves with the same factorization, the sparse
+  //! structure of \f$ J \f$ is kept.
+  //! The factorization is a sparse QR with column pivoting that
+  //! reveals the numerical rank of \f$ J \f$, when it is deficient the
+  //! basic solutions are used. The full tensor step is taken when it
+  //! gives sufficient decrease of \f$ \|F\| \f$, otherwise the line
+  //! search is done along the Newton step.
+  //!
+  class TensorNewtonSolver : public NLsolver {
+
+    typedef Eigen::SparseQR<spmat_t,Eigen::COLAMDOrdering<integer> > QR_t;
+
+    sparseJacobian m_jac;
+    QR_t           m_QR;
+
+    real_type m_rank_tol;  // threshold of the QR, negative for the default
+    integer   m_rank;      // numerical rank at the last iteration
+    integer   m_num_tensor;
+    integer   m_num_rank_deficient;
+
+  public:
+
+    TensorNewtonSolver()
+    : NLsolver("TensorNewton")
+    , m_rank_tol(-1)
+    , m_rank(0)
+    , m_num_tensor(0)
+    , m_num_rank_deficient(0)
+    {}
+
+    virtual ~TensorNewtonSolver() {}
+
+    void setRankTolerance( real_type tol ) { m_rank_tol = tol; }
+
+    integer rank()             const { return m_rank; }
+    integer numTensorStep()    const { return m_num_tensor; }
+    integer numRankDeficient() const { return m_num_rank_deficient; }
+
+    bool solve( nonlinearSystem const & P, dvec_t & x ) override;
+
+  };
+
+}
+
+#endif
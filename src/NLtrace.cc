@@ -0,0 +1,298 @@
+#include "NLtrace.hh"
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+namespace NLproblem {
+
+  size_t
+  traceData::numEvents() const {
+    size_t ne = 0;
+    for ( auto const & t : threads ) ne += t.events.size();
+    return ne;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  static
+  string
+  jsonString( string const & s ) {
+    string res = "\"";
+    for ( char c : s ) {
+      switch ( c ) {
+      case '"':  res += "\\\""; break;
+      case '\\': res += "\\\\"; break;
+      case '\n': res += "\\n";  break;
+      case '\t': res += "\\t";  break;
+      default:   res += c;      break;
+      }
+    }
+    return res + "\"";
+  }
+
+  void
+  traceData::writeChromeJSON( ostream_type & stream ) const {
+    vector<string> quoted;
+    quoted.reserve( names.size() );
+    for ( auto const & s : names ) quoted.push_back( jsonString( s ) );
+    stream << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+    bool first = true;
+    for ( auto const & t : threads ) {
+      fmt::print(
+        stream,
+        "{}{{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": {}, "
+        "\"args\": {{\"name\": {}}}}}",
+        first ? "" : ",\n", t.tid, jsonString( t.name )
+      );
+      first = false;
+      for ( auto const & e : t.events ) {
+        fmt::print(
+          stream,
+          ",\n{{\"name\": {}, \"ph\": \"{}\", \"ts\": {:.3f}, \"pid\": 1, \"tid\": {}{}",
+          quoted[e.name], e.phase, e.ts_ns*1e-3, t.tid, e.phase == 'i' ? ", \"s\": \"t\"" : ""
+        );
+        if ( e.phase == 'E' ) stream << '}';
+        else                  fmt::print( stream, ", \"args\": {{\"arg\": {}}}}}", e.arg );
+      }
+    }
+    stream << "\n]}\n";
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  static char const trace_magic[8] = { 'N', 'L', 'T', 'R', 'A', 'C', 'E', 1 };
+
+  template <typename T>
+  static
+  void
+  putRaw( ostream_type & stream, T const & v ) {
+    stream.write( reinterpret_cast<char const *>(&v), sizeof(T) );
+  }
+
+  template <typename T>
+  static
+  void
+  getRaw( std::istream & stream, T & v ) {
+    stream.read( reinterpret_cast<char *>(&v), sizeof(T) );
+    UTILS_ASSERT0( stream.good(), "traceData::readBinary, truncated trace" );
+  }
+
+  static
+  void
+  putString( ostream_type & stream, string const & s ) {
+    putRaw( stream, uint32_t(s.size()) );
+    stream.write( s.data(), std::streamsize(s.size()) );
+  }
+
+  static
+  void
+  getString( std::istream & stream, string & s ) {
+    uint32_t len;
+    getRaw( stream, len );
+    s.resize( len );
+    if ( len > 0 ) stream.read( &s[0], std::streamsize(len) );
+    UTILS_ASSERT0( stream.good(), "traceData::readBinary, truncated trace" );
+  }
+
+  void
+  traceData::writeBinary( ostream_type & stream ) const {
+    stream.write( trace_magic, sizeof(trace_magic) );
+    putRaw( stream, uint32_t(names.size()) );
+    for ( auto const & s : names ) putString( stream, s );
+    putRaw( stream, uint32_t(threads.size()) );
+    for ( auto const & t : threads ) {
+      putRaw( stream, int32_t(t.tid) );
+      putString( stream, t.name );
+      putRaw( stream, uint64_t(t.events.size()) );
+      for ( auto const & e : t.events ) {
+        putRaw( stream, e.ts_ns );
+        putRaw( stream, e.name );
+        putRaw( stream, e.arg );
+        putRaw( stream, e.phase );
+      }
+    }
+  }
+
+  void
+  traceData::readBinary( std::istream & stream ) {
+    char magic[sizeof(trace_magic)];
+    stream.read( magic, sizeof(magic) );
+    UTILS_ASSERT0(
+      stream.good() && std::memcmp( magic, trace_magic, sizeof(magic) ) == 0,
+      "traceData::readBinary, not a trace"
+    );
+    uint32_t nn, nt;
+    getRaw( stream, nn );
+    names.resize( nn );
+    for ( auto & s : names ) getString( stream, s );
+    getRaw( stream, nt );
+    threads.resize( nt );
+    for ( auto & t : threads ) {
+      int32_t  tid;
+      uint64_t ne;
+      getRaw( stream, tid );
+      t.tid = tid;
+      getString( stream, t.name );
+      getRaw( stream, ne );
+      t.events.resize( size_t(ne) );
+      for ( auto & e : t.events ) {
+        getRaw( stream, e.ts_ns );
+        getRaw( stream, e.name );
+        getRaw( stream, e.arg );
+        getRaw( stream, e.phase );
+        UTILS_ASSERT0( e.name < nn, "traceData::readBinary, bad event name" );
+      }
+    }
+  }
+
+  /*\
+   |  eventTracer
+  \*/
+
+  namespace {
+
+    typedef std::chrono::steady_clock clock_type;
+
+    struct rawEvent {
+      uint64_t     ts_ns;
+      char const * name;
+      int32_t      arg;
+      char         phase;
+    };
+
+    // written only by its thread, `count` is the number of events ever recorded
+    struct traceRing {
+      vector<rawEvent>      events;
+      uint64_t              mask;
+      std::atomic<uint64_t> count;
+      integer               tid;
+      string                name;
+    };
+
+    std::mutex                          ring_mtx;
+    vector<std::unique_ptr<traceRing> > rings;
+    size_t                              ring_capacity = size_t(1) << 16;
+    clock_type::time_point              origin        = clock_type::now();
+
+    thread_local traceRing * my_ring = nullptr;
+
+    void
+    allocRing( traceRing & R ) {
+      size_t cap = 1;
+      while ( cap < ring_capacity ) cap <<= 1;
+      R.events.assign( cap, rawEvent() );
+      R.mask = cap-1;
+      R.count.store( 0, std::memory_order_relaxed );
+    }
+
+    traceRing *
+    myRing() {
+      if ( my_ring == nullptr ) {
+        std::lock_guard<std::mutex> lock( ring_mtx );
+        rings.emplace_back( new traceRing() );
+        traceRing & R = *rings.back();
+        allocRing( R );
+        R.tid  = integer( rings.size()-1 );
+        R.name = fmt::format( "thread {}", R.tid );
+        my_ring = &R;
+      }
+      return my_ring;
+    }
+
+  }
+
+  std::atomic<bool> eventTracer::s_enabled( false );
+
+  bool
+  eventTracer::compiledIn() {
+    #ifdef NL_TRACE
+    return true;
+    #else
+    return false;
+    #endif
+  }
+
+  void
+  eventTracer::enable( size_t capacity ) {
+    {
+      std::lock_guard<std::mutex> lock( ring_mtx );
+      ring_capacity = max( capacity, size_t(2) );
+      for ( auto & R : rings ) allocRing( *R );
+      origin = clock_type::now();
+    }
+    s_enabled = true;
+  }
+
+  void
+  eventTracer::disable() {
+    s_enabled = false;
+  }
+
+  void
+  eventTracer::setThreadName( string const & name ) {
+    traceRing * R = myRing();
+    std::lock_guard<std::mutex> lock( ring_mtx );
+    R->name = name;
+  }
+
+  void
+  eventTracer::record( char const * name, int32_t arg, char phase ) {
+    traceRing & R = *myRing();
+    uint64_t    k = R.count.load( std::memory_order_relaxed );
+    rawEvent  & e = R.events[size_t(k & R.mask)];
+    e.ts_ns = uint64_t( std::chrono::duration_cast<std::chrono::nanoseconds>(
+      clock_type::now() - origin
+    ).count() );
+    e.name  = name;
+    e.arg   = arg;
+    e.phase = phase;
+    R.count.store( k+1, std::memory_order_release );
+  }
+
+  void
+  eventTracer::clear() {
+    std::lock_guard<std::mutex> lock( ring_mtx );
+    for ( auto & R : rings ) R->count.store( 0, std::memory_order_relaxed );
+  }
+
+  void
+  eventTracer::snapshot( traceData & T ) {
+    std::lock_guard<std::mutex> lock( ring_mtx );
+    std::map<char const *,uint32_t> by_ptr;
+    std::map<string,uint32_t>       by_name;
+    T.names.clear();
+    T.threads.clear();
+    T.threads.reserve( rings.size() );
+    for ( auto const & pR : rings ) {
+      traceRing const & R = *pR;
+      uint64_t c  = R.count.load( std::memory_order_acquire );
+      uint64_t ne = min( c, R.mask+1 );
+      T.threads.push_back( traceData::thread() );
+      traceData::thread & t = T.threads.back();
+      t.tid  = R.tid;
+      t.name = R.name;
+      t.events.resize( size_t(ne) );
+      for ( uint64_t k = 0; k < ne; ++k ) {
+        rawEvent const & r = R.events[size_t((c-ne+k) & R.mask)];
+        // the same literal may have different addresses in different units
+        auto ip = by_ptr.find( r.name );
+        if ( ip == by_ptr.end() ) {
+          auto in = by_name.find( r.name );
+          if ( in == by_name.end() ) {
+            in = by_name.insert( std::make_pair( string(r.name), uint32_t(T.names.size()) ) ).first;
+            T.names.push_back( r.name );
+          }
+          ip = by_ptr.insert( std::make_pair( r.name, in->second ) ).first;
+        }
+        traceData::event & e = t.events[size_t(k)];
+        e.ts_ns = r.ts_ns;
+        e.name  = ip->second;
+        e.arg   = r.arg;
+        e.phase = r.phase;
+      }
+    }
+  }
+
+}
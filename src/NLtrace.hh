@@ -0,0 +1,165 @@
+/*\
+ |
+ |  Author:
+ |    Enrico Bertolazzi
+ |    University of Trento
+ |    Department of Industrial Engineering
+ |    Via Sommarive 9, I-38123, Povo, Trento, Italy
+ |    email: enrico.bertolazzi@unitn.it
+\*/
+
+#ifndef NL_TRACE_HH
+#define NL_TRACE_HH
+
+#include "testsNonlin.hh"
+
+#include <atomic>
+#include <cstdint>
+#include <istream>
+
+//!
+//! Trace points, compiled only when `NL_TRACE` is defined (the
+//! library and the programs must agree), otherwise they are empty.
+//! `NAME` must be a string literal (only the pointer is stored).
+//!
+#ifdef NL_TRACE
+  #define NL_TRACE_CAT2(A,B) A##B
+  #define NL_TRACE_CAT(A,B)  NL_TRACE_CAT2(A,B)
+  #define NL_TRACE_BEGIN(NAME,ARG)   NLproblem::eventTracer::begin( NAME, ARG )
+  #define NL_TRACE_END(NAME)         NLproblem::eventTracer::end( NAME )
+  #define NL_TRACE_INSTANT(NAME,ARG) NLproblem::eventTracer::instant( NAME, ARG )
+  #define NL_TRACE_SCOPE(NAME,ARG) \
+    NLproblem::traceScope NL_TRACE_CAT(nl_trace_scope_,__LINE__)( NAME, ARG )
+  #define NL_TRACE_THREAD_NAME(NAME) \
+    do { \
+      if ( NLproblem::eventTracer::enabled() ) NLproblem::eventTracer::setThreadName( NAME ); \
+    } while (0)
+#else
+  #define NL_TRACE_BEGIN(NAME,ARG)   ((void)0)
+  #define NL_TRACE_END(NAME)         ((void)0)
+  #define NL_TRACE_INSTANT(NAME,ARG) ((void)0)
+  #define NL_TRACE_SCOPE(NAME,ARG)   ((void)0)
+  #define NL_TRACE_THREAD_NAME(NAME) ((void)0)
+#endif
+
+namespace NLproblem {
+
+  //!
+  //! A trace: the events of each thread and the table of their names.
+  //! The phase of an event is `B` (begin), `E` (end) or `i` (instant),
+  //! as in the Chrome trace event format.
+  //!
+  class traceData {
+  public:
+
+    struct event {
+      uint64_t ts_ns; //!< nanoseconds from the start of the trace
+      uint32_t name;  //!< index in `names`
+      int32_t  arg;
+      char     phase;
+    };
+
+    struct thread {
+      integer       tid;
+      string        name;
+      vector<event> events;
+    };
+
+    vector<string> names;
+    vector<thread> threads;
+
+    size_t numEvents() const;
+
+    //!
+    //! Chrome/Perfetto trace event JSON (`chrome://tracing`,
+    //! `ui.perfetto.dev`), timestamps in microseconds.
+    //!
+    void writeChromeJSON( ostream_type & stream ) const;
+
+    //!
+    //! Compact binary form, 17 bytes for each event (native byte
+    //! order), meant to be written through a `zstream::ozstream`.
+    //!
+    void writeBinary( ostream_type & stream ) const;
+
+    //! read what `writeBinary` wrote
+    void readBinary( std::istream & stream );
+  };
+
+  /*\
+   |   _____                 _  _____
+   |  | ____|_   _____ _ __ | ||_   _| __ __ _  ___ ___ _ __
+   |  |  _| \ \ / / _ \ '_ \| __|| || '__/ _` |/ __/ _ \ '__|
+   |  | |___ \ V /  __/ | | | |_ | || | | (_| | (_|  __/ |
+   |  |_____| \_/ \___|_| |_|\__||_||_|  \__,_|\___\___|_|
+  \*/
+
+  //!
+  //! Process wide tracer of timed events.
+  //!
+  //! Each thread writes to its own ring buffer (allocated at its first
+  //! event, never freed), so recording an event takes no lock: a
+  //! relaxed load of the enable flag, a clock read and a store in the
+  //! buffer. When a buffer is full the oldest events are overwritten.
+  //! `enable`, `clear` and `snapshot` must be called when no thread
+  //! is recording (e.g. before and after a batch run).
+  //!
+  class eventTracer {
+  public:
+
+    //!
+    //! Start recording with rings of `capacity` events for each thread
+    //! (rounded up to a power of 2) and set the time origin.
+    //!
+    static void enable( size_t capacity = size_t(1) << 16 );
+
+    static void disable();
+
+    static bool
+    enabled()
+    { return s_enabled.load( std::memory_order_relaxed ); }
+
+    //! true if the library was compiled with `NL_TRACE`
+    static bool compiledIn();
+
+    //! name of the calling thread in the trace
+    static void setThreadName( string const & name );
+
+    static void
+    begin( char const * name, int32_t arg = 0 )
+    { if ( enabled() ) record( name, arg, 'B' ); }
+
+    static void
+    end( char const * name )
+    { if ( enabled() ) record( name, 0, 'E' ); }
+
+    static void
+    instant( char const * name, int32_t arg = 0 )
+    { if ( enabled() ) record( name, arg, 'i' ); }
+
+    //! drop the recorded events
+    static void clear();
+
+    //! copy of the recorded events, oldest first
+    static void snapshot( traceData & T );
+
+  private:
+
+    static std::atomic<bool> s_enabled;
+
+    static void record( char const * name, int32_t arg, char phase );
+  };
+
+  //! begin/end events of a scope
+  class traceScope {
+    char const * m_name;
+  public:
+    traceScope( char const * name, int32_t arg ) : m_name(name)
+    { eventTracer::begin( name, arg ); }
+    ~traceScope()
+    { eventTracer::end( m_name ); }
+  };
+
+}
+
+#endif
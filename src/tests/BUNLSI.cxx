@@ -728,6 +728,21 @@ public:
     UTILS_ASSERT0( x28 >  0, "x28" );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    for ( integer i : { 0, 3, 4, 5, 7, 9, 21, 27 } )
+      if ( firstOutside( x, i, i+1, above(0), real_inf ) >= 0 )
+        { which = i; return POINT_OUT_OF_BOUNDS; }
+    which = -1;
+    return POINT_ADMISSIBLE;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    for ( integer i : { 0, 3, 4, 5, 7, 9, 21, 27 } ) clampTo( x, i, i+1, above(0), real_inf );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     U.fill(real_max);
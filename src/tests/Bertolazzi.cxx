@@ -95,6 +95,18 @@ public:
     );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 0, 1, xmin, real_inf );
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 0, 1, xmin, real_inf );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     L(0) = xmin;
@@ -195,6 +207,18 @@ public:
       );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 0, n, above(-10), below(10) );
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 0, n, above(-10), below(10) );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     L.fill(-10);
@@ -15,8 +15,8 @@
 \*/
 
 class BroydenTridiagonalFunction : public nonlinearSystem {
-  real_type const alpha;
-  real_type const beta;
+  real_type alpha;
+  real_type beta;
 public:
   
   BroydenTridiagonalFunction(
@@ -68,6 +68,26 @@ public:
     }
   }
 
+  integer numParams() const override { return 2; }
+
+  string
+  paramName( integer k ) const override
+  { return k == 0 ? "alpha" : "beta"; }
+
+  real_type
+  getParam( integer k ) const override
+  { return k == 0 ? alpha : beta; }
+
+  void
+  setParam( integer k, real_type v ) override
+  { if ( k == 0 ) alpha = v; else beta = v; }
+
+  void
+  dFdp( dvec_t const & x, integer k, dvec_t & dfdp ) const override {
+    if ( k == 0 ) dfdp = -x.cwiseProduct(x);
+    else          dfdp.fill(1);
+  }
+
   integer
   jacobianNnz() const override {
     return 3*n-2;
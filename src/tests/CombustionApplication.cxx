@@ -82,6 +82,42 @@ public:
     f(9) = 0.2089296e-14*x(9) - x(0)*x(1);
   }
 
+  bool isPolynomial() const override { return true; }
+
+  void
+  polynomialForm( polynomialTerms & T ) const override {
+    addMonomial( T, 0, 1, {1} );
+    addMonomial( T, 0, 2, {5} );
+    addMonomial( T, 0, 1, {8} );
+    addMonomial( T, 0, 2, {9} );
+    addMonomial( T, 0, -1e-5 );
+    addMonomial( T, 1, 1, {2} );
+    addMonomial( T, 1, 1, {7} );
+    addMonomial( T, 1, -3e-5 );
+    addMonomial( T, 2, 1, {0} );
+    addMonomial( T, 2, 1, {2} );
+    addMonomial( T, 2, 2, {4} );
+    addMonomial( T, 2, 2, {7} );
+    addMonomial( T, 2, 1, {8} );
+    addMonomial( T, 2, 1, {9} );
+    addMonomial( T, 2, -5e-5 );
+    addMonomial( T, 3, 1, {3} );
+    addMonomial( T, 3, 2, {6} );
+    addMonomial( T, 3, -1e-5 );
+    addMonomial( T, 4, 0.5140437e-7, {4} );
+    addMonomial( T, 4, -1, {0,0} );
+    addMonomial( T, 5, 0.1006932e-6, {5} );
+    addMonomial( T, 5, -2, {1,1} );
+    addMonomial( T, 6, 0.7816278e-15, {6} );
+    addMonomial( T, 6, -1, {3,3} );
+    addMonomial( T, 7, 0.1496236e-6, {7} );
+    addMonomial( T, 7, -1, {0,2} );
+    addMonomial( T, 8, 0.6194411e-7, {8} );
+    addMonomial( T, 8, -1, {0,1} );
+    addMonomial( T, 9, 0.2089296e-14, {9} );
+    addMonomial( T, 9, -1, {0,1} );
+  }
+
   integer
   jacobianNnz() const override {
     return 29;
@@ -50,9 +50,26 @@ public:
 
   real_type
   evalFk( dvec_t const & x, integer k ) const {
-    dvec_t f(n);
-    evalF( x, f );
-    return f(k);
+    integer i = k - (k % 2);
+    real_type xm2, xm1, xp2, xp3;
+    if ( i == 0 ) {
+      xm2 = 1;
+      xm1 = 0;
+    } else {
+      xm2 = x(i-2);
+      xm1 = x(i-1);
+    }
+    if ( i >= n-2 ) {
+       xp2 = 0;
+       xp3 = 1;
+    } else {
+       xp2 = x(i+2);
+       xp3 = x(i+3);
+    }
+    real_type xi  = x(i);
+    real_type xp1 = x(i+1);
+    if ( k == i ) return alpha * xm2 + (alpha-1)*xp2 - xi*(1+theta*xp1);
+    else          return (alpha-1) * xm1 + (alpha-2)*xp3 - theta*xi*xp1;
   }
 
   void
@@ -189,9 +206,15 @@ public:
 
   real_type
   evalFk( dvec_t const & x, integer k ) const override {
-    dvec_t f(n);
-    evalF( x, f );
-    return f(k);
+    switch ( k ) {
+    case 0: return A0*x(0) - (1-x(0))*x(2) - A1 - theta*A1*x(1);
+    case 1: return B0*x(0) - (1-x(0))*x(3) - A1 - theta*A1*x(1);
+    case 2: return A1*x(0) - (1-x(0))*x(4) - x(2) - theta*x(2)*x(3);
+    }
+    real_type xp2 = 1;
+    if ( k+2 < n ) xp2 = x(k+2);
+    else if ( k+2 == n ) xp2 = 0;
+    return x(0)*x(k-2) - (1-x(0))*xp2 - x(k) - theta*x(k-1)*x(k);
   }
 
   void
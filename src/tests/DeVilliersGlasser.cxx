@@ -185,6 +185,20 @@ public:
     );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 0, 4, -500, 500 );
+    if ( which != 0 && !( x(1) > 0 ) ) which = 1;
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 0, 4, -500, 500 );
+    clampTo( x, 1, 2, above(0), 500 );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     L[0] = -500; U[0] = 500;
@@ -416,6 +430,20 @@ public:
     );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 0, 5, -500, 500 );
+    if ( which != 0 && !( x(1) > 0 ) ) which = 1;
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 0, 5, -500, 500 );
+    clampTo( x, 1, 2, above(0), 500 );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     L[0] = -500; U[0] = 500;
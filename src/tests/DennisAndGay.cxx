@@ -248,6 +248,18 @@ public:
       UTILS_ASSERT0( abs(x(i)) < 100, "Bad range" );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 0, n, above(-100), below(100) );
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 0, n, above(-100), below(100) );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     U.fill(100);
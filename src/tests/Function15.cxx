@@ -17,6 +17,8 @@ class Function15 : public nonlinearSystem {
   mutable map<INDEX,real_type> jac_idx_vals;
 public:
 
+  bool isThreadSafe() const override { return false; }
+
   Function15( integer neq )
   : nonlinearSystem(
       "Function 15",
@@ -161,4 +161,16 @@ public:
       UTILS_ASSERT( x(i)>0, "x[{}] = {} must be > 0", i, x(i) );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 0, n-1, above(0), real_inf );
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 0, n-1, above(0), real_inf );
+    return true;
+  }
+
 };
@@ -116,7 +116,7 @@ public:
   getInitialPoint( dvec_t & x, integer idx ) const override {
     for ( integer i = 0; i < n; i += 2 ) {
       x(i+0) = -50.0*(1+idx*9);
-      x(i+1) =  70.0*(1+idx*9);
+      if ( i+1 < n ) x(i+1) = 70.0*(1+idx*9);
     }
   }
 
@@ -130,6 +130,18 @@ public:
       UTILS_ASSERT0( abs(x(i)) < 1000, "Bad range" );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 0, n, above(-1000), below(1000) );
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 0, n, above(-1000), below(1000) );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     L.fill(-1000);
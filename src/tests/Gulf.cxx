@@ -188,6 +188,23 @@ public:
     }
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    // rr[i]-x(1) >= 0 for all i is a bound on x(1)
+    real_type rmin = *std::min_element( rr, rr+99 );
+    if      ( firstOutside( x, 0, 1, above(0), real_inf ) >= 0 ) which = 0;
+    else if ( firstOutside( x, 1, 2, above(0), rmin     ) >= 0 ) which = 1;
+    else { which = -1; return POINT_ADMISSIBLE; }
+    return POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 0, 1, above(0), real_inf );
+    clampTo( x, 1, 2, above(0), *std::min_element( rr, rr+99 ) );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     U.fill(real_max);
@@ -54,6 +54,20 @@ public:
     f(3) = (x(2)*x(1) + x(3)*x(3)) - a11;
   }
 
+  bool isPolynomial() const override { return true; }
+
+  void
+  polynomialForm( polynomialTerms & T ) const override {
+    // X*X - A with X = [ x0 x1 ; x2 x3 ] stored by rows
+    real_type const a[] = { a00, a01, a10, a11 };
+    for ( integer i = 0; i < 2; ++i )
+      for ( integer j = 0; j < 2; ++j ) {
+        for ( integer k = 0; k < 2; ++k )
+          addMonomial( T, 2*i+j, 1, { 2*i+k, 2*k+j } );
+        addMonomial( T, 2*i+j, -a[2*i+j] );
+      }
+  }
+
   integer
   jacobianNnz() const override
   { return n*n; }
@@ -194,6 +208,7 @@ public:
     a12 = f5(xe);
     a20 = f6(xe);
     a21 = f7(xe);
+    a22 = f8(xe);
   }
 
   real_type
@@ -225,6 +240,20 @@ public:
     f(8) = f8(x) - a22;
   }
 
+  bool isPolynomial() const override { return true; }
+
+  void
+  polynomialForm( polynomialTerms & T ) const override {
+    // X*X - A with X stored by rows
+    real_type const a[] = { a00, a01, a02, a10, a11, a12, a20, a21, a22 };
+    for ( integer i = 0; i < 3; ++i )
+      for ( integer j = 0; j < 3; ++j ) {
+        for ( integer k = 0; k < 3; ++k )
+          addMonomial( T, 3*i+j, 1, { 3*i+k, 3*k+j } );
+        addMonomial( T, 3*i+j, -a[3*i+j] );
+      }
+  }
+
   integer
   jacobianNnz() const override {
     return 45;
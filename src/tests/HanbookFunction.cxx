@@ -17,6 +17,8 @@ class HanbookFunction : public nonlinearSystem {
   mutable real_type sum2;
 public:
 
+  bool isThreadSafe() const override { return false; }
+
   HanbookFunction( integer neq)
   : nonlinearSystem(
       "Hanbook Function",
@@ -101,6 +101,18 @@ public:
     UTILS_ASSERT0( x > 0 && x < 0.95, "ARGUMENT ERROR" );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 0, 1, above(0), below(0.95) );
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 0, 1, above(0), below(0.95) );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     U[0] = 0.95; L[0] = 0;
@@ -99,6 +99,23 @@ public:
     f(9) = x(9) - a10 - b10 * x(3)*x(7)*x(0);
   }
 
+  bool isPolynomial() const override { return true; }
+
+  void
+  polynomialForm( polynomialTerms & T ) const override {
+    real_type const a[] = { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10 };
+    real_type const b[] = { b1, b2, b3, b4, b5, b6, b7, b8, b9, b10 };
+    integer const v[10][3] = {
+      {3,2,8}, {0,9,5}, {0,1,9}, {6,0,5}, {6,5,2},
+      {7,4,9}, {1,4,7}, {0,6,5}, {9,5,7}, {3,7,0}
+    };
+    for ( integer k = 0; k < 10; ++k ) {
+      addMonomial( T, k, 1, {k} );
+      addMonomial( T, k, -a[k] );
+      addMonomial( T, k, -b[k], { v[k][0], v[k][1], v[k][2] } );
+    }
+  }
+
   integer
   jacobianNnz() const override {
     return 40;
@@ -53,6 +53,22 @@ public:
     f(1) = 2*(1-x(1)) + tau*40000.0*t7*t2;
   }
 
+  integer   numParams() const override { return 1; }
+  string    paramName( integer ) const override { return "tau"; }
+  real_type getParam( integer ) const override { return tau; }
+  void      setParam( integer, real_type v ) override { tau = v; }
+
+  void
+  dFdp( dvec_t const & x, integer, dvec_t & dfdp ) const override {
+    real_type t1 = x(0)*x(0);
+    real_type t2 = x(1)-t1;
+    real_type t3 = t2*t2;
+    real_type t6 = power2(1.0-x(0));
+    real_type t7 = 10000.0*t3+t6-0.2E-1;
+    dfdp(0) = 4.0*t7*((1-20000.0*t2)*x(0)-1);
+    dfdp(1) = 40000.0*t7*t2;
+  }
+
   integer
   jacobianNnz() const override
   { return 4; }
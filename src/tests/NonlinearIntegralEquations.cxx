@@ -61,6 +61,31 @@ public:
     }
   }
 
+  bool
+  hasFixedPointForm() const override
+  { return true; }
+
+  void
+  fixedPointMap( dvec_t const & x, dvec_t & g ) const override {
+    real_type h = 1.0/(n-1.0);
+
+    g.setZero();
+
+    real_type si = 0;
+    for ( integer i = 1; i < n-1; ++i ) {
+      real_type t = h*i;
+      si   += power3(x(i)+t+1);
+      g(i) -= 0.5*(1-t)*si;
+    }
+
+    si = 0;
+    for ( integer i = n-2; i > 0; --i ) {
+      real_type t = h*i;
+      g(i) -= 0.5*(1-t)*t*si;
+      si   += power2(x(i)+t+1);
+    }
+  }
+
   integer
   jacobianNnz() const override
   { return n*n; }
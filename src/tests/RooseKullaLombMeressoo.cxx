@@ -1244,10 +1244,22 @@ public:
       UTILS_ASSERT0( x(i) < 0, "Bad range" );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 3, n, -real_inf, below(0) );
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 3, n, -real_inf, below(0) );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     integer i = 0;
-    for (; i < 3; ++i )
+    for (; i < 3 && i < n; ++i )
       { U[i] = real_max; L[i] = -real_max; }
     for (; i < n; ++i )
       { U[i] = 0; L[i] = -real_max; }
@@ -1523,6 +1535,18 @@ public:
     }
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 1, n, above(0), below(1000) );
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 1, n, above(0), below(1000) );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     U.fill(1000);
@@ -2106,14 +2130,20 @@ public:
 \*/
 
 class RooseKullaLombMeressoo215 : public nonlinearSystem {
-  mutable dvec_t grad_dS;
-  mutable dvec_t grad_S;
+  mutable dvec_t powg; // g(k)^j, n values for each k
+
+  // the powers of g(k) below `tiny` are set to 0, their products would
+  // be denormal numbers (very slow) and they are far below the rounding
+  // of the terms with g(28) = 1
+  real_type const tiny = 1e-100;
 
 public:
+
+  bool isThreadSafe() const override { return false; }
   
   RooseKullaLombMeressoo215( integer neq )
   : nonlinearSystem("Roose Kulla Lomb Meressoo N.215",RKM_BIBTEX,neq)
-  { checkMinEquations(n,1); grad_dS.resize(n); grad_S.resize(n); }
+  { checkMinEquations(n,1); powg.resize(29*n); }
 
   real_type
   g( integer k ) const
@@ -2124,41 +2154,26 @@ public:
     real_type sum = 0;
     real_type gkj = 1;
     real_type gk  = g(k);
-    for ( integer j = 0; j < n; ++j, gkj *= gk ) sum += gkj * x(j);
+    for ( integer j = 0; j < n && gkj > tiny; ++j, gkj *= gk ) sum += gkj * x(j);
     return sum;
   }
 
-  void
-  S_1( dvec_t const & x, integer k, dvec_t & grad ) const {
-    real_type gkj = 1;
-    real_type gk  = g(k);
-    for ( integer j = 0; j < n; ++j, gkj *= gk ) grad[j] = gkj;
-  }
-
   real_type
   dS( dvec_t const & x, integer k ) const {
     real_type sum = 0;
     real_type gkj = 1;
     real_type gk  = g(k);
-    for ( integer j = 1; j < n; ++j, gkj *= gk ) sum += j * gkj * x(j);
+    for ( integer j = 1; j < n && gkj > tiny; ++j, gkj *= gk ) sum += j * gkj * x(j);
     return sum;
   }
 
-  void
-  dS_1( dvec_t const & x, integer k, dvec_t & grad ) const {
-    real_type gkj = 1;
-    real_type gk  = g(k);
-    grad[0] = 0;
-    for ( integer j = 1; j < n; ++j, gkj *= gk ) grad[j] = j * gkj;
-  }
-  
   real_type
   powergk( integer k, integer i ) const {
     real_type gk  = g(k);
     if ( i == 0 ) return 1/gk;
     real_type res = 1;
-    for ( integer j = 1; j < i; ++j ) res *= gk;
-    return res;
+    for ( integer j = 1; j < i && res >= tiny; ++j ) res *= gk;
+    return res < tiny ? 0 : res;
   }
 
   real_type
@@ -2178,8 +2193,21 @@ public:
 
   void
   evalF( dvec_t const & x, dvec_t & f ) const override {
-    for ( integer j = 0; j < n; ++j )
-      f(j) = evalFk(x,j);
+    // the sums S and dS do not depend on the component, once for each k
+    f.setZero();
+    for ( integer k = 0; k < 29; ++k ) {
+      real_type Sk    = S(x,k);
+      real_type dSk   = dS(x,k);
+      real_type gk    = g(k);
+      real_type B     = dSk-Sk*Sk-1;
+      real_type powgk = 1;
+      for ( integer i = 0; i < n; ++i ) {
+        f(i) += (i == 0 ? 1/gk : powgk)*(i-2*gk*Sk)*B;
+        if ( i > 0 ) { powgk *= gk; if ( powgk < tiny ) powgk = 0; }
+      }
+    }
+    f(0) += x(0)*(1-2*(x(1)-x(0)*x(0)-1));
+    f(1) += x(1)-x(0)*x(0)-1;
   }
 
   integer
@@ -2196,21 +2224,32 @@ public:
 
   void
   jacobian( dvec_t const & x, dvec_t & jac ) const override {
+    real_type gk[29], Sk[29], Bk[29];
+    for ( integer k = 0; k < 29; ++k ) {
+      gk[k] = g(k);
+      Sk[k] = S(x,k);
+      Bk[k] = dS(x,k)-Sk[k]*Sk[k]-1;
+      real_type * G = powg.data() + k*n;
+      real_type gkj = 1;
+      for ( integer j = 0; j < n; ++j ) {
+        G[j] = gkj;
+        gkj *= gk[k];
+        if ( gkj < tiny ) gkj = 0;
+      }
+    }
+    // column by column (the jacobian is stored by columns) so that the
+    // column stays in cache while the 29 terms are accumulated
     jac.setZero();
-    for ( integer i = 0; i < n; ++i ) {
+    for ( integer j = 0; j < n; ++j ) {
+      real_type * col = jac.data() + caddr(0,j);
       for ( integer k = 0; k < 29; ++k ) {
-        real_type gk    = g(k);
-        real_type powgk = powergk(k,i);
-        real_type Sk    = S(x,k);
-        real_type dSk   = dS(x,k);
-        dS_1( x, k, grad_dS );
-        S_1( x, k, grad_S );
-        real_type A = i-2*gk*Sk;
-        real_type B = dSk-Sk*Sk-1;
-        for ( integer j = 0; j < n; ++j ) {
-          real_type A_1 = -2*gk*grad_S[j];
-          real_type B_1 = grad_dS[j]-2*Sk*grad_S[j];
-          jac[caddr(i,j)] += powgk*(A_1*B+A*B_1);
+        real_type const * G = powg.data() + k*n;
+        real_type A_1 = -2*gk[k]*G[j];
+        real_type B_1 = (j == 0 ? 0 : j * G[j-1])-2*Sk[k]*G[j];
+        for ( integer i = 0; i < n; ++i ) {
+          real_type A  = i-2*gk[k]*Sk[k];
+          real_type pk = i == 0 ? 1/gk[k] : G[i-1];
+          col[i] += pk*(A_1*Bk[k]+A*B_1);
         }
       }
     }
@@ -2303,6 +2342,8 @@ public:
 class RooseKullaLombMeressoo216 : public nonlinearSystem {
   mutable vector<vector<real_type> > m_y, m_y_D;
 public:
+
+  bool isThreadSafe() const override { return false; }
   
   RooseKullaLombMeressoo216( integer neq )
   : nonlinearSystem("Roose Kulla Lomb Meressoo N.216",RKM_BIBTEX,neq) {
@@ -2477,6 +2518,18 @@ public:
       UTILS_ASSERT0( x(i) > 0, "Bad range" );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 0, n, above(0), real_inf );
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 0, n, above(0), real_inf );
+    return true;
+  }
+
   string note() const { return "Each permutation of x is a solution"; }
 
 };
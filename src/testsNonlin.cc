@@ -1,5 +1,8 @@
 #include "testsNonlin.hh"
 #include <sstream>
+#include <algorithm>
+#include <cstring>
+#include <limits>
 
 namespace NLproblem {
 
@@ -164,6 +167,569 @@ namespace NLproblem {
     return nnz;
   };
 
+  void
+  nonlinearSystem::polynomialDegrees( ivec_t & deg ) const {
+    polynomialTerms terms;
+    polynomialForm( terms );
+    deg.setZero( n );
+    for ( auto const & t : terms ) {
+      UTILS_ASSERT(
+        t.eq >= 0 && t.eq < n,
+        "polynomialDegrees, `{}` bad equation index {}", title(), t.eq
+      );
+      if ( t.coeff != 0 ) deg(t.eq) = max( deg(t.eq), integer(t.var.size()) );
+    }
+  }
+
+  string
+  nonlinearSystem::paramName( integer k ) const {
+    UTILS_ERROR( "paramName, `{}` has no parameter {}\n", title(), k );
+  }
+
+  real_type
+  nonlinearSystem::getParam( integer k ) const {
+    UTILS_ERROR( "getParam, `{}` has no parameter {}\n", title(), k );
+  }
+
+  void
+  nonlinearSystem::setParam( integer k, real_type ) {
+    UTILS_ERROR( "setParam, `{}` has no parameter {}\n", title(), k );
+  }
+
+  void
+  nonlinearSystem::dFdp( dvec_t const &, integer k, dvec_t & ) const {
+    UTILS_ERROR( "dFdp, `{}` has no parameter {}\n", title(), k );
+  }
+
+  admissibleStatus
+  nonlinearSystem::isAdmissible( dvec_t const & x, integer & which ) const noexcept {
+    which = -1;
+    try {
+      checkIfAdmissible( x );
+    }
+    catch ( ... ) {
+      return POINT_NOT_ADMISSIBLE;
+    }
+    return POINT_ADMISSIBLE;
+  }
+
+  string
+  nonlinearLeastSquares::paramName( integer k ) const {
+    UTILS_ERROR( "paramName, `{}` has no parameter {}\n", title(), k );
+  }
+
+  real_type
+  nonlinearLeastSquares::getParam( integer k ) const {
+    UTILS_ERROR( "getParam, `{}` has no parameter {}\n", title(), k );
+  }
+
+  void
+  nonlinearLeastSquares::setParam( integer k, real_type ) {
+    UTILS_ERROR( "setParam, `{}` has no parameter {}\n", title(), k );
+  }
+
+  void
+  nonlinearLeastSquares::dFdp( dvec_t const &, integer k, dvec_t & ) const {
+    UTILS_ERROR( "dFdp, `{}` has no parameter {}\n", title(), k );
+  }
+
+  admissibleStatus
+  nonlinearLeastSquares::isAdmissible( dvec_t const & x, integer & which ) const noexcept {
+    which = -1;
+    try {
+      checkIfAdmissible( x );
+    }
+    catch ( ... ) {
+      return POINT_NOT_ADMISSIBLE;
+    }
+    return POINT_ADMISSIBLE;
+  }
+
+  /*\
+   |  nonlinearSystemInstrumented
+  \*/
+
+  nonlinearSystemInstrumented::nonlinearSystemInstrumented(
+    nonlinearSystem const * _pNS,
+    bool                    on
+  )
+  : nonlinearSystem( _pNS )
+  , pNS(_pNS)
+  , pNSmutable(nullptr)
+  , m_enabled(on)
+  { resetStats(); }
+
+  nonlinearSystemInstrumented::nonlinearSystemInstrumented(
+    nonlinearSystem * _pNS,
+    bool              on
+  )
+  : nonlinearSystemInstrumented( static_cast<nonlinearSystem const *>(_pNS), on )
+  { pNSmutable = _pNS; }
+
+  void
+  nonlinearSystemInstrumented::setParam( integer k, real_type value ) {
+    UTILS_ASSERT(
+      pNSmutable != nullptr,
+      "setParam, `{}` wraps a const problem", title()
+    );
+    pNSmutable->setParam( k, value );
+  }
+
+  void
+  nonlinearSystemInstrumented::resetStats() {
+    for ( integer k = 0; k < STAT_SIZE; ++k ) {
+      m_calls[k] = 0;
+      m_ns[k]    = 0;
+    }
+  }
+
+  evaluationStats
+  nonlinearSystemInstrumented::stats() const {
+    evaluationStats S;
+    S.num_F       = m_calls[STAT_F];
+    S.num_Fk      = m_calls[STAT_FK];
+    S.num_J       = m_calls[STAT_J];
+    S.num_pattern = m_calls[STAT_PATTERN];
+    S.ns_F        = m_ns[STAT_F];
+    S.ns_Fk       = m_ns[STAT_FK];
+    S.ns_J        = m_ns[STAT_J];
+    S.ns_pattern  = m_ns[STAT_PATTERN];
+    return S;
+  }
+
+  real_type
+  nonlinearSystemInstrumented::evalFk( dvec_t const & x, integer k ) const {
+    if ( !enabled() ) return pNS->evalFk( x, k );
+    clock_type::time_point t0 = clock_type::now();
+    real_type res = pNS->evalFk( x, k );
+    count( STAT_FK, t0 );
+    return res;
+  }
+
+  void
+  nonlinearSystemInstrumented::evalF( dvec_t const & x, dvec_t & f ) const {
+    if ( !enabled() ) { pNS->evalF( x, f ); return; }
+    clock_type::time_point t0 = clock_type::now();
+    pNS->evalF( x, f );
+    count( STAT_F, t0 );
+  }
+
+  void
+  nonlinearSystemInstrumented::jacobian( dvec_t const & x, dvec_t & jac ) const {
+    if ( !enabled() ) { pNS->jacobian( x, jac ); return; }
+    clock_type::time_point t0 = clock_type::now();
+    pNS->jacobian( x, jac );
+    count( STAT_J, t0 );
+  }
+
+  void
+  nonlinearSystemInstrumented::jacobianPattern( ivec_t & i, ivec_t & j ) const {
+    if ( !enabled() ) { pNS->jacobianPattern( i, j ); return; }
+    clock_type::time_point t0 = clock_type::now();
+    pNS->jacobianPattern( i, j );
+    count( STAT_PATTERN, t0 );
+  }
+
+  void
+  nonlinearSystemInstrumented::fixedPointMap( dvec_t const & x, dvec_t & g ) const {
+    // the default map calls evalF of the wrapper, already counted
+    if ( !pNS->hasFixedPointForm() ) { nonlinearSystem::fixedPointMap( x, g ); return; }
+    if ( !enabled() ) { pNS->fixedPointMap( x, g ); return; }
+    clock_type::time_point t0 = clock_type::now();
+    pNS->fixedPointMap( x, g );
+    count( STAT_F, t0 );
+  }
+
+  /*\
+   |  nonlinearSystemCached
+  \*/
+
+  nonlinearSystemCached::nonlinearSystemCached(
+    nonlinearSystem const * _pNS,
+    integer                 capacity
+  )
+  : nonlinearSystem( _pNS )
+  , pNS(_pNS)
+  , pNSmutable(nullptr)
+  , m_entries( size_t( max( capacity, 1 ) ) )
+  , m_clock(0)
+  {
+    clearCache();
+    resetStats();
+  }
+
+  nonlinearSystemCached::nonlinearSystemCached(
+    nonlinearSystem * _pNS,
+    integer           capacity
+  )
+  : nonlinearSystemCached( static_cast<nonlinearSystem const *>(_pNS), capacity )
+  { pNSmutable = _pNS; }
+
+  void
+  nonlinearSystemCached::setParam( integer k, real_type value ) {
+    UTILS_ASSERT(
+      pNSmutable != nullptr,
+      "setParam, `{}` wraps a const problem", title()
+    );
+    pNSmutable->setParam( k, value );
+    clearCache(); // F and J of the stored points are of the old value
+  }
+
+  void
+  nonlinearSystemCached::clearCache() {
+    std::lock_guard<std::mutex> lock( m_mtx );
+    for ( auto & e : m_entries ) {
+      e.last_use = 0;
+      e.has_F    = e.has_J = false;
+    }
+  }
+
+  void
+  nonlinearSystemCached::resetStats() {
+    m_num_F = m_num_Fk = m_num_J = 0;
+    m_hit_F = m_hit_Fk = m_hit_J = 0;
+  }
+
+  evaluationStats
+  nonlinearSystemCached::stats() const {
+    evaluationStats S;
+    S.num_F  = m_num_F;
+    S.num_Fk = m_num_Fk;
+    S.num_J  = m_num_J;
+    S.hit_F  = m_hit_F;
+    S.hit_Fk = m_hit_Fk;
+    S.hit_J  = m_hit_J;
+    return S;
+  }
+
+  uint64_t
+  nonlinearSystemCached::hashOf( dvec_t const & x ) {
+    uint64_t h = 0x9E3779B97F4A7C15ULL;
+    for ( integer i = 0; i < x.size(); ++i ) {
+      uint64_t b;
+      std::memcpy( &b, x.data()+i, sizeof(b) );
+      h ^= b + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+    }
+    return h;
+  }
+
+  nonlinearSystemCached::entry *
+  nonlinearSystemCached::find( dvec_t const & x, uint64_t h ) const {
+    for ( auto & e : m_entries ) {
+      if ( e.last_use == 0 || e.hash != h || e.x.size() != x.size() ) continue;
+      if ( std::memcmp( e.x.data(), x.data(), size_t(x.size())*sizeof(real_type) ) != 0 ) continue;
+      e.last_use = ++m_clock;
+      return &e;
+    }
+    return nullptr;
+  }
+
+  nonlinearSystemCached::entry &
+  nonlinearSystemCached::slotFor( dvec_t const & x, uint64_t h ) const {
+    entry * pe = find( x, h );
+    if ( pe != nullptr ) return *pe;
+    pe = &m_entries.front();
+    for ( auto & e : m_entries )
+      if ( e.last_use < pe->last_use ) pe = &e;
+    pe->hash     = h;
+    pe->last_use = ++m_clock;
+    pe->x        = x;
+    pe->has_F    = pe->has_J = false;
+    return *pe;
+  }
+
+  real_type
+  nonlinearSystemCached::evalFk( dvec_t const & x, integer k ) const {
+    ++m_num_Fk;
+    uint64_t h = hashOf( x );
+    {
+      std::lock_guard<std::mutex> lock( m_mtx );
+      entry const * pe = find( x, h );
+      if ( pe != nullptr && pe->has_F ) { ++m_hit_Fk; return pe->F.coeff(k); }
+    }
+    return pNS->evalFk( x, k );
+  }
+
+  void
+  nonlinearSystemCached::evalF( dvec_t const & x, dvec_t & f ) const {
+    ++m_num_F;
+    uint64_t h = hashOf( x );
+    {
+      std::lock_guard<std::mutex> lock( m_mtx );
+      entry const * pe = find( x, h );
+      if ( pe != nullptr && pe->has_F ) { ++m_hit_F; f = pe->F; return; }
+    }
+    pNS->evalF( x, f );
+    std::lock_guard<std::mutex> lock( m_mtx );
+    entry & e = slotFor( x, h );
+    e.F     = f;
+    e.has_F = true;
+  }
+
+  void
+  nonlinearSystemCached::jacobian( dvec_t const & x, dvec_t & jac ) const {
+    ++m_num_J;
+    uint64_t h = hashOf( x );
+    {
+      std::lock_guard<std::mutex> lock( m_mtx );
+      entry const * pe = find( x, h );
+      if ( pe != nullptr && pe->has_J ) { ++m_hit_J; jac = pe->J; return; }
+    }
+    pNS->jacobian( x, jac );
+    std::lock_guard<std::mutex> lock( m_mtx );
+    entry & e = slotFor( x, h );
+    e.J     = jac;
+    e.has_J = true;
+  }
+
+  void
+  nonlinearSystemCached::fixedPointMap( dvec_t const & x, dvec_t & g ) const {
+    // the default map calls evalF of the wrapper, already cached
+    if ( pNS->hasFixedPointForm() ) pNS->fixedPointMap( x, g );
+    else                            nonlinearSystem::fixedPointMap( x, g );
+  }
+
+  /*\
+   |  nonlinearSystemFromLeastSquares
+  \*/
+
+  nonlinearSystemFromLeastSquares::nonlinearSystemFromLeastSquares(
+    nonlinearLeastSquares const * _pLS
+  )
+  : nonlinearSystem( _pLS->title(), _pLS->bibtex(), _pLS->dimX() )
+  , pLS(_pLS)
+  , pLSmutable(nullptr)
+  {
+    integer const nnzJ = pLS->jacobianNnz();
+    integer const nnzT = pLS->tensorNnz();
+    m_JI.resize( nnzJ );
+    m_JJ.resize( nnzJ );
+    m_TI.resize( nnzT );
+    m_TJ.resize( nnzT );
+    pLS->jacobianPattern( m_JI, m_JJ );
+    pLS->tensorPattern( m_TI, m_TJ );
+
+    // nonzeros of the jacobian row by row
+    vector<vector<integer> > rows( size_t(pLS->dimF()) );
+    for ( integer k = 0; k < nnzJ; ++k ) rows[size_t(m_JI(k))].push_back(k);
+
+    map<pair<integer,integer>,integer> index;
+    vector<integer> I, J, pairs;
+    auto lookup = [&index,&I,&J]( integer i, integer j ) -> integer {
+      auto res = index.insert( std::make_pair( std::make_pair(i,j), integer(I.size()) ) );
+      if ( res.second ) { I.push_back(i); J.push_back(j); }
+      return res.first->second;
+    };
+
+    // (J^T J)(a,b) = sum_k J(k,a)*J(k,b)
+    for ( auto const & row : rows ) {
+      for ( integer k1 : row ) {
+        for ( integer k2 : row ) {
+          pairs.push_back( k1 );
+          pairs.push_back( k2 );
+          pairs.push_back( lookup( m_JJ(k1), m_JJ(k2) ) );
+        }
+      }
+    }
+
+    m_tpos1.resize( nnzT );
+    m_tpos2.resize( nnzT );
+    for ( integer k = 0; k < nnzT; ++k ) {
+      integer i = m_TI(k);
+      integer j = m_TJ(k);
+      UTILS_ASSERT(
+        i >= j,
+        "nonlinearSystemFromLeastSquares, tensor pattern ({},{}) not lower triangular",
+        i, j
+      );
+      m_tpos1(k) = lookup( i, j );
+      m_tpos2(k) = i == j ? -1 : lookup( j, i );
+    }
+
+    integer const nnz = integer(I.size());
+    m_I.resize( nnz );
+    m_J.resize( nnz );
+    for ( integer k = 0; k < nnz; ++k ) { m_I(k) = I[k]; m_J(k) = J[k]; }
+    m_pair.resize( integer(pairs.size()) );
+    for ( size_t k = 0; k < pairs.size(); ++k ) m_pair(integer(k)) = pairs[k];
+  }
+
+  nonlinearSystemFromLeastSquares::nonlinearSystemFromLeastSquares(
+    nonlinearLeastSquares * _pLS
+  )
+  : nonlinearSystemFromLeastSquares( static_cast<nonlinearLeastSquares const *>(_pLS) )
+  { pLSmutable = _pLS; }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  nonlinearSystemFromLeastSquares::evalF( dvec_t const & x, dvec_t & g ) const {
+    dvec_t r( pLS->dimF() ), jac( m_JI.size() );
+    pLS->evalF( x, r );
+    pLS->jacobian( x, jac );
+    g.setZero();
+    for ( integer k = 0; k < jac.size(); ++k ) g(m_JJ(k)) += jac(k) * r(m_JI(k));
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  nonlinearSystemFromLeastSquares::jacobian( dvec_t const & x, dvec_t & res ) const {
+    dvec_t r( pLS->dimF() ), jac( m_JI.size() ), tens( m_TI.size() );
+    pLS->evalF( x, r );
+    pLS->jacobian( x, jac );
+    res.setZero();
+    for ( integer k = 0; k < m_pair.size(); k += 3 )
+      res(m_pair(k+2)) += jac(m_pair(k)) * jac(m_pair(k+1));
+    if ( tens.size() > 0 ) {
+      pLS->tensor( x, r, tens );
+      for ( integer k = 0; k < tens.size(); ++k ) {
+        res(m_tpos1(k)) += tens(k);
+        if ( m_tpos2(k) >= 0 ) res(m_tpos2(k)) += tens(k);
+      }
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  nonlinearSystemFromLeastSquares::setParam( integer k, real_type value ) {
+    UTILS_ASSERT(
+      pLSmutable != nullptr,
+      "setParam, `{}` wraps a const problem", title()
+    );
+    pLSmutable->setParam( k, value );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  nonlinearSystemFromLeastSquares::dFdp(
+    dvec_t const & x,
+    integer        kp,
+    dvec_t       & g
+  ) const {
+    integer const nr = pLS->dimF();
+    dvec_t r( nr ), jac( m_JI.size() ), d0( nr ), d1( nr ), xh( x );
+    pLS->evalF( x, r );
+    pLS->jacobian( x, jac );
+    pLS->dFdp( x, kp, d0 );
+
+    // J^T dF/dp
+    g.setZero();
+    for ( integer k = 0; k < jac.size(); ++k ) g(m_JJ(k)) += jac(k) * d0(m_JI(k));
+
+    // (dJ/dp)^T F, column j is F . d/dx_j ( dF/dp )
+    real_type const eps = std::sqrt( numeric_limits<real_type>::epsilon() );
+    for ( integer j = 0; j < n; ++j ) {
+      real_type h = eps * max( real_type(1), std::abs( x(j) ) );
+      xh(j) = x(j) + h;
+      h     = xh(j) - x(j);
+      pLS->dFdp( xh, kp, d1 );
+      xh(j) = x(j);
+      g(j) += r.dot( d1 - d0 ) / h;
+    }
+  }
+
+  /*\
+   |  nonlinearLeastSquaresFromSystem
+  \*/
+
+  nonlinearLeastSquaresFromSystem::nonlinearLeastSquaresFromSystem(
+    nonlinearSystem const * _pNS
+  )
+  : nonlinearLeastSquares(
+      _pNS->title(), _pNS->bibtex(), _pNS->numEqns(), _pNS->numEqns()
+    )
+  , pNS(_pNS)
+  , pNSmutable(nullptr)
+  {
+    integer const nnz = pNS->jacobianNnz();
+    ivec_t I( nnz ), J( nnz );
+    pNS->jacobianPattern( I, J );
+
+    // the hessian of F_k is nonzero only on the pairs of columns
+    // of row k, that is on the pattern of J^T J, built column by
+    // column with a marker so that memory is proportional to the result
+    vector<vector<integer> > rows( static_cast<size_t>(n) ), cols( static_cast<size_t>(n) );
+    for ( integer k = 0; k < nnz; ++k ) {
+      rows[size_t(I(k))].push_back( J(k) );
+      cols[size_t(J(k))].push_back( I(k) );
+    }
+    vector<integer> TI, TJ, mark( static_cast<size_t>(n), -1 );
+    for ( integer j = 0; j < n; ++j ) {
+      size_t k0 = TI.size();
+      for ( integer r : cols[size_t(j)] ) {
+        for ( integer i : rows[size_t(r)] ) {
+          if ( i >= j && mark[size_t(i)] != j ) {
+            mark[size_t(i)] = j;
+            TI.push_back( i );
+            TJ.push_back( j );
+          }
+        }
+      }
+      std::sort( TI.begin()+k0, TI.end() );
+    }
+
+    // sorted by column, as needed by tensor
+    integer const nnzT = integer(TI.size());
+    m_TI.resize( nnzT );
+    m_TJ.resize( nnzT );
+    for ( integer k = 0; k < nnzT; ++k ) {
+      m_TI(k) = TI[size_t(k)];
+      m_TJ(k) = TJ[size_t(k)];
+    }
+  }
+
+  nonlinearLeastSquaresFromSystem::nonlinearLeastSquaresFromSystem(
+    nonlinearSystem * _pNS
+  )
+  : nonlinearLeastSquaresFromSystem( static_cast<nonlinearSystem const *>(_pNS) )
+  { pNSmutable = _pNS; }
+
+  void
+  nonlinearLeastSquaresFromSystem::setParam( integer k, real_type value ) {
+    UTILS_ASSERT(
+      pNSmutable != nullptr,
+      "setParam, `{}` wraps a const problem", title()
+    );
+    pNSmutable->setParam( k, value );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  nonlinearLeastSquaresFromSystem::tensor(
+    dvec_t const & x,
+    dvec_t const & lambda,
+    dvec_t       & tens
+  ) const {
+    integer const nnz = pNS->jacobianNnz();
+    ivec_t I( nnz ), J( nnz );
+    dvec_t jac( nnz ), w0( n ), w1( n ), xh( x );
+    pNS->jacobianPattern( I, J );
+
+    // column j of sum_k lambda_k Hess F_k = d/dx_j ( J(x)^T lambda )
+    pNS->jacobian( x, jac );
+    w0.setZero();
+    for ( integer k = 0; k < nnz; ++k ) w0(J(k)) += jac(k) * lambda(I(k));
+
+    real_type const eps = std::sqrt( numeric_limits<real_type>::epsilon() );
+    integer k = 0;
+    while ( k < m_TJ.size() ) {
+      integer   j = m_TJ(k);
+      real_type h = eps * max( real_type(1), std::abs( x(j) ) );
+      xh(j) = x(j) + h;
+      h     = xh(j) - x(j);
+      pNS->jacobian( xh, jac );
+      xh(j) = x(j);
+      w1.setZero();
+      for ( integer kk = 0; kk < nnz; ++kk ) w1(J(kk)) += jac(kk) * lambda(I(kk));
+      for ( ; k < m_TJ.size() && m_TJ(k) == j; ++k )
+        tens(k) = ( w1(m_TI(k)) - w0(m_TI(k)) ) / h;
+    }
+  }
+
   #include "tests/ArtificialTestOfNowakAndWeimann.cxx"
   #include "tests/BadlyScaledAugmentedPowellFunction.cxx"
   #include "tests/Beale.cxx"
@@ -286,8 +852,26 @@ namespace NLproblem {
   #include "tests/YixunShi.cxx"
   #include "tests/ZeroJacobianFunction.cxx"
 
-  std::vector<nonlinearSystem*> theProblems;
-  std::map<string,integer>      theProblemsMap;
+  std::vector<nonlinearSystem*>            theProblems;
+  std::map<string,integer>                 theProblemsMap;
+  std::map<string,scalableProblemBuilder>  theScalableProblems;
+  std::map<string,scalableComplexity>      theScalableComplexity;
+
+  static
+  void
+  addScalable(
+    string const &         name,
+    scalableProblemBuilder builder,
+    real_type              residual,
+    real_type              sweep,
+    real_type              jacobian
+  ) {
+    theScalableProblems[name] = builder;
+    scalableComplexity & c = theScalableComplexity[name];
+    c.residual = residual;
+    c.sweep    = sweep;
+    c.jacobian = jacobian;
+  }
 
   void
   initProblems() {
@@ -814,6 +1398,73 @@ namespace NLproblem {
     integer n = 0;
     for ( auto & m : theProblems )
       theProblemsMap[m->title()] = n++;
+
+    // scalable families with the declared exponents of
+    // evalF, evalFk sweep and jacobian
+    addScalable( "Chandrasekhar(0.9)", []( integer neq ) -> nonlinearSystem * { return new Chandrasekhar(0.9,neq); }, 2, 2, 2 );
+    addScalable( "Chandrasekhar(0.9999)", []( integer neq ) -> nonlinearSystem * { return new Chandrasekhar(0.9999,neq); }, 2, 2, 2 );
+    addScalable( "BroydenTridiagonalFunction", []( integer neq ) -> nonlinearSystem * { return new BroydenTridiagonalFunction(0.5,1,neq); }, 1, 1, 1 );
+    addScalable( "BadlyScaledAugmentedPowellFunction", []( integer neq ) -> nonlinearSystem * { return new BadlyScaledAugmentedPowellFunction(neq); }, 1, 1, 1 );
+    addScalable( "BrownAlmostLinearFunction", []( integer neq ) -> nonlinearSystem * { return new BrownAlmostLinearFunction(neq); }, 1, 2, 2 );
+    addScalable( "ChebyquadFunction", []( integer neq ) -> nonlinearSystem * { return new ChebyquadFunction(neq); }, 2, 2, 2 );
+    addScalable( "ComplementaryFunction", []( integer neq ) -> nonlinearSystem * { return new ComplementaryFunction(neq); }, 1, 1, 1 );
+    addScalable( "CountercurrentReactorsProblem1", []( integer neq ) -> nonlinearSystem * { return new CountercurrentReactorsProblem1(neq); }, 1, 1, 1 );
+    addScalable( "CountercurrentReactorsProblem2", []( integer neq ) -> nonlinearSystem * { return new CountercurrentReactorsProblem2(neq); }, 1, 1, 1 );
+    addScalable( "DiagonalFunctionMulQO", []( integer neq ) -> nonlinearSystem * { return new DiagonalFunctionMulQO(neq); }, 1, 1, 1 );
+    addScalable( "DiscreteBoundaryValueFunction", []( integer neq ) -> nonlinearSystem * { return new DiscreteBoundaryValueFunction(neq); }, 1, 1, 1 );
+    addScalable( "DiscreteIntegralEquationFunction", []( integer neq ) -> nonlinearSystem * { return new DiscreteIntegralEquationFunction(neq); }, 2, 2, 2 );
+    addScalable( "DixonFunction", []( integer neq ) -> nonlinearSystem * { return new DixonFunction(neq); }, 1, 1, 1 );
+    addScalable( "ExponentialFunction1", []( integer neq ) -> nonlinearSystem * { return new ExponentialFunction1(neq); }, 1, 1, 1 );
+    addScalable( "ExponentialFunction2", []( integer neq ) -> nonlinearSystem * { return new ExponentialFunction2(neq); }, 1, 1, 1 );
+    addScalable( "ExponentialFunction3", []( integer neq ) -> nonlinearSystem * { return new ExponentialFunction3(neq); }, 1, 1, 1 );
+    // the jacobian of Function15 walks a std::map: n log n, that is a
+    // local exponent of about 1.2 between 10^2 and 10^6 equations
+    addScalable( "Function15", []( integer neq ) -> nonlinearSystem * { return new Function15(neq); }, 1, 1, 1.2 );
+    addScalable( "Function18", []( integer neq ) -> nonlinearSystem * { return new Function18(neq); }, 1, 1, 1 );
+    addScalable( "Function21", []( integer neq ) -> nonlinearSystem * { return new Function21(neq); }, 1, 1, 1 );
+    addScalable( "Function27", []( integer neq ) -> nonlinearSystem * { return new Function27(neq); }, 1, 1, 1 );
+    addScalable( "GeneralizedRosenbrock", []( integer neq ) -> nonlinearSystem * { return new GeneralizedRosenbrock(neq); }, 1, 1, 1 );
+    addScalable( "GeometricProgrammingFunction", []( integer neq ) -> nonlinearSystem * { return new GeometricProgrammingFunction(neq); }, 2, 2, 2 );
+    addScalable( "GheriMancino", []( integer neq ) -> nonlinearSystem * { return new GheriMancino(neq); }, 2, 2, 2 );
+    addScalable( "GregoryAndKarney", []( integer neq ) -> nonlinearSystem * { return new GregoryAndKarney(neq); }, 1, 1, 1 );
+    addScalable( "GriewankFunction", []( integer neq ) -> nonlinearSystem * { return new GriewankFunction(neq); }, 2, 2, 2 );
+    addScalable( "HanbookFunction", []( integer neq ) -> nonlinearSystem * { return new HanbookFunction(neq); }, 1, 2, 2 );
+    addScalable( "Hilbert", []( integer neq ) -> nonlinearSystem * { return new Hilbert(neq); }, 2, 2, 2 );
+    addScalable( "LogarithmicFunction", []( integer neq ) -> nonlinearSystem * { return new LogarithmicFunction(neq); }, 1, 1, 1 );
+    addScalable( "PenaltyIfunction", []( integer neq ) -> nonlinearSystem * { return new PenaltyIfunction(neq); }, 1, 1, 1 );
+    addScalable( "PenaltyN1", []( integer neq ) -> nonlinearSystem * { return new PenaltyN1(neq); }, 1, 2, 2 );
+    addScalable( "PenaltyN2", []( integer neq ) -> nonlinearSystem * { return new PenaltyN2(neq); }, 1, 2, 2 );
+    addScalable( "RooseKullaLombMeressoo201", []( integer neq ) -> nonlinearSystem * { return new RooseKullaLombMeressoo201(neq); }, 1, 1, 1 );
+    addScalable( "RooseKullaLombMeressoo202", []( integer neq ) -> nonlinearSystem * { return new RooseKullaLombMeressoo202(neq); }, 1, 1, 1 );
+    addScalable( "RooseKullaLombMeressoo203", []( integer neq ) -> nonlinearSystem * { return new RooseKullaLombMeressoo203(neq); }, 1, 2, 2 );
+    addScalable( "RooseKullaLombMeressoo204", []( integer neq ) -> nonlinearSystem * { return new RooseKullaLombMeressoo204(neq); }, 1, 1, 1 );
+    addScalable( "RooseKullaLombMeressoo205", []( integer neq ) -> nonlinearSystem * { return new RooseKullaLombMeressoo205(neq); }, 1, 2, 2 );
+    addScalable( "RooseKullaLombMeressoo206", []( integer neq ) -> nonlinearSystem * { return new RooseKullaLombMeressoo206(neq); }, 1, 1, 1 );
+    addScalable( "RooseKullaLombMeressoo207", []( integer neq ) -> nonlinearSystem * { return new RooseKullaLombMeressoo207(neq); }, 1, 1, 1 );
+    addScalable( "RooseKullaLombMeressoo208", []( integer neq ) -> nonlinearSystem * { return new RooseKullaLombMeressoo208(neq); }, 1, 1, 1 );
+    addScalable( "RooseKullaLombMeressoo209", []( integer neq ) -> nonlinearSystem * { return new RooseKullaLombMeressoo209(neq); }, 1, 1, 1 );
+    addScalable( "RooseKullaLombMeressoo212", []( integer neq ) -> nonlinearSystem * { return new RooseKullaLombMeressoo212(neq); }, 1, 1, 1 );
+    addScalable( "RooseKullaLombMeressoo213", []( integer neq ) -> nonlinearSystem * { return new RooseKullaLombMeressoo213(neq); }, 1, 1, 1 );
+    addScalable( "RooseKullaLombMeressoo214", []( integer neq ) -> nonlinearSystem * { return new RooseKullaLombMeressoo214(neq); }, 1, 1, 1 );
+    addScalable( "RooseKullaLombMeressoo215", []( integer neq ) -> nonlinearSystem * { return new RooseKullaLombMeressoo215(neq); }, 1, 2, 2 );
+    addScalable( "RooseKullaLombMeressoo216", []( integer neq ) -> nonlinearSystem * { return new RooseKullaLombMeressoo216(neq); }, 2, 2, 2 );
+    addScalable( "RooseKullaLombMeressoo217", []( integer neq ) -> nonlinearSystem * { return new RooseKullaLombMeressoo217(neq); }, 1, 1, 1 );
+    addScalable( "RooseKullaLombMeressoo218", []( integer neq ) -> nonlinearSystem * { return new RooseKullaLombMeressoo218(neq); }, 1, 1, 1 );
+    addScalable( "RooseKullaLombMeressoo219", []( integer neq ) -> nonlinearSystem * { return new RooseKullaLombMeressoo219(neq); }, 2, 2, 2 );
+    addScalable( "SchubertBroydenFunction", []( integer neq ) -> nonlinearSystem * { return new SchubertBroydenFunction(neq); }, 1, 1, 1 );
+    addScalable( "SingularFunction", []( integer neq ) -> nonlinearSystem * { return new SingularFunction(neq); }, 1, 1, 1 );
+    addScalable( "SpedicatoFunction17", []( integer neq ) -> nonlinearSystem * { return new SpedicatoFunction17(neq); }, 1, 1, 1 );
+    addScalable( "StrictlyConvexFunction1", []( integer neq ) -> nonlinearSystem * { return new StrictlyConvexFunction1(neq); }, 1, 1, 1 );
+    addScalable( "StrictlyConvexFunction2", []( integer neq ) -> nonlinearSystem * { return new StrictlyConvexFunction2(neq); }, 1, 1, 1 );
+    addScalable( "Toint225", []( integer neq ) -> nonlinearSystem * { return new Toint225(neq); }, 1, 1, 1 );
+    addScalable( "TrigExp", []( integer neq ) -> nonlinearSystem * { return new TrigExp(neq); }, 1, 1, 1 );
+    addScalable( "TrigonometricExponentialSystem1", []( integer neq ) -> nonlinearSystem * { return new TrigonometricExponentialSystem1(neq); }, 1, 1, 1 );
+    addScalable( "TrigonometricExponentialSystem2", []( integer neq ) -> nonlinearSystem * { return new TrigonometricExponentialSystem2(neq); }, 1, 1, 1 );
+    addScalable( "TrigonometricFunction", []( integer neq ) -> nonlinearSystem * { return new TrigonometricFunction(neq); }, 1, 2, 2 );
+    addScalable( "TroeschFunction", []( integer neq ) -> nonlinearSystem * { return new TroeschFunction(neq); }, 1, 1, 1 );
+    addScalable( "TwoPointBoundaryValueProblem", []( integer neq ) -> nonlinearSystem * { return new TwoPointBoundaryValueProblem(neq); }, 1, 1, 1 );
+    addScalable( "VariablyDimensionedFunction", []( integer neq ) -> nonlinearSystem * { return new VariablyDimensionedFunction(neq); }, 1, 2, 2 );
+    addScalable( "ZeroJacobianFunction", []( integer neq ) -> nonlinearSystem * { return new ZeroJacobianFunction(neq); }, 1, 1, 1 );
   }
 
 }
@@ -338,5 +338,33 @@ classdef NLtest < handle
       end
     end
 
+    %>
+    %> Counters of the evaluations (evalF, evalJF, pattern) of the active
+    %> nonlinear system and nanoseconds spent in them.
+    %> The counting is off by default, `'on'`, `'off'` and `'reset'`
+    %> control it.
+    %>
+    %> **Usage:**
+    %>
+    %> \rst
+    %>
+    %> .. code-block:: matlab
+    %>
+    %>    ref.stats( 'on' );
+    %>    ... % solve
+    %>    S = ref.stats(); % S.num_F, S.ns_F, S.num_J, ...
+    %>    ref.stats( 'reset' );
+    %>
+    %> \endrst
+    %>
+    function S = stats( self, varargin )
+      if nargin > 1
+        NLtestMexWrapper( 'stats', self.activetest, varargin{1} );
+        S = [];
+      else
+        S = NLtestMexWrapper( 'stats', self.activetest );
+      end
+    end
+
   end
 end
\ No newline at end of file
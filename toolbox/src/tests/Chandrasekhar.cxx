@@ -14,10 +14,11 @@
 
 class Chandrasekhar : public nonlinearSystem {
   dvec_t mu;
-  real_type const w;
+  real_type c;
+  real_type w; // c/(2n)
 public:
 
-  Chandrasekhar( real_type c, integer neq )
+  Chandrasekhar( real_type c_in, integer neq )
   : nonlinearSystem(
       "Chandrasekhar function",
       "@book{Kelley:1995,\n"
@@ -37,7 +38,8 @@ public:
       "}\n",
       neq
     )
-  , w(c/(2*neq))
+  , c(c_in)
+  , w(c_in/(2*neq))
   {
     mu.resize(neq);
     for ( integer i = 0; i < neq; ++i ) mu(i) = i + 0.5;
@@ -57,6 +59,35 @@ public:
       f(i) = evalFk(x,i);
   }
 
+  integer   numParams() const override { return 1; }
+  string    paramName( integer ) const override { return "c"; }
+  real_type getParam( integer ) const override { return c; }
+  void      setParam( integer, real_type v ) override { c = v; w = v/(2*n); }
+
+  void
+  dFdp( dvec_t const & x, integer, dvec_t & dfdp ) const override {
+    for ( integer i = 0; i < n; ++i ) {
+      real_type tmp = 0;
+      for ( integer j = 0; j < n; ++j )
+        tmp += mu(j)*x(j)/(mu(i)+mu(j));
+      dfdp(i) = -(tmp/(2*n))/power2(1-w*tmp);
+    }
+  }
+
+  bool
+  hasFixedPointForm() const override
+  { return true; }
+
+  void
+  fixedPointMap( dvec_t const & x, dvec_t & g ) const override {
+    for ( integer i = 0; i < n; ++i ) {
+      real_type tmp = 0;
+      for ( integer j = 0; j < n; ++j )
+        tmp += mu(j)*x(j)/(mu(i)+mu(j));
+      g(i) = 1/(1-w*tmp);
+    }
+  }
+
   integer
   jacobianNnz() const override
   { return n*n; }
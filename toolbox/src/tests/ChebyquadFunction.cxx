@@ -18,6 +18,8 @@ class ChebyquadFunction : public nonlinearSystem {
   mutable real_type dT[10];
 
 public:
+
+  bool isThreadSafe() const override { return false; }
   // Only the values N = 1, 2, 3, 4, 5, 6, 7 and 9 may be used.
   ChebyquadFunction( integer dim )
   : nonlinearSystem(
@@ -89,6 +89,46 @@ public:
          + (R5+x(1))*x(2)*x(2) + x(3)*x(3)-1 + R6*x(2);
   }
 
+  bool isPolynomial() const override { return true; }
+
+  void
+  polynomialForm( polynomialTerms & T ) const override {
+    addMonomial( T, 0, 1, {0,1} );
+    addMonomial( T, 0, 1, {0} );
+    addMonomial( T, 0, -3, {4} );
+
+    addMonomial( T, 1, 2, {0,1} );
+    addMonomial( T, 1, 1, {0} );
+    addMonomial( T, 1, 1, {1,2,2} );
+    addMonomial( T, 1, R8, {1} );
+    addMonomial( T, 1, -R, {4} );
+    addMonomial( T, 1, 2*R10, {1,1} );
+    addMonomial( T, 1, R7, {1,2} );
+    addMonomial( T, 1, R9, {1,3} );
+
+    addMonomial( T, 2, 2, {1,2,2} );
+    addMonomial( T, 2, 2*R5, {2,2} );
+    addMonomial( T, 2, -8, {4} );
+    addMonomial( T, 2, R6, {2} );
+    addMonomial( T, 2, R7, {1,2} );
+
+    addMonomial( T, 3, R9, {1,3} );
+    addMonomial( T, 3, 2, {3,3} );
+    addMonomial( T, 3, -4*R, {4} );
+
+    addMonomial( T, 4, 1, {0,1} );
+    addMonomial( T, 4, 1, {0} );
+    addMonomial( T, 4, R8, {1} );
+    addMonomial( T, 4, R10, {1,1} );
+    addMonomial( T, 4, R7, {1,2} );
+    addMonomial( T, 4, R9, {1,3} );
+    addMonomial( T, 4, R5, {2,2} );
+    addMonomial( T, 4, 1, {1,2,2} );
+    addMonomial( T, 4, 1, {3,3} );
+    addMonomial( T, 4, -1 );
+    addMonomial( T, 4, R6, {2} );
+  }
+
   integer
   jacobianNnz() const override {
     return 18;
@@ -62,6 +62,18 @@ public:
     f(1) = 200*(y-x3);
   }
 
+  bool isPolynomial() const override { return true; }
+
+  void
+  polynomialForm( polynomialTerms & T ) const override {
+    addMonomial( T, 0, 600, {0,0,0,0,0} );
+    addMonomial( T, 0, -600, {0,0,1} );
+    addMonomial( T, 0, 2, {0} );
+    addMonomial( T, 0, -2 );
+    addMonomial( T, 1, 200, {1} );
+    addMonomial( T, 1, -200, {0,0,0} );
+  }
+
   integer
   jacobianNnz() const override
   { return 4; }
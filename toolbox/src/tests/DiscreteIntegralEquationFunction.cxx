@@ -72,6 +72,30 @@ public:
     }
   }
 
+  bool
+  hasFixedPointForm() const override
+  { return true; }
+
+  // x = G(x) with the two partial sums accumulated in O(n)
+  void
+  fixedPointMap( dvec_t const & x, dvec_t & g ) const override {
+    real_type h = 1 / real_type ( n + 1 );
+
+    real_type sum2 = 0;
+    for ( integer j = n-1; j >= 0; --j ) {
+      real_type tj = (j+1) * h;
+      sum2 += (1-tj) * power3( x(j) + tj + 1 );
+      g(j) = sum2;
+    }
+    real_type sum1 = 0;
+    for ( integer k = 0; k < n; ++k ) {
+      real_type tk = (k+1) * h;
+      real_type s2 = g(k);
+      g(k) = -h * ( ( 1 - tk ) * sum1 + tk * s2 ) / 2;
+      sum1 += tk * power3( x(k) + tk + 1 );
+    }
+  }
+
   integer
   jacobianNnz() const override
   { return n*n; }
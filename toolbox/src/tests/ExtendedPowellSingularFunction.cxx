@@ -50,8 +50,9 @@ public:
   { checkFour(n,4); }
 
   real_type
-  evalFk( dvec_t const & x, integer i ) const override {
-    switch ( i % 4 ) {
+  evalFk( dvec_t const & x, integer k ) const override {
+    integer i = k - (k % 4); // first equation of the block
+    switch ( k % 4 ) {
       case 0: return x(i+0) + 10 * x(i+1);
       case 1: return sqrt5 * ( x(i+2) - x(i+3) );
       case 2: return power2( x(i+1) - 2 * x(i+2) );
@@ -29,8 +29,51 @@ class HAS64 : public nonlinearSystem {
   typedef pair<integer,integer> INDEX;
   mutable map<INDEX,real_type> jac_idx_vals;
   real_type tau;
+
+  // terms of F multiplied by tau, NaN where x(0), x(1) or x(2) <= 0
+  bool
+  tauTerms( dvec_t const & x, dvec_t & f ) const {
+    real_type x0 = x(0);
+    real_type x1 = x(1);
+    real_type x2 = x(2);
+    real_type x3 = x(3);
+    real_type x4 = x(4);
+    real_type x5 = x(5);
+    real_type x6 = x(6);
+    if ( x0 <= 0 || x1 <= 0 || x2 <= 0 ) {
+      f(0) = f(1) = f(2) = f(3) = f(4) = f(5) = f(6) = nan("HAS64");
+      return false;
+    }
+
+    real_type x0x0 = x0*x0;
+    real_type x1x1 = x1*x1;
+    real_type x2x2 = x2*x2;
+    real_type x3x3 = x3*x3;
+    real_type x4x4 = x4*x4;
+    real_type x5x5 = x5*x5;
+    real_type x6x6 = x6*x6;
+
+    f(0) = 2*(x0-x4x4)-2E-5;
+    f(1) = 2*(x1-x5x5)-2E-5;
+    f(2) = 2*(x2-x6x6)-2E-5;
+    f(3) = 0.0;
+    f(4) = 4*(x4x4-x0+1E-5)*x4;
+    f(5) = 4*(x5x5-x1+1E-5)*x5;
+    f(6) = 4*(x6x6-x2+1E-5)*x6;
+
+    real_type tmp = 1 - 4/x0 - 32/x1 - 120/x2 - x3x3;
+
+    f(0) += tmp*(8/x0x0);
+    f(1) += tmp*(64/x1x1);
+    f(2) += tmp*(240/x2x2);
+    f(3) -= 4*tmp*x3;
+    return true;
+  }
+
 public:
 
+  bool isThreadSafe() const override { return false; }
+
   HAS64( real_type tau_in)
   : nonlinearSystem(
       fmt::format( "HAS 64, tau = {}", tau_in ),
@@ -88,43 +131,14 @@ public:
 
   void
   evalF( dvec_t const & x, dvec_t & f ) const override {
-    real_type x0 = x(0);
-    real_type x1 = x(1);
-    real_type x2 = x(2);
-    real_type x3 = x(3);
-    real_type x4 = x(4);
-    real_type x5 = x(5);
-    real_type x6 = x(6);
-    if ( x0 <= 0 || x1 <= 0 || x2 <= 0 ) {
-      f(0) = f(1) = f(2) = f(3) = f(4) = f(5) = f(6) = nan("HAS64");
-      return;
-    }
-
-    real_type x0x0 = x0*x0;
-    real_type x1x1 = x1*x1;
-    real_type x2x2 = x2*x2;
-    real_type x3x3 = x3*x3;
-    real_type x4x4 = x4*x4;
-    real_type x5x5 = x5*x5;
-    real_type x6x6 = x6*x6;
-
-    f(0) = 2*(x0-x4x4)-2E-5;
-    f(1) = 2*(x1-x5x5)-2E-5;
-    f(2) = 2*(x2-x6x6)-2E-5;
-    f(3) = 0.0;
-    f(4) = 4*(x4x4-x0+1E-5)*x4;
-    f(5) = 4*(x5x5-x1+1E-5)*x5;
-    f(6) = 4*(x6x6-x2+1E-5)*x6;
-
-    real_type tmp = 1 - 4/x0 - 32/x1 - 120/x2 - x3x3;
-
-    f(0) += tmp*(8/x0x0);
-    f(1) += tmp*(64/x1x1);
-    f(2) += tmp*(240/x2x2);
-    f(3) -= 4*tmp*x3;
+    if ( !tauTerms( x, f ) ) return;
 
     f *= tau;
 
+    real_type x0x0 = x(0)*x(0);
+    real_type x1x1 = x(1)*x(1);
+    real_type x2x2 = x(2)*x(2);
+
     f(0) += 5;
     f(1) += 20;
     f(2) += 10;
@@ -134,6 +148,15 @@ public:
     f(2) -= 144000/x2x2;
   }
 
+  integer   numParams() const override { return 1; }
+  string    paramName( integer ) const override { return "tau"; }
+  real_type getParam( integer ) const override { return tau; }
+  void      setParam( integer, real_type v ) override { tau = v; }
+
+  void
+  dFdp( dvec_t const & x, integer, dvec_t & dfdp ) const override
+  { tauTerms( x, dfdp ); }
+
   integer
   jacobianNnz() const override
   { return integer(jac_idx_vals.size()); }
@@ -277,6 +300,18 @@ public:
     // UTILS_ASSERT( x(6) < 0, "Bad range" );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 0, 3, above(0), real_inf );
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 0, 3, above(0), real_inf );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     U.fill(real_max);
@@ -292,6 +327,43 @@ public:
 
 class HAS93 : public nonlinearSystem {
   real_type tau;
+
+  // terms of F multiplied by tau
+  void
+  tauTerms( dvec_t const & x, dvec_t & f ) const {
+    real_type t4 = x(3)*x(4)*x(5);
+    real_type t7 = x(6)*x(6);
+    real_type t8 = 0.1E-2*x(0)*x(1)*x(2)*t4-0.207E1-t7;
+    real_type t13 = x(0)*x(3);
+    real_type t14 = x(4)*x(4);
+    real_type t15 = x(0)+x(1)+x(2);
+    real_type t19 = x(1)*x(2);
+    real_type t20 = x(5)*x(5);
+    real_type t22 = x(0)+0.157E1*x(1)+x(3);
+    real_type t26 = x(7)*x(7);
+    real_type t27 = 1.0-0.62E-3*t13*t14*t15-0.58E-3*t19*t20*t22-t26;
+    real_type t32 = 0.62E-3*t13*t14;
+    real_type t33 = t19*t20;
+    real_type t34 = 0.58E-3*t33;
+    real_type t41 = t8*x(0);
+    real_type t55 = t41*x(1);
+    real_type t80 = x(2)*x(3);
+    f(0)  = 0.2E-2*t8*x(1)*x(2)*t4+2.0*t27*(-0.62E-3*x(3)*t14*t15-t32-t34)+2.0*x(0)-2.0*x(8);
+    f(1)  = 0.2E-2*t41*x(2)*t4+2.0*t27*(-t32-0.58E-3*x(2)*t20*t22-0.9106E-3*t33)+2.0*x(1)-2.0*x(9);
+    f(2)  = 0.2E-2*t55*t4+2.0*t27*(-t32-0.58E-3*x(1)*t20*t22)+2.0*x(2)-2.0*x(10);
+    f(3)  = 0.2E-2*t55*x(2)*x(4)*x(5)+2.0*t27*(-0.62E-3*x(0)*t14*t15-t34)+2.0*x(3)-2.0*x(11);
+    f(4)  = 0.2E-2*t55*t80*x(5)-0.248E-2*t27*x(0)*x(3)*t15*x(4)+2.0*x(4)-2.0*x(12);
+    f(5)  = 0.2E-2*t55*t80*x(4)-0.232E-2*t27*x(1)*x(2)*t22*x(5)+2.0*x(5)-2.0*x(13);
+    f(6)  = -4.0*t8*x(6);
+    f(7)  = -4.0*t27*x(7);
+    f(8)  = -2.0*x(0)+2.0*x(8);
+    f(9)  = -2.0*x(1)+2.0*x(9);
+    f(10) = -2.0*x(2)+2.0*x(10);
+    f(11) = -2.0*x(3)+2.0*x(11);
+    f(12) = -2.0*x(4)+2.0*x(12);
+    f(13) = -2.0*x(5)+2.0*x(13);
+  }
+
 public:
 
   HAS93( real_type tau_in)
@@ -312,39 +384,7 @@ public:
 
   void
   evalF( dvec_t const & x, dvec_t & f ) const override {
-   {
-      real_type t4 = x(3)*x(4)*x(5);
-      real_type t7 = x(6)*x(6);
-      real_type t8 = 0.1E-2*x(0)*x(1)*x(2)*t4-0.207E1-t7;
-      real_type t13 = x(0)*x(3);
-      real_type t14 = x(4)*x(4);
-      real_type t15 = x(0)+x(1)+x(2);
-      real_type t19 = x(1)*x(2);
-      real_type t20 = x(5)*x(5);
-      real_type t22 = x(0)+0.157E1*x(1)+x(3);
-      real_type t26 = x(7)*x(7);
-      real_type t27 = 1.0-0.62E-3*t13*t14*t15-0.58E-3*t19*t20*t22-t26;
-      real_type t32 = 0.62E-3*t13*t14;
-      real_type t33 = t19*t20;
-      real_type t34 = 0.58E-3*t33;
-      real_type t41 = t8*x(0);
-      real_type t55 = t41*x(1);
-      real_type t80 = x(2)*x(3);
-      f(0)  = 0.2E-2*t8*x(1)*x(2)*t4+2.0*t27*(-0.62E-3*x(3)*t14*t15-t32-t34)+2.0*x(0)-2.0*x(8);
-      f(1)  = 0.2E-2*t41*x(2)*t4+2.0*t27*(-t32-0.58E-3*x(2)*t20*t22-0.9106E-3*t33)+2.0*x(1)-2.0*x(9);
-      f(2)  = 0.2E-2*t55*t4+2.0*t27*(-t32-0.58E-3*x(1)*t20*t22)+2.0*x(2)-2.0*x(10);
-      f(3)  = 0.2E-2*t55*x(2)*x(4)*x(5)+2.0*t27*(-0.62E-3*x(0)*t14*t15-t34)+2.0*x(3)-2.0*x(11);
-      f(4)  = 0.2E-2*t55*t80*x(5)-0.248E-2*t27*x(0)*x(3)*t15*x(4)+2.0*x(4)-2.0*x(12);
-      f(5)  = 0.2E-2*t55*t80*x(4)-0.232E-2*t27*x(1)*x(2)*t22*x(5)+2.0*x(5)-2.0*x(13);
-      f(6)  = -4.0*t8*x(6);
-      f(7)  = -4.0*t27*x(7);
-      f(8)  = -2.0*x(0)+2.0*x(8);
-      f(9)  = -2.0*x(1)+2.0*x(9);
-      f(10) = -2.0*x(2)+2.0*x(10);
-      f(11) = -2.0*x(3)+2.0*x(11);
-      f(12) = -2.0*x(4)+2.0*x(12);
-      f(13) = -2.0*x(5)+2.0*x(13);
-    }
+    tauTerms( x, f );
 
     for ( integer i = 0; i < n; ++i ) f(i) *= tau;
 
@@ -366,6 +406,15 @@ public:
     f(5) += 0.874E-1*t13*t36*x(5);
   }
 
+  integer   numParams() const override { return 1; }
+  string    paramName( integer ) const override { return "tau"; }
+  real_type getParam( integer ) const override { return tau; }
+  void      setParam( integer, real_type v ) override { tau = v; }
+
+  void
+  dFdp( dvec_t const & x, integer, dvec_t & dfdp ) const override
+  { tauTerms( x, dfdp ); }
+
   integer
   jacobianNnz() const override
   { return n*n; }
@@ -285,6 +285,37 @@ public:
            a17_3;
   }
 
+  bool isPolynomial() const override { return true; }
+
+  void
+  polynomialForm( polynomialTerms & T ) const override {
+    for ( integer k = 0; k < 4; ++k ) {
+      addMonomial( T, k, 1, {k,k} );
+      addMonomial( T, k, 1, {k+1,k+1} );
+      addMonomial( T, k, -1 );
+    }
+    real_type const a[4][17] = {
+      { a1_0, a2_0, a3_0, a4_0, a5_0, a6_0, a7_0, a8_0, a9_0,
+        a10_0, a11_0, a12_0, a13_0, a14_0, a15_0, a16_0, a17_0 },
+      { a1_1, a2_1, a3_1, a4_1, a5_1, a6_1, a7_1, a8_1, a9_1,
+        a10_1, a11_1, a12_1, a13_1, a14_1, a15_1, a16_1, a17_1 },
+      { a1_2, a2_2, a3_2, a4_2, a5_2, a6_2, a7_2, a8_2, a9_2,
+        a10_2, a11_2, a12_2, a13_2, a14_2, a15_2, a16_2, a17_2 },
+      { a1_3, a2_3, a3_3, a4_3, a5_3, a6_3, a7_3, a8_3, a9_3,
+        a10_3, a11_3, a12_3, a13_3, a14_3, a15_3, a16_3, a17_3 }
+    };
+    integer const v[8][2] = {
+      {0,1}, {0,3}, {1,2}, {1,3}, {1,6}, {4,7}, {5,6}, {5,7}
+    };
+    for ( integer k = 0; k < 4; ++k ) {
+      for ( integer j = 0; j < 8; ++j )
+        addMonomial( T, k+4, a[k][j], { v[j][0], v[j][1] } );
+      for ( integer j = 0; j < 8; ++j )
+        addMonomial( T, k+4, a[k][j+8], {j} );
+      addMonomial( T, k+4, a[k][16] );
+    }
+  }
+
   integer
   jacobianNnz() const override {
     return 40;
@@ -431,6 +462,18 @@ public:
       UTILS_ASSERT0( abs(x(i)) < 1000, "Bad range" );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 0, n, above(-1000), below(1000) );
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 0, n, above(-1000), below(1000) );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     U.fill(1000);
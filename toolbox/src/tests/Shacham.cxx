@@ -82,6 +82,8 @@ class ChemicalReactorEquilibriumConversion : public nonlinearSystem {
 
 public:
 
+  bool isThreadSafe() const override { return false; }
+
   ChemicalReactorEquilibriumConversion()
   : nonlinearSystem("Chemical Reactor Equilibrium Conversion",SHACHAM_BIBTEX,2)
   { }
@@ -202,6 +204,22 @@ public:
     );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    real_type _T = x(0);
+    real_type _y = x(1);
+    which = -1;
+    if      ( !( _T > 0  ) ) which = 0;
+    else if ( !( _y <= 1 ) ) which = 1;
+    if ( which >= 0 ) return POINT_OUT_OF_BOUNDS;
+    // constraint 0: k1 <= 350, constraint 1: k2 <= 350
+    real_type k1 = 92.5 - 149750.0/_T;
+    real_type k2 = 116.7 - 192050.0/_T - 0.17*log(_T);
+    if      ( !( k1 <= 350 ) ) which = 0;
+    else if ( !( k2 <= 350 ) ) which = 1;
+    return which < 0 ? POINT_ADMISSIBLE : POINT_CONSTRAINT;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     L[0] = 100;       U[0] = 20000;
@@ -236,6 +254,8 @@ class ChemicalReactorSteadyState : public nonlinearSystem {
 
 public:
 
+  bool isThreadSafe() const override { return false; }
+
   ChemicalReactorSteadyState()
   : nonlinearSystem("Chemical Reactor Steady State",SHACHAM_BIBTEX,2) {}
 
@@ -323,6 +343,21 @@ public:
     UTILS_ASSERT0( _T >= 298.0, "bad point2");
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = -1;
+    if      ( !( x(0) >= 0     ) ) which = 0;
+    else if ( !( x(1) >= 298.0 ) ) which = 1;
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 0, 1, 0,     real_inf );
+    clampTo( x, 1, 2, 298.0, real_inf );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     U[0] = real_max; L[0] = 0;
@@ -521,6 +556,20 @@ public:
       );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 0, n, above(-20), below(20) );
+    if ( which != 0 && !( x(0) > 0 ) ) which = 0;
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 0, n, above(-20), below(20) );
+    clampTo( x, 0, 1, above(0),   below(20) );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     U.fill(20);
@@ -954,6 +1003,17 @@ public:
     UTILS_ASSERT0( s    >= 0, "Bad range" );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 0, 4, 0, real_inf );
+    if ( which >= 0 ) return POINT_OUT_OF_BOUNDS;
+    // constraint 0: the sum of the components is not negative
+    real_type s = x(0)+x(1)+x(2)+x(3)+x(4)+x(5)+x(6)+x(7)+x(8)+x(9);
+    if ( s >= 0 ) return POINT_ADMISSIBLE;
+    which = 0;
+    return POINT_CONSTRAINT;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     for ( integer i = 0; i < n; ++i )
@@ -1055,6 +1115,18 @@ public:
     );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 0, 1, 0, below(0.8) );
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 0, 1, 0, below(0.8) );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     U[0] = 0.8; L[0] = 0;
@@ -1172,6 +1244,18 @@ public:
     );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 1, 3, above(0), real_inf );
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 1, 3, above(0), real_inf );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     U.fill(real_max);
@@ -1388,6 +1472,18 @@ public:
     UTILS_ASSERT0( x(6) > 0, "Bad range" );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 6, 7, above(0), real_inf );
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 6, 7, above(0), real_inf );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     U.fill(real_max);
@@ -1618,6 +1714,18 @@ public:
     UTILS_ASSERT0( x(6) > 0, "Bad range" );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 6, 7, above(0), real_inf );
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 6, 7, above(0), real_inf );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     U.fill(real_max);
@@ -2010,6 +2118,21 @@ public:
     //ASSERT( rB < 0, "T non positive" );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    for ( integer i : { 0, 2, 3, 4, 5, 6, 12, 13, 14 } )
+      if ( firstOutside( x, i, i+1, above(0), real_inf ) >= 0 )
+        { which = i; return POINT_OUT_OF_BOUNDS; }
+    which = -1;
+    return POINT_ADMISSIBLE;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    for ( integer i : { 0, 2, 3, 4, 5, 6, 12, 13, 14 } ) clampTo( x, i, i+1, above(0), real_inf );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     U.fill(real_max);
@@ -2375,6 +2498,18 @@ public:
     UTILS_ASSERT0( x(2) >= 0, "Bad range" );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 0, 3, 0, real_inf );
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 0, 3, 0, real_inf );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     U.fill(real_max);
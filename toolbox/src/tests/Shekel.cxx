@@ -61,8 +61,8 @@ public:
       for ( integer j = 0; j < 5; ++j ) {
         real_type d = c[j];
         for ( integer i = 0; i < n; ++i )
-          d += power2(x(i) - a[i][j]);
-        f(k) += 2.0 * ( x(k) - a[k][j] ) / (d*d);
+          d += power2(x(i) - a[j][i]);
+        f(k) += 2.0 * ( x(k) - a[j][k] ) / (d*d);
       }
     }
   }
@@ -86,8 +86,8 @@ public:
       for ( integer jj = 0; jj < n; ++jj ) {
         for ( integer j = 0; j < 5; ++j ) {
           real_type d = c[j];
-          for ( integer i = 0; i < n; ++i ) d += power2(x(i) - a[i][j]);
-          jac[caddr(ii,jj)] -= 8.0 * ((x[ii] - a[ii][j]) * (x[jj] - a[jj][j])) / (d*d*d);
+          for ( integer i = 0; i < n; ++i ) d += power2(x(i) - a[j][i]);
+          jac[caddr(ii,jj)] -= 8.0 * ((x[ii] - a[j][ii]) * (x[jj] - a[j][jj])) / (d*d*d);
           if ( ii == jj ) jac[caddr(ii,jj)] += 2 / (d*d);
         }
       }
@@ -171,8 +171,8 @@ public:
       for ( integer j = 0; j < 7; ++j ) {
         real_type d = c[j];
         for ( integer i = 0; i < n; ++i )
-          d += power2(x(i) - a[i][j]);
-        f(k) += 2.0 * ( x(k) - a[k][j] ) / (d*d);
+          d += power2(x(i) - a[j][i]);
+        f(k) += 2.0 * ( x(k) - a[j][k] ) / (d*d);
       }
     }
   }
@@ -196,8 +196,8 @@ public:
       for ( integer jj = 0; jj < n; ++jj ) {
         for ( integer j = 0; j < 7; ++j ) {
           real_type d = c[j];
-          for ( integer i = 0; i < n; ++i ) d += power2(x(i) - a[i][j]);
-          jac[caddr(ii,jj)] -= 8.0 * ((x[ii] - a[ii][j]) * (x[jj] - a[jj][j])) / (d*d*d);
+          for ( integer i = 0; i < n; ++i ) d += power2(x(i) - a[j][i]);
+          jac[caddr(ii,jj)] -= 8.0 * ((x[ii] - a[j][ii]) * (x[jj] - a[j][jj])) / (d*d*d);
           if ( ii == jj ) jac[caddr(ii,jj)] += 2 / (d*d);
         }
       }
@@ -287,8 +287,8 @@ public:
       for ( integer j = 0; j < 10; ++j ) {
         real_type d = c[j];
         for ( integer i = 0; i < n; ++i )
-          d += power2(x(i) - a[i][j]);
-        f(k) += 2.0 * ( x(k) - a[k][j] ) / (d*d);
+          d += power2(x(i) - a[j][i]);
+        f(k) += 2.0 * ( x(k) - a[j][k] ) / (d*d);
       }
     }
   }
@@ -312,8 +312,8 @@ public:
       for ( integer jj = 0; jj < n; ++jj ) {
         for ( integer j = 0; j < 10; ++j ) {
           real_type d = c[j];
-          for ( integer i = 0; i < n; ++i ) d += power2(x(i) - a[i][j]);
-          jac[caddr(ii,jj)] -= 8.0 * ((x[ii] - a[ii][j]) * (x[jj] - a[jj][j])) / (d*d*d);
+          for ( integer i = 0; i < n; ++i ) d += power2(x(i) - a[j][i]);
+          jac[caddr(ii,jj)] -= 8.0 * ((x[ii] - a[j][ii]) * (x[jj] - a[j][jj])) / (d*d*d);
           if ( ii == jj ) jac[caddr(ii,jj)] += 2 / (d*d);
         }
       }
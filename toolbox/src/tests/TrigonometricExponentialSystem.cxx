@@ -108,6 +108,18 @@ public:
       UTILS_ASSERT0( abs(x(i)) < 100, "Bad range" );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 0, n, above(-100), below(100) );
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 0, n, above(-100), below(100) );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     U.fill(100);
@@ -133,9 +145,20 @@ public:
 
   real_type
   evalFk( dvec_t const & x, integer i ) const override {
-    dvec_t f(n);
-    evalF( x, f );
-    return f(i);
+    if ( i == 0 )
+      return 3*power3(x(0)-x(2))
+           + 2*x(1)-5
+           + sin( x(0)-x(1)-x(2) )*sin( x(0)+x(1)-x(2) );
+    if ( i == n-1 )
+      return - 6*power3(x(n-1)-x(n-3))
+             - 4*x(n-2) + 10
+             - 2*sin( x(n-3)-x(n-2)-x(n-1) )*sin( x(n-3)+x(n-2)-x(n-1) );
+    if ( (i % 2) == 1 )
+      return (x(i+1)-x(i-1))*exp(x(i-1)-x(i)-x(i+1))+4*x(i) - 3;
+    return 3*power3(x(i)-x(i+2)) + 6*power3(x(i)-x(i-2)) +
+           2*x(i+1)-4*x(i-1)+5
+           -2*sin( x(i-2)-x(i-1)-x(i) )*sin( x(i-2)+x(i-1)-x(i) )
+           +sin( x(i)-x(i+1)-x(i+2) )*sin( x(i)+x(i+1)-x(i+2) );
   }
 
   void
@@ -250,6 +273,18 @@ public:
       UTILS_ASSERT0( abs(x(i)) < 100, "Bad range" );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 0, n, above(-100), below(100) );
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 0, n, above(-100), below(100) );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     U.fill(100);
@@ -378,6 +413,18 @@ public:
       UTILS_ASSERT0( abs(x(i)) < 1000, "Bad range" );
   }
 
+  admissibleStatus
+  isAdmissible( dvec_t const & x, integer & which ) const noexcept override {
+    which = firstOutside( x, 0, n, above(-1000), below(1000) );
+    return which < 0 ? POINT_ADMISSIBLE : POINT_OUT_OF_BOUNDS;
+  }
+
+  bool
+  projectToDomain( dvec_t & x ) const noexcept override {
+    clampTo( x, 0, n, above(-1000), below(1000) );
+    return true;
+  }
+
   void
   boundingBox( dvec_t & L, dvec_t & U ) const override {
     U.fill(1000);
@@ -16,6 +16,8 @@
 class VariablyDimensionedFunction : public nonlinearSystem {
   mutable dvec_t gf2;
 public:
+
+  bool isThreadSafe() const override { return false; }
   
   VariablyDimensionedFunction( integer neq )
   : nonlinearSystem(
@@ -47,8 +47,13 @@
 #include <vector>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <cmath>
 #include <map>
+#include <initializer_list>
+#include <atomic>
+#include <chrono>
+#include <mutex>
 
 #define DEBUG 1
 #define EIGEN_NO_AUTOMATIC_RESIZING 1
@@ -107,11 +112,84 @@ namespace NLproblem {
   static real_type const m_1_sqrt2 = 0.7071067811865475244008443621048490392850;
 
   static real_type real_max = numeric_limits<real_type>::max();
+  static real_type const real_inf = numeric_limits<real_type>::infinity();
 
   typedef Eigen::Matrix<real_type,Eigen::Dynamic,Eigen::Dynamic> dmat_t;
   typedef Eigen::Matrix<real_type,Eigen::Dynamic,1>              dvec_t;
   typedef Eigen::Matrix<integer,Eigen::Dynamic,1>               ivec_t;
 
+  //!
+  //! Monomial \f$ c\, x_{v_0} x_{v_1} \cdots \f$ of the equation `eq`:
+  //! repeated indices give the powers, `var` empty is a constant.
+  //!
+  struct polynomialTerm {
+    integer         eq;
+    real_type       coeff;
+    vector<integer> var;
+  };
+
+  typedef vector<polynomialTerm> polynomialTerms;
+
+  inline
+  void
+  addMonomial(
+    polynomialTerms                & terms,
+    integer                          eq,
+    real_type                        coeff,
+    std::initializer_list<integer>   var = {}
+  ) {
+    polynomialTerm t;
+    t.eq    = eq;
+    t.coeff = coeff;
+    t.var.assign( var.begin(), var.end() );
+    terms.push_back( t );
+  }
+
+  //! outcome of `isAdmissible`
+  typedef enum {
+    POINT_ADMISSIBLE = 0,
+    POINT_OUT_OF_BOUNDS,   //!< `which` is the first component out of its bounds
+    POINT_CONSTRAINT,      //!< `which` is the first violated constraint of the problem
+    POINT_NOT_ADMISSIBLE   //!< rejected by `checkIfAdmissible`, `which` is -1
+  } admissibleStatus;
+
+  //!
+  //! 1 if `v` is inf or NaN (exponent bits all ones), 0 otherwise.
+  //! Only integer and, add and shift: `~bits & expo` is zero just for
+  //! the non finite values and adding `2^63-1` sets the sign bit of all
+  //! the others, so the loops on it vectorise also without 64 bit
+  //! compares (SSE2).
+  //!
+  inline
+  uint64_t
+  nonFiniteBit( real_type v ) noexcept {
+    uint64_t const expo = 0x7ff0000000000000ULL;
+    uint64_t       bits;
+    std::memcpy( &bits, &v, sizeof(bits) );
+    return ( ( ( ~bits & expo ) + 0x7fffffffffffffffULL ) >> 63 ) ^ 1;
+  }
+
+  //!
+  //! Index of the first non finite entry of `v[0..n)`, -1 if all are
+  //! finite. The entries are tested by one loop on the exponent bits
+  //! without branches that the compiler vectorises, the index is
+  //! searched only when the test fails.
+  //!
+  inline
+  integer
+  firstNonFinite( real_type const v[], integer n ) noexcept {
+    uint64_t bad = 0;
+    for ( integer i = 0; i < n; ++i ) bad |= nonFiniteBit( v[i] );
+    if ( bad == 0 ) return -1;
+    for ( integer i = 0; i < n; ++i ) if ( nonFiniteBit( v[i] ) ) return i;
+    return -1;
+  }
+
+  inline
+  integer
+  firstNonFinite( dvec_t const & v ) noexcept
+  { return firstNonFinite( v.data(), integer(v.size()) ); }
+
   class nonlinearBase {
 
     string const _title;
@@ -166,6 +244,56 @@ namespace NLproblem {
       );
     }
 
+    // D O M A I N  C H E C K S ------------------------------------------------
+
+    //! next `real_type` after `a`, `x > a` is `x >= above(a)`
+    static real_type above( real_type a ) noexcept
+    { return std::nextafter( a, real_inf ); }
+
+    //! previous `real_type` before `a`, `x < a` is `x <= below(a)`
+    static real_type below( real_type a ) noexcept
+    { return std::nextafter( a, -real_inf ); }
+
+    //!
+    //! First `i` in `[i0,i1)` with `x(i)` not in `[lo,hi]` (NaN are
+    //! outside), -1 if none. The range is tested by a loop without
+    //! branches that the compiler vectorises (64 bit compares, from
+    //! SSE4.2), the index is searched only when the test fails.
+    //!
+    static
+    integer
+    firstOutside(
+      dvec_t const & x,
+      integer        i0,
+      integer        i1,
+      real_type      lo,
+      real_type      hi
+    ) noexcept {
+      real_type const * px = x.data();
+      uint64_t bad = 0; // no && in the loop, it would not vectorise
+      for ( integer i = i0; i < i1; ++i )
+        bad |= uint64_t( !( px[i] >= lo ) ) | uint64_t( !( px[i] <= hi ) );
+      if ( bad == 0 ) return -1;
+      for ( integer i = i0; i < i1; ++i )
+        if ( !( px[i] >= lo && px[i] <= hi ) ) return i;
+      return -1;
+    }
+
+    //! clamp `x(i)`, `i` in `[i0,i1)`, to `[lo,hi]`, NaN are moved to `lo`
+    static
+    void
+    clampTo(
+      dvec_t  & x,
+      integer   i0,
+      integer   i1,
+      real_type lo,
+      real_type hi
+    ) noexcept {
+      real_type * px = x.data();
+      for ( integer i = i0; i < i1; ++i )
+        px[i] = px[i] <= hi ? ( px[i] >= lo ? px[i] : lo ) : ( px[i] > hi ? hi : lo );
+    }
+
   public:
 
     explicit nonlinearBase( string const & t, string const & b )
@@ -261,6 +389,10 @@ namespace NLproblem {
     virtual void    jacobian( dvec_t const & x, dvec_t & jac ) const = 0;
     virtual void    jacobianPattern( ivec_t & i, ivec_t & j ) const = 0;
 
+    //!
+    //! Values of \f$ \sum_k \lambda_k \nabla^2 F_k(x) \f$, only the
+    //! lower triangular part \f$ i \geq j \f$ is stored in the pattern.
+    //!
     virtual integer tensorNnz() const = 0;
     virtual void    tensor( dvec_t const & x, dvec_t const & lambda, dvec_t & jac ) const = 0;
     virtual void    tensorPattern( ivec_t & i, ivec_t & j ) const = 0;
@@ -279,6 +411,48 @@ namespace NLproblem {
       U.fill( real_max );
     }
 
+    //!
+    //! Check of the domain without exceptions, for the hot paths of the
+    //! line searches: `POINT_ADMISSIBLE` or how `x` is rejected, with
+    //! the first violated component or constraint in `which`.
+    //! The default calls `checkIfAdmissible` and catches, the problems
+    //! with a domain override it (same accepted points).
+    //!
+    virtual
+    admissibleStatus
+    isAdmissible( dvec_t const & x, integer & which ) const noexcept;
+
+    //!
+    //! Move `x` to the nearest admissible point (componentwise for the
+    //! bounds), `false` and `x` untouched if the problem has no
+    //! projection.
+    //!
+    virtual bool projectToDomain( dvec_t & ) const noexcept { return false; }
+
+    //!
+    //! `evalF` with the check of `f` done while it is still in cache:
+    //! -1 if all the entries are finite, otherwise the index of the
+    //! first inf or NaN, so that a line search can back off at once.
+    //!
+    integer
+    safeEvalF( dvec_t const & x, dvec_t & f ) const
+    { evalF( x, f ); return firstNonFinite( f.data(), n ); }
+
+    //! `jacobian` with the check of the values, as `safeEvalF`
+    integer
+    safeJacobian( dvec_t const & x, dvec_t & jac ) const
+    { jacobian( x, jac ); return firstNonFinite( jac.data(), jacobianNnz() ); }
+
+    //!
+    //! Parameters of a family of problems, as for `nonlinearSystem`,
+    //! `dFdp` has `dimF()` entries.
+    //!
+    virtual integer   numParams() const { return 0; }
+    virtual string    paramName( integer k ) const;
+    virtual real_type getParam( integer k ) const;
+    virtual void      setParam( integer k, real_type value );
+    virtual void      dFdp( dvec_t const & x, integer k, dvec_t & dfdp ) const;
+
     integer dimF( void ) const { return n; }
     integer dimX( void ) const { return m; }
 
@@ -308,6 +482,13 @@ namespace NLproblem {
 
     integer n;
 
+    //! same title, bibtex and size of `P` (for the wrappers)
+    explicit
+    nonlinearSystem( nonlinearSystem const * P )
+    : nonlinearBase( P->title(), P->bibtex() )
+    , n(P->numEqns())
+    { }
+
   public:
 
     nonlinearSystem( string const & t, string const & b, integer _n )
@@ -342,6 +523,102 @@ namespace NLproblem {
       U.fill( real_max );
     }
 
+    //!
+    //! Check of the domain without exceptions, for the hot paths of the
+    //! line searches: `POINT_ADMISSIBLE` or how `x` is rejected, with
+    //! the first violated component or constraint in `which`.
+    //! The default calls `checkIfAdmissible` and catches, the problems
+    //! with a domain override it (same accepted points).
+    //!
+    virtual
+    admissibleStatus
+    isAdmissible( dvec_t const & x, integer & which ) const noexcept;
+
+    //!
+    //! Move `x` to the nearest admissible point (componentwise for the
+    //! bounds), `false` and `x` untouched if the problem has no
+    //! projection.
+    //!
+    virtual bool projectToDomain( dvec_t & ) const noexcept { return false; }
+
+    //!
+    //! `evalF` with the check of `f` done while it is still in cache:
+    //! -1 if all the entries are finite, otherwise the index of the
+    //! first inf or NaN, so that a line search can back off at once.
+    //!
+    integer
+    safeEvalF( dvec_t const & x, dvec_t & f ) const
+    { evalF( x, f ); return firstNonFinite( f.data(), n ); }
+
+    //! `jacobian` with the check of the values, as `safeEvalF`
+    integer
+    safeJacobian( dvec_t const & x, dvec_t & jac ) const
+    { jacobian( x, jac ); return firstNonFinite( jac.data(), jacobianNnz() ); }
+
+    //!
+    //! `true` if the problem overrides `fixedPointMap` with its
+    //! native fixed point form \f$ x = G(x) \f$.
+    //!
+    virtual bool hasFixedPointForm() const { return false; }
+
+    //!
+    //! Fixed point map \f$ G(x) \f$ whose fixed points are the roots
+    //! of \f$ F \f$, default \f$ G(x) = x - F(x) \f$.
+    //!
+    virtual
+    void
+    fixedPointMap( dvec_t const & x, dvec_t & g ) const {
+      evalF( x, g );
+      g = x - g;
+    }
+
+    //!
+    //! `false` if the evaluation routines share mutable workspaces:
+    //! the instance cannot be evaluated by several threads at once.
+    //!
+    virtual bool isThreadSafe() const { return true; }
+
+    //!
+    //! `true` if \f$ F \f$ is polynomial and the problem overrides
+    //! `polynomialForm`.
+    //!
+    virtual bool isPolynomial() const { return false; }
+
+    //!
+    //! Monomials of \f$ F \f$, the sum of the terms of equation `k`
+    //! is \f$ F_k(x) \f$ also for complex \f$ x \f$.
+    //!
+    virtual
+    void
+    polynomialForm( polynomialTerms & ) const {
+      UTILS_ERROR( "polynomialForm, `{}` is not polynomial\n", title() );
+    }
+
+    //! total degree of each equation, from `polynomialForm`
+    void polynomialDegrees( ivec_t & deg ) const;
+
+    //!
+    //! Parameters of a family of problems (`HAS64(tau)`,
+    //! `Chandrasekhar(c,n)`, ...): an instance is moved along its family
+    //! in place with `setParam` (see `ContinuationDriver`), no new
+    //! instance is built. The title keeps the values given to the
+    //! constructor. A parameter must not be changed while other threads
+    //! evaluate the instance.
+    //!
+    virtual integer numParams() const { return 0; }
+
+    //! name of the parameter `k`, \f$ 0 \leq k < \f$ `numParams()`
+    virtual string paramName( integer k ) const;
+
+    //! value of the parameter `k`
+    virtual real_type getParam( integer k ) const;
+
+    //! change the parameter `k`
+    virtual void setParam( integer k, real_type value );
+
+    //! \f$ \partial F / \partial p_k \f$ at `x`
+    virtual void dFdp( dvec_t const & x, integer k, dvec_t & dfdp ) const;
+
     integer numEqns( void ) const { return n; }
 
     integer
@@ -446,7 +723,12 @@ namespace NLproblem {
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-#if 0
+  //!
+  //! First order conditions \f$ J(x)^T F(x) = 0 \f$ of a least squares
+  //! problem as a square system. The jacobian of the system is
+  //! \f$ J^T J + \sum_k F_k \nabla^2 F_k \f$, the second term
+  //! comes from `tensor` with \f$ \lambda = F(x) \f$.
+  //!
   class nonlinearSystemFromLeastSquares: public nonlinearSystem {
 
     nonlinearSystemFromLeastSquares(nonlinearSystemFromLeastSquares const &);
@@ -454,13 +736,21 @@ namespace NLproblem {
     operator = (nonlinearSystemFromLeastSquares const &);
 
     nonlinearLeastSquares const * pLS;
+    nonlinearLeastSquares       * pLSmutable; // nullptr if built on a const problem
+
+    ivec_t m_JI, m_JJ;     // pattern of the jacobian of pLS
+    ivec_t m_TI, m_TJ;     // pattern of the tensor of pLS
+    ivec_t m_I, m_J;       // pattern of the system jacobian
+    ivec_t m_pair;         // triples (k1,k2,pos) for the products J_k1 J_k2
+    ivec_t m_tpos1, m_tpos2; // positions of the tensor entries (and transposed)
 
   public:
 
-    nonlinearSystemFromLeastSquares( nonlinearLeastSquares const * _pLS )
-    : nonlinearSystem( _pLS->title(), _pLS->dimX() )
-    , pLS(_pLS) {
-    }
+    explicit
+    nonlinearSystemFromLeastSquares( nonlinearLeastSquares const * _pLS );
+
+    explicit
+    nonlinearSystemFromLeastSquares( nonlinearLeastSquares * _pLS );
 
     virtual ~nonlinearSystemFromLeastSquares() {}
 
@@ -474,64 +764,639 @@ namespace NLproblem {
 
     virtual
     void
-    evalF( dvec_t const & x, dvec_t & g ) const {
-      pLS->gradient( x, g );
+    evalF( dvec_t const & x, dvec_t & g ) const;
+
+    virtual
+    integer
+    jacobianNnz() const
+    { return integer(m_I.size()); }
+
+    virtual
+    void
+    jacobian( dvec_t const & x, dvec_t & jac ) const;
+
+    virtual
+    void
+    jacobianPattern( ivec_t & i, ivec_t & j ) const
+    { i = m_I; j = m_J; }
+
+    virtual
+    integer
+    numExactSolution() const
+    { return pLS->numExactSolution(); }
+
+    virtual
+    void
+    getExactSolution( dvec_t & x, integer idx ) const
+    { pLS->getExactSolution( x, idx ); }
+
+    virtual
+    integer
+    numInitialPoint() const
+    { return pLS->numInitialPoint(); }
+
+    virtual
+    void
+    getInitialPoint( dvec_t & x, integer idx ) const
+    { pLS->getInitialPoint( x, idx ); }
+
+    virtual
+    void
+    checkIfAdmissible( dvec_t const & x ) const
+    { pLS->checkIfAdmissible( x ); }
+
+    virtual
+    void
+    boundingBox( dvec_t & L, dvec_t & U ) const
+    { pLS->boundingBox( L, U ); }
+
+    virtual
+    admissibleStatus
+    isAdmissible( dvec_t const & x, integer & which ) const noexcept
+    { return pLS->isAdmissible( x, which ); }
+
+    virtual
+    bool
+    projectToDomain( dvec_t & x ) const noexcept
+    { return pLS->projectToDomain( x ); }
+
+    virtual
+    integer
+    numParams() const
+    { return pLS->numParams(); }
+
+    virtual
+    string
+    paramName( integer k ) const
+    { return pLS->paramName( k ); }
+
+    virtual
+    real_type
+    getParam( integer k ) const
+    { return pLS->getParam( k ); }
+
+    //! change the parameter of the wrapped problem, built with a non const pointer
+    virtual
+    void
+    setParam( integer k, real_type value );
+
+    //!
+    //! \f$ J^T \partial F / \partial p_k + \sum_i F_i \nabla
+    //! \partial F_i / \partial p_k \f$, the second term by forward
+    //! differences, that is `n` calls of `dFdp` of the least squares
+    //! problem.
+    //!
+    virtual
+    void
+    dFdp( dvec_t const & x, integer k, dvec_t & dfdp ) const;
+
+  };
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  //!
+  //! A square system seen as the least squares problem
+  //! \f$ \min \frac{1}{2}\|F(x)\|^2 \f$.
+  //! The tensor is not available from `nonlinearSystem` and it is
+  //! approximated by forward differences of \f$ J(x)^T \lambda \f$,
+  //! that is `n` jacobian evaluations for each call.
+  //!
+  class nonlinearLeastSquaresFromSystem: public nonlinearLeastSquares {
+
+    nonlinearLeastSquaresFromSystem(nonlinearLeastSquaresFromSystem const &);
+    nonlinearLeastSquaresFromSystem const &
+    operator = (nonlinearLeastSquaresFromSystem const &);
+
+    nonlinearSystem const * pNS;
+    nonlinearSystem       * pNSmutable; // nullptr if built on a const problem
+
+    ivec_t m_TI, m_TJ; // lower part of the pattern of J^T J
+
+  public:
+
+    explicit
+    nonlinearLeastSquaresFromSystem( nonlinearSystem const * _pNS );
+
+    explicit
+    nonlinearLeastSquaresFromSystem( nonlinearSystem * _pNS );
+
+    virtual ~nonlinearLeastSquaresFromSystem() {}
+
+    virtual
+    real_type
+    evalFk( dvec_t const & x, integer k ) const
+    { return pNS->evalFk( x, k ); }
+
+    virtual
+    void
+    evalF( dvec_t const & x, dvec_t & f ) const
+    { pNS->evalF( x, f ); }
+
+    virtual
+    integer
+    jacobianNnz() const
+    { return pNS->jacobianNnz(); }
+
+    virtual
+    void
+    jacobian( dvec_t const & x, dvec_t & jac ) const
+    { pNS->jacobian( x, jac ); }
+
+    virtual
+    void
+    jacobianPattern( ivec_t & i, ivec_t & j ) const
+    { pNS->jacobianPattern( i, j ); }
+
+    virtual
+    integer
+    tensorNnz() const
+    { return integer(m_TI.size()); }
+
+    virtual
+    void
+    tensor( dvec_t const & x, dvec_t const & lambda, dvec_t & tens ) const;
+
+    virtual
+    void
+    tensorPattern( ivec_t & i, ivec_t & j ) const
+    { i = m_TI; j = m_TJ; }
+
+    virtual
+    integer
+    numExactSolution() const
+    { return pNS->numExactSolution(); }
+
+    virtual
+    void
+    getExactSolution( dvec_t & x, integer idx ) const
+    { pNS->getExactSolution( x, idx ); }
+
+    virtual
+    integer
+    numInitialPoint() const
+    { return pNS->numInitialPoint(); }
+
+    virtual
+    void
+    getInitialPoint( dvec_t & x, integer idx ) const
+    { pNS->getInitialPoint( x, idx ); }
+
+    virtual
+    void
+    checkIfAdmissible( dvec_t const & x ) const
+    { pNS->checkIfAdmissible( x ); }
+
+    virtual
+    void
+    boundingBox( dvec_t & L, dvec_t & U ) const
+    { pNS->boundingBox( L, U ); }
+
+    virtual
+    admissibleStatus
+    isAdmissible( dvec_t const & x, integer & which ) const noexcept
+    { return pNS->isAdmissible( x, which ); }
+
+    virtual
+    bool
+    projectToDomain( dvec_t & x ) const noexcept
+    { return pNS->projectToDomain( x ); }
+
+    virtual
+    integer
+    numParams() const
+    { return pNS->numParams(); }
+
+    virtual
+    string
+    paramName( integer k ) const
+    { return pNS->paramName( k ); }
+
+    virtual
+    real_type
+    getParam( integer k ) const
+    { return pNS->getParam( k ); }
+
+    //! change the parameter of the wrapped problem, built with a non const pointer
+    virtual
+    void
+    setParam( integer k, real_type value );
+
+    virtual
+    void
+    dFdp( dvec_t const & x, integer k, dvec_t & dfdp ) const
+    { pNS->dFdp( x, k, dfdp ); }
+
+  };
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  //!
+  //! Calls of the evaluation routines of a problem, nanoseconds spent
+  //! inside them and calls served by a cache (`nonlinearSystemCached`).
+  //!
+  struct evaluationStats {
+    long long num_F, num_Fk, num_J, num_pattern;
+    long long ns_F,  ns_Fk,  ns_J,  ns_pattern;
+    long long hit_F, hit_Fk, hit_J;
+
+    evaluationStats()
+    : num_F(0), num_Fk(0), num_J(0), num_pattern(0)
+    , ns_F(0),  ns_Fk(0),  ns_J(0),  ns_pattern(0)
+    , hit_F(0), hit_Fk(0), hit_J(0)
+    {}
+
+    long long numCalls() const { return num_F + num_Fk + num_J + num_pattern; }
+    long long nsTotal()  const { return ns_F + ns_Fk + ns_J + ns_pattern; }
+    long long numHits()  const { return hit_F + hit_Fk + hit_J; }
+
+    //! fraction of the calls of `evalF`, `evalFk` and `jacobian` served by the cache
+    real_type
+    hitRate() const {
+      long long nc = num_F + num_Fk + num_J;
+      return nc > 0 ? real_type(numHits()) / real_type(nc) : 0;
+    }
+  };
+
+  //!
+  //! Opt-in instrumentation of a `nonlinearSystem`: every call is
+  //! forwarded to the wrapped problem and the calls of `evalF`,
+  //! `evalFk`, `jacobian` and `jacobianPattern` (a native
+  //! `fixedPointMap` counts as `evalF`) are counted with the time spent
+  //! inside them. The counters are atomic, the wrapper is thread safe
+  //! as the wrapped problem; when disabled a call costs a relaxed load
+  //! more. The time spent by a solver in its own code is its elapsed
+  //! time minus `stats().nsTotal()`.
+  //!
+  class nonlinearSystemInstrumented: public nonlinearSystem {
+
+    nonlinearSystemInstrumented( nonlinearSystemInstrumented const & );
+    nonlinearSystemInstrumented const &
+    operator = ( nonlinearSystemInstrumented const & );
+
+    typedef std::chrono::steady_clock clock_type;
+
+    enum { STAT_F = 0, STAT_FK, STAT_J, STAT_PATTERN, STAT_SIZE };
+
+    nonlinearSystem const * pNS;
+    nonlinearSystem       * pNSmutable; // nullptr if built on a const problem
+
+    std::atomic<bool>              m_enabled;
+    mutable std::atomic<long long> m_calls[STAT_SIZE];
+    mutable std::atomic<long long> m_ns[STAT_SIZE];
+
+    bool enabled() const { return m_enabled.load( std::memory_order_relaxed ); }
+
+    void
+    count( integer kind, clock_type::time_point t0 ) const {
+      long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        clock_type::now() - t0
+      ).count();
+      m_calls[kind].fetch_add( 1, std::memory_order_relaxed );
+      m_ns[kind].fetch_add( ns, std::memory_order_relaxed );
     }
 
+  public:
+
+    explicit
+    nonlinearSystemInstrumented( nonlinearSystem const * _pNS, bool on = true );
+
+    explicit
+    nonlinearSystemInstrumented( nonlinearSystem * _pNS, bool on = true );
+
+    virtual ~nonlinearSystemInstrumented() {}
+
+    //! the wrapped problem
+    nonlinearSystem const * problem() const { return pNS; }
+
+    void setInstrumented( bool on ) { m_enabled = on; }
+    bool instrumented() const { return enabled(); }
+
+    //! zero the counters
+    void resetStats();
+
+    //! snapshot of the counters
+    evaluationStats stats() const;
+
+    virtual
+    real_type
+    evalFk( dvec_t const & x, integer k ) const;
+
+    virtual
+    void
+    evalF( dvec_t const & x, dvec_t & f ) const;
+
     virtual
     integer
     jacobianNnz() const
-    { return pMF->hessianNnz(); }
+    { return pNS->jacobianNnz(); }
 
     virtual
     void
-    jacobian( dvec_t const & x, dmat_t & hess ) const
-    { pMF->hessian(x,hess); }
+    jacobian( dvec_t const & x, dvec_t & jac ) const;
+
+    virtual
+    void
+    jacobianPattern( ivec_t & i, ivec_t & j ) const;
+
+    virtual
+    integer
+    numExactSolution() const
+    { return pNS->numExactSolution(); }
+
+    virtual
+    void
+    getExactSolution( dvec_t & x, integer idx ) const
+    { pNS->getExactSolution( x, idx ); }
+
+    virtual
+    integer
+    numInitialPoint() const
+    { return pNS->numInitialPoint(); }
+
+    virtual
+    void
+    getInitialPoint( dvec_t & x, integer idx ) const
+    { pNS->getInitialPoint( x, idx ); }
+
+    virtual
+    void
+    checkIfAdmissible( dvec_t const & x ) const
+    { pNS->checkIfAdmissible( x ); }
+
+    virtual
+    void
+    boundingBox( dvec_t & L, dvec_t & U ) const
+    { pNS->boundingBox( L, U ); }
+
+    virtual
+    admissibleStatus
+    isAdmissible( dvec_t const & x, integer & which ) const noexcept
+    { return pNS->isAdmissible( x, which ); }
+
+    virtual
+    bool
+    projectToDomain( dvec_t & x ) const noexcept
+    { return pNS->projectToDomain( x ); }
+
+    virtual
+    bool
+    hasFixedPointForm() const
+    { return pNS->hasFixedPointForm(); }
+
+    virtual
+    void
+    fixedPointMap( dvec_t const & x, dvec_t & g ) const;
+
+    virtual
+    bool
+    isThreadSafe() const
+    { return pNS->isThreadSafe(); }
+
+    virtual
+    bool
+    isPolynomial() const
+    { return pNS->isPolynomial(); }
+
+    virtual
+    void
+    polynomialForm( polynomialTerms & terms ) const
+    { pNS->polynomialForm( terms ); }
+
+    virtual
+    integer
+    numParams() const
+    { return pNS->numParams(); }
+
+    virtual
+    string
+    paramName( integer k ) const
+    { return pNS->paramName( k ); }
+
+    virtual
+    real_type
+    getParam( integer k ) const
+    { return pNS->getParam( k ); }
+
+    //! change the parameter of the wrapped problem, built with a non const pointer
+    virtual
+    void
+    setParam( integer k, real_type value );
+
+    virtual
+    void
+    dFdp( dvec_t const & x, integer k, dvec_t & dfdp ) const
+    { pNS->dFdp( x, k, dfdp ); }
+
+  };
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  //!
+  //! Memoization of the residual and of the jacobian of a
+  //! `nonlinearSystem`, for the solvers that query again the same point
+  //! (e.g. `evalF` at the point accepted by a line search followed by
+  //! `jacobian` and again `evalF` for the merit function).
+  //!
+  //! The last `capacity` points (LRU) are kept with the residual and
+  //! the jacobian computed there; a point is found by a hash of its
+  //! bits and then compared exactly, so a hit returns the same bits the
+  //! problem would. `evalFk` is served by a stored residual when there
+  //! is one (the residual is the shared intermediate), otherwise it is
+  //! forwarded and not stored. The evaluations run outside the lock, the
+  //! wrapper is thread safe as the wrapped problem. `stats()` reports
+  //! the calls and the hits (`num_pattern` and the times are not
+  //! counted).
+  //!
+  class nonlinearSystemCached: public nonlinearSystem {
+
+    nonlinearSystemCached( nonlinearSystemCached const & );
+    nonlinearSystemCached const &
+    operator = ( nonlinearSystemCached const & );
+
+    struct entry {
+      uint64_t hash;
+      uint64_t last_use; // 0 = free
+      dvec_t   x;
+      dvec_t   F;
+      dvec_t   J;
+      bool     has_F;
+      bool     has_J;
+    };
+
+    nonlinearSystem const * pNS;
+    nonlinearSystem       * pNSmutable; // nullptr if built on a const problem
+
+    mutable std::mutex    m_mtx;
+    mutable vector<entry> m_entries;
+    mutable uint64_t      m_clock;
+
+    mutable std::atomic<long long> m_num_F, m_num_Fk, m_num_J;
+    mutable std::atomic<long long> m_hit_F, m_hit_Fk, m_hit_J;
+
+    static uint64_t hashOf( dvec_t const & x );
+
+    //! entry of `x` or nullptr, with the lock held
+    entry * find( dvec_t const & x, uint64_t h ) const;
+
+    //! entry of `x`, a free or the least recently used one if missing
+    entry & slotFor( dvec_t const & x, uint64_t h ) const;
+
+  public:
+
+    explicit
+    nonlinearSystemCached( nonlinearSystem const * _pNS, integer capacity = 4 );
+
+    explicit
+    nonlinearSystemCached( nonlinearSystem * _pNS, integer capacity = 4 );
+
+    virtual ~nonlinearSystemCached() {}
+
+    //! the wrapped problem
+    nonlinearSystem const * problem() const { return pNS; }
+
+    //! drop the stored points (e.g. if the problem changed its parameters)
+    void clearCache();
+
+    void resetStats();
+
+    evaluationStats stats() const;
+
+    virtual
+    real_type
+    evalFk( dvec_t const & x, integer k ) const;
+
+    virtual
+    void
+    evalF( dvec_t const & x, dvec_t & f ) const;
+
+    virtual
+    integer
+    jacobianNnz() const
+    { return pNS->jacobianNnz(); }
+
+    virtual
+    void
+    jacobian( dvec_t const & x, dvec_t & jac ) const;
 
     virtual
     void
     jacobianPattern( ivec_t & i, ivec_t & j ) const
-    { pMF->hessianPattern(i,j); }
+    { pNS->jacobianPattern( i, j ); }
 
     virtual
     integer
     numExactSolution() const
-    { return pMF->numExactSolution(); }
+    { return pNS->numExactSolution(); }
 
     virtual
     void
     getExactSolution( dvec_t & x, integer idx ) const
-    { pMF->getExactSolution(x,idx); }
+    { pNS->getExactSolution( x, idx ); }
 
     virtual
     integer
     numInitialPoint() const
-    { return pMF->numInitialPoint(); }
+    { return pNS->numInitialPoint(); }
 
     virtual
     void
     getInitialPoint( dvec_t & x, integer idx ) const
-    { pMF->getInitialPoint(x,idx); }
+    { pNS->getInitialPoint( x, idx ); }
 
     virtual
     void
     checkIfAdmissible( dvec_t const & x ) const
-    { pMF->checkIfAdmissible(x); }
+    { pNS->checkIfAdmissible( x ); }
 
     virtual
     void
     boundingBox( dvec_t & L, dvec_t & U ) const
-    { pMF->boundingBox(L,U); }
+    { pNS->boundingBox( L, U ); }
 
-    integer numEqns( void ) const { return pMF->dimX(); }
+    virtual
+    admissibleStatus
+    isAdmissible( dvec_t const & x, integer & which ) const noexcept
+    { return pNS->isAdmissible( x, which ); }
 
-    string const & title(void) const { return pMF->title(); }
+    virtual
+    bool
+    projectToDomain( dvec_t & x ) const noexcept
+    { return pNS->projectToDomain( x ); }
+
+    virtual
+    bool
+    hasFixedPointForm() const
+    { return pNS->hasFixedPointForm(); }
+
+    virtual
+    void
+    fixedPointMap( dvec_t const & x, dvec_t & g ) const;
+
+    virtual
+    bool
+    isThreadSafe() const
+    { return pNS->isThreadSafe(); }
+
+    virtual
+    bool
+    isPolynomial() const
+    { return pNS->isPolynomial(); }
+
+    virtual
+    void
+    polynomialForm( polynomialTerms & terms ) const
+    { pNS->polynomialForm( terms ); }
+
+    virtual
+    integer
+    numParams() const
+    { return pNS->numParams(); }
+
+    virtual
+    string
+    paramName( integer k ) const
+    { return pNS->paramName( k ); }
+
+    virtual
+    real_type
+    getParam( integer k ) const
+    { return pNS->getParam( k ); }
+
+    //!
+    //! Change the parameter of the wrapped problem, built with a non
+    //! const pointer, and drop the stored points.
+    //!
+    virtual
+    void
+    setParam( integer k, real_type value );
+
+    virtual
+    void
+    dFdp( dvec_t const & x, integer k, dvec_t & dfdp ) const
+    { pNS->dFdp( x, k, dfdp ); }
 
   };
-#endif
 
-  extern vector<nonlinearSystem*> theProblems;
-  extern map<string,integer>      theProblemsMap;
+  //! build an instance with `neq` equations of a scalable family
+  typedef nonlinearSystem * (*scalableProblemBuilder)( integer neq );
+
+  //!
+  //! Declared cost of a scalable family: the work of each routine is
+  //! proportional to \f$ n^p \f$, the exponents are checked by the
+  //! scaling suite (bench/NLtoolbox_scaling.cc).
+  //!
+  struct scalableComplexity {
+    real_type residual; //!< `evalF`
+    real_type sweep;    //!< `evalFk` for all the components
+    real_type jacobian; //!< `jacobian` and `fill_CSR`
+  };
+
+  extern vector<nonlinearSystem*>            theProblems;
+  extern map<string,integer>                 theProblemsMap;
+  extern map<string,scalableProblemBuilder>  theScalableProblems;
+  extern map<string,scalableComplexity>      theScalableComplexity;
   void initProblems();
 
 }
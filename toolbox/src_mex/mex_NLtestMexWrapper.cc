@@ -31,6 +31,8 @@
 "    [L,U]  = NLtestMexWrapper( 'bbox', ntest );\n" \
 "    name   = NLtestMexWrapper( 'name', ntest );\n" \
 "    bibtex = NLtestMexWrapper( 'bibtex', ntest );\n" \
+"    S      = NLtestMexWrapper( 'stats', ntest );\n" \
+"    NLtestMexWrapper( 'stats', ntest, 'on' | 'off' | 'reset' );\n" \
 "\n" \
 "===================================================================\n"
 
@@ -38,6 +40,20 @@ using namespace std;
 
 namespace NLproblem {
 
+  // the evaluations of 'evalF', 'evalJF' and 'pattern' go through these
+  static std::vector<nonlinearSystemInstrumented*> theInstrumented;
+
+  static
+  nonlinearSystemInstrumented *
+  getInstrumented( integer ntest ) {
+    // one wrapper for each problem, the counters start disabled
+    while ( theInstrumented.size() < theProblems.size() )
+      theInstrumented.push_back(
+        new nonlinearSystemInstrumented( theProblems[theInstrumented.size()], false )
+      );
+    return theInstrumented[ntest-1];
+  }
+
   // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
 
   static
@@ -160,7 +176,7 @@ namespace NLproblem {
     );
     #undef CMD
 
-    nonlinearSystem * PRB = theProblems[ntest-1];
+    nonlinearSystem const * PRB = getInstrumented( ntest );
 
     #define CMD "NLtestMexWrapper('evalF',ntest,x[,k]): "
 
@@ -207,7 +223,7 @@ namespace NLproblem {
       CMD "ntest = " << ntest << " out of range"
     );
 
-    nonlinearSystem * PRB = theProblems[ntest-1];
+    nonlinearSystem const * PRB = getInstrumented( ntest );
 
     MEX_ASSERT( nlhs == 1, CMD "expected 1 output, nlhs = " << nlhs );
     MEX_ASSERT( nrhs == 2, CMD "expected 2 input, nrhs = " << nrhs );
@@ -262,7 +278,7 @@ namespace NLproblem {
     );
     #undef CMD
 
-    nonlinearSystem * PRB = theProblems[ntest-1];
+    nonlinearSystem const * PRB = getInstrumented( ntest );
 
     #define CMD "NLtestMexWrapper('evalJF',ntest,x): "
 
@@ -530,19 +546,10 @@ namespace NLproblem {
       CMD "size(x) = " << size << " expected = " << PRB->numEqns()
     );
 
-    bool ok = true;
-    try {
-      dvec_t X( PRB->numEqns() );
-      std::copy_n( x, PRB->numEqns(), X.data() );
-      PRB->checkIfAdmissible( X );
-    }
-    catch ( runtime_error & err ) {
-      //mexPrintf("%s\n",err.what());
-      ok = false;
-    }
-    catch ( ... ) {
-      ok = false;
-    }
+    dvec_t X( PRB->numEqns() );
+    std::copy_n( x, PRB->numEqns(), X.data() );
+    integer which;
+    bool ok = PRB->isAdmissible( X, which ) == POINT_ADMISSIBLE;
     setScalarBool( arg_out_0, ok );
     #undef CMD
   }
@@ -596,6 +603,52 @@ namespace NLproblem {
     #undef CMD
   }
 
+  // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+
+  static
+  void
+  do_stats(
+    int nlhs, mxArray       *plhs[],
+    int nrhs, mxArray const *prhs[]
+  ) {
+    #define CMD "NLtestMexWrapper('stats',ntest[,'on'|'off'|'reset']): "
+    integer ntest = integer( getInt( arg_in_1, CMD "error in reading ntest ") );
+
+    MEX_ASSERT(
+      ntest > 0 && ntest <= integer(theProblems.size()),
+      CMD "ntest = " << ntest << " out of range"
+    );
+
+    nonlinearSystemInstrumented * PRB = getInstrumented( ntest );
+
+    if ( nrhs == 3 ) {
+      MEX_ASSERT( nlhs == 0, CMD "expected no output, nlhs = " << nlhs );
+      MEX_ASSERT( mxIsChar(arg_in_2), CMD "third argument must be a string" );
+      string what = mxArrayToString(arg_in_2);
+      if      ( what == "on"    ) PRB->setInstrumented( true );
+      else if ( what == "off"   ) PRB->setInstrumented( false );
+      else if ( what == "reset" ) PRB->resetStats();
+      else MEX_ASSERT( false, CMD "unknown option '" << what << "'" );
+    } else {
+      MEX_ASSERT( nlhs == 1, CMD "expected 1 output, nlhs = " << nlhs );
+      MEX_ASSERT( nrhs == 2, CMD "expected 2 or 3 input, nrhs = " << nrhs );
+      evaluationStats S = PRB->stats();
+      char const * fields[] = {
+        "enabled", "num_F", "num_Fk", "num_J", "num_pattern",
+        "ns_F", "ns_Fk", "ns_J", "ns_pattern"
+      };
+      double values[] = {
+        PRB->instrumented() ? 1.0 : 0.0,
+        double(S.num_F), double(S.num_Fk), double(S.num_J), double(S.num_pattern),
+        double(S.ns_F),  double(S.ns_Fk),  double(S.ns_J),  double(S.ns_pattern)
+      };
+      arg_out_0 = mxCreateStructMatrix( 1, 1, 9, fields );
+      for ( int i = 0; i < 9; ++i )
+        mxSetFieldByNumber( arg_out_0, 0, i, mxCreateDoubleScalar( values[i] ) );
+    }
+    #undef CMD
+  }
+
   // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
   // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
   // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
@@ -619,7 +672,8 @@ namespace NLproblem {
     {"bbox",do_bbox},
     {"check",do_check},
     {"name",do_name},
-    {"bibtex",do_bibtex}
+    {"bibtex",do_bibtex},
+    {"stats",do_stats}
   };
 
   extern "C"